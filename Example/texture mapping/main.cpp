@@ -30,10 +30,10 @@ int main()
         };
         
         auto texture {
-            Texture2D<float, TexelType::RGB>::loadTexture("/Users/asifmamedov/Desktop/WOGL/WOGL/Example/texture mapping/Data/foto.jpg")
+            Texture2D<uint8_t, TexelType::RGB>::loadTexture("/Users/asifmamedov/Desktop/WOGL/WOGL/Example/texture mapping/Data/foto.jpg")
         };
         
-        TextureRenderer2D<TexelFormat::RGB16_F> textureRenderer {
+        TextureRenderer2D<TexelFormat::RGB8_UNORM> textureRenderer {
             texture
         };
         
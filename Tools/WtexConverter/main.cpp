@@ -0,0 +1,125 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "WOGL/Data/Texture2D.hpp"
+#include "WOGL/Data/MipChain.hpp"
+#include "WOGL/Data/BlockCompression.hpp"
+
+#include "WOGL/Render/Texture/WtexFile.hpp"
+
+using namespace std;
+using namespace WOGL;
+
+/**
+ * Утилита, конвертирующая JPEG/PNG (и прочие форматы, которые читает Texture2D::loadTexture) в .wtex файл
+ * с готовой mipmap-цепочкой в конечном формате текселя.
+ *
+ * wtexconv <input> <output.wtex> [-f format] [-k] [-n]
+ *  -f формат текселя: rgba8 (по умолчанию), srgb8_alpha8, rgb8, srgb8, bc1, bc1_srgb, bc3, bc3_srgb, bc4, bc5, bc7, bc7_srgb
+ *  -k использовать фильтр Кайзера для построения mipmap'ов (по умолчанию box-фильтр)
+ *  -n не строить mipmap'ы
+*/
+
+struct Options
+{
+    string input;
+    string output;
+    string format = "rgba8";
+    MipFilter filter = MipFilter::BOX;
+    bool mipmaps = true;
+};
+
+template<TexelFormat Tf, TexelType Tx>
+void convertUncompressed(const Options& options)
+{
+    const auto texture = Texture2D<uint8_t, Tx>::loadTexture(options.input);
+
+    if (options.mipmaps) {
+        WtexFile::write<Tf>(options.output, MipChain2D<uint8_t, Tx>(texture, options.filter, isSRGB(Tf)));
+    } else {
+        WtexFile::write<Tf>(options.output, texture);
+    }
+}
+
+template<TexelFormat Tf, BlockFormat Bf>
+void convertCompressed(const Options& options)
+{
+    const auto texture = Texture2D<uint8_t, TexelType::RGBA>::loadTexture(options.input);
+
+    if (options.mipmaps) {
+        WtexFile::write<Tf>(options.output, BlockEncoder::compress(MipChain2D<uint8_t, TexelType::RGBA>(texture, options.filter, isSRGB(Tf)), Bf));
+    } else {
+        WtexFile::write<Tf>(options.output, BlockEncoder::compress(texture, Bf));
+    }
+}
+
+void convert(const Options& options)
+{
+    const string_view format = options.format;
+
+    if (format == "rgba8") {
+        convertUncompressed<TexelFormat::RGBA8_UNORM, TexelType::RGBA>(options);
+    } else if (format == "srgb8_alpha8") {
+        convertUncompressed<TexelFormat::SRGB8_ALPHA8, TexelType::RGBA>(options);
+    } else if (format == "rgb8") {
+        convertUncompressed<TexelFormat::RGB8_UNORM, TexelType::RGB>(options);
+    } else if (format == "srgb8") {
+        convertUncompressed<TexelFormat::SRGB8, TexelType::RGB>(options);
+    } else if (format == "bc1") {
+        convertCompressed<TexelFormat::BC1_RGB, BlockFormat::BC1>(options);
+    } else if (format == "bc1_srgb") {
+        convertCompressed<TexelFormat::BC1_SRGB, BlockFormat::BC1>(options);
+    } else if (format == "bc3") {
+        convertCompressed<TexelFormat::BC3_RGBA, BlockFormat::BC3>(options);
+    } else if (format == "bc3_srgb") {
+        convertCompressed<TexelFormat::BC3_SRGB_ALPHA, BlockFormat::BC3>(options);
+    } else if (format == "bc4") {
+        convertCompressed<TexelFormat::BC4_RED, BlockFormat::BC4>(options);
+    } else if (format == "bc5") {
+        convertCompressed<TexelFormat::BC5_RG, BlockFormat::BC5>(options);
+    } else if (format == "bc7") {
+        convertCompressed<TexelFormat::BC7_RGBA, BlockFormat::BC7>(options);
+    } else if (format == "bc7_srgb") {
+        convertCompressed<TexelFormat::BC7_SRGB_ALPHA, BlockFormat::BC7>(options);
+    } else {
+        throw invalid_argument("Unknown texel format: " + options.format);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try {
+        Options options;
+
+        for (int i{1}; i < argc; i++) {
+            const string_view argument = argv[i];
+
+            if (argument == "-f" && i + 1 < argc) {
+                options.format = argv[++i];
+            } else if (argument == "-k") {
+                options.filter = MipFilter::KAISER;
+            } else if (argument == "-n") {
+                options.mipmaps = false;
+            } else if (options.input.empty()) {
+                options.input = argument;
+            } else if (options.output.empty()) {
+                options.output = argument;
+            } else {
+                throw invalid_argument("Unexpected argument: " + string(argument));
+            }
+        }
+
+        if (options.input.empty() || options.output.empty()) {
+            cerr << "Usage: wtexconv <input> <output.wtex> [-f format] [-k] [-n]" << endl;
+            return 1;
+        }
+
+        convert(options);
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
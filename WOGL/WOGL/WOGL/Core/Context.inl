@@ -16,6 +16,8 @@
 #include <stdexcept>
 
 #include "ModelRenderer.hpp"
+#include "RenderQueue.hpp"
+#include "DrawBundle.hpp"
 
 #include <initializer_list>
 
@@ -208,9 +210,10 @@ namespace WOGL
         template<TexelFormat Tf, template<TexelFormat> typename T>
         static void draw(const T<Tf>& modelRenderer, int32_t numberRepetitions = 1)
         {
-            for (size_t i{0}, size{modelRenderer._texturersRenderer.size()}; i < size; i++) {
-                modelRenderer._texturersRenderer[i].first.bind(modelRenderer._texturersRenderer[i].second);
-            }
+            modelRenderer._forEachTexture([] (const ITextureRenderer* texture, int32_t slot) {
+                texture->bind(slot);
+                Sampler::bind(slot, texture->sampler());
+            });
 
             for (size_t i{0}; i < modelRenderer._meshRenderers.size(); i++) {
                 modelRenderer._meshRenderers[i].draw(numberRepetitions);
@@ -228,9 +231,10 @@ namespace WOGL
         template<TexelFormat Tf, template<TexelFormat> typename T>
         static void draw(const T<Tf>& modelRenderer, const ColorAttachments& ca, int32_t numberRepetitions = 1)
         {
-            for (size_t i{0}, size{modelRenderer._texturersRenderer.size()}; i < size; i++) {
-                modelRenderer._texturersRenderer[i].first.bind(modelRenderer._texturersRenderer[i].second);
-            }
+            modelRenderer._forEachTexture([] (const ITextureRenderer* texture, int32_t slot) {
+                texture->bind(slot);
+                Sampler::bind(slot, texture->sampler());
+            });
 
             glDrawBuffers(static_cast<int32_t>(ca.size()), &ca.colorAttachments()[0]);
 
@@ -273,6 +277,44 @@ namespace WOGL
             }
         }
 
+        /**
+         * Статический метод необходимый для отрисовки очереди отрисовки.
+         * Если очередь не отсортирована, то перед отрисовкой она будет отсортирована.
+         *
+         * @param queue очередь отрисовки
+        */
+        static void draw(RenderQueue& queue)
+        {
+            BindingTracker tracker;
+            queue.submit(tracker);
+        }
+
+        /**
+         * Статический метод необходимый для отрисовки очереди отрисовки.
+         * Если очередь не отсортирована, то перед отрисовкой она будет отсортирована.
+         *
+         * @param queue очередь отрисовки
+         * @param ca объект с текстурными прикреплениями (например вот таких: ColorAttachments ca {0, 1, 4})
+        */
+        static void draw(RenderQueue& queue, const ColorAttachments& ca)
+        {
+            BindingTracker tracker;
+
+            glDrawBuffers(static_cast<int32_t>(ca.size()), &ca.colorAttachments()[0]);
+            queue.submit(tracker);
+        }
+
+        /**
+         * Статический метод необходимый для воспроизведения записанного набора команд отрисовки.
+         *
+         * @param bundle набор команд отрисовки
+         * @throw logic_error в случае если набор недействителен
+        */
+        static inline void draw(const DrawBundle& bundle)
+        {
+            bundle.replay();
+        }
+
         /**
          * Функция предназначенная для выявления ошибок OpenGL.
          *
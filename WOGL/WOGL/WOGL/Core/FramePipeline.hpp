@@ -0,0 +1,14 @@
+//
+//  FramePipeline.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef FramePipeline_hpp
+#define FramePipeline_hpp
+
+#include "FramePipeline.inl"
+
+#endif /* FramePipeline_hpp */
@@ -0,0 +1,288 @@
+//
+//  FramePipeline.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <GL/glew.h>
+
+#include <cstdint>
+
+#include <vector>
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace WOGL
+{
+    /**
+     * Класс управляющий кадрами, находящимися в обработке у GPU.
+     *
+     * Одновременно CPU может подготавливать кадр N + 1, пока GPU рисует кадр N. Для каждого
+     * из framesInFlight кадров создаётся объект синхронизации (glFenceSync), и в начале кадра
+     * CPU ждёт только завершения того кадра, ресурсы которого будут переиспользованы.
+     *
+     * Пример использования:
+     *
+     *     FramePipeline frames(3);
+     *
+     *     while (stay) {
+     *         frames.beginFrame();
+     *         vertices.current() ... // ресурс текущего кадра, GPU его больше не читает
+     *         frames.present(window);
+     *     }
+    */
+    class FramePipeline
+    {
+    public:
+        /**
+         * Конструктор.
+         *
+         * @param framesInFlight количество кадров, которые могут одновременно находиться в обработке
+         * @throw invalid_argument в случае если framesInFlight равен нулю
+        */
+        explicit FramePipeline(uint32_t framesInFlight = 2) :
+            _fences(framesInFlight, nullptr),
+            _frameNumber{0},
+            _inFrame{false}
+        {
+            if (!framesInFlight) {
+                throw invalid_argument("Number of frames in flight must be greater than zero");
+            }
+        }
+
+        FramePipeline(FramePipeline&& frames) :
+            _fences{move(frames._fences)},
+            _frameNumber{frames._frameNumber},
+            _inFrame{frames._inFrame}
+        {
+        }
+
+        FramePipeline(const FramePipeline&) = delete;
+        FramePipeline& operator=(const FramePipeline&) = delete;
+        FramePipeline& operator=(FramePipeline&&) = delete;
+
+        virtual ~FramePipeline()
+        {
+            for (auto fence: _fences) {
+                if (fence) {
+                    glDeleteSync(fence);
+                }
+            }
+        }
+
+        /**
+         * Метод начинающий новый кадр. Если GPU ещё не закончил кадр, который
+         * framesInFlight кадров назад использовал тот же индекс, то метод ждёт его завершения.
+         *
+         * @throw logic_error в случае если предыдущий кадр не был завершён
+         * @throw runtime_error в случае если ожидание объекта синхронизации завершилось ошибкой
+        */
+        void beginFrame()
+        {
+            if (_inFrame) {
+                throw logic_error("Previous frame was not ended");
+            }
+
+            auto& fence = _fences[frameIndex()];
+
+            if (fence) {
+                _wait(fence);
+                glDeleteSync(fence);
+                fence = nullptr;
+            }
+
+            _inFrame = true;
+        }
+
+        /**
+         * Метод завершающий кадр: после всех команд кадра в очередь GPU помещается объект синхронизации.
+         *
+         * @throw logic_error в случае если кадр не был начат
+        */
+        void endFrame()
+        {
+            if (!_inFrame) {
+                throw logic_error("Frame was not begun");
+            }
+
+            _fences[frameIndex()] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            _frameNumber++;
+            _inFrame = false;
+        }
+
+        /**
+         * Метод завершающий кадр и выводящий его на экран.
+         *
+         * @param window окно
+         * @throw logic_error в случае если кадр не был начат
+        */
+        template<typename WindowType>
+        void present(const WindowType& window)
+        {
+            endFrame();
+            window.present();
+        }
+
+        /**
+         * Метод ожидающий завершения всех кадров, находящихся в обработке
+         * (например перед удалением ресурсов, которые могут читаться GPU).
+         *
+         * @throw runtime_error в случае если ожидание объекта синхронизации завершилось ошибкой
+        */
+        void waitIdle()
+        {
+            for (auto& fence: _fences) {
+                if (fence) {
+                    _wait(fence);
+                    glDeleteSync(fence);
+                    fence = nullptr;
+                }
+            }
+        }
+
+        /**
+         * Метод позволяющий узнать, закончил ли GPU кадр с указанным номером.
+         *
+         * @param frameNumber номер кадра
+         * @return true - если кадр завершён, иначе false
+        */
+        bool isFrameComplete(uint64_t frameNumber) const noexcept
+        {
+            if (frameNumber >= _frameNumber) {
+                return false;
+            }
+
+            if (frameNumber + _fences.size() < _frameNumber) {
+                return true;
+            }
+
+            auto fence = _fences[frameNumber % _fences.size()];
+
+            return !fence || glClientWaitSync(fence, 0, 0) != GL_TIMEOUT_EXPIRED;
+        }
+
+        /**
+         * @return индекс текущего кадра в диапазоне [0, framesInFlight)
+        */
+        uint32_t frameIndex() const noexcept
+        {
+            return static_cast<uint32_t>(_frameNumber % _fences.size());
+        }
+
+        /**
+         * @return номер текущего кадра (количество завершённых кадров)
+        */
+        uint64_t frameNumber() const noexcept
+        {
+            return _frameNumber;
+        }
+
+        uint32_t framesInFlight() const noexcept
+        {
+            return static_cast<uint32_t>(_fences.size());
+        }
+
+    private:
+        static void _wait(GLsync fence)
+        {
+            GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+
+            while (true) {
+                switch (glClientWaitSync(fence, flags, 1000000)) {
+                    case GL_ALREADY_SIGNALED:
+                    case GL_CONDITION_SATISFIED: {
+                        return ;
+                    }
+
+                    case GL_WAIT_FAILED: {
+                        throw runtime_error("Error wait fence");
+                    }
+                }
+
+                flags = 0;
+            }
+        }
+
+        vector<GLsync> _fences;
+        uint64_t _frameNumber;
+        bool _inFrame;
+    };
+
+    /**
+     * Ресурс, имеющий отдельную версию для каждого кадра в обработке (например вершинный буфер или текстура,
+     * которые обновляются каждый кадр). Пока GPU читает версию кадра N, CPU обновляет версию кадра N + 1,
+     * поэтому обновление не приводит к неявному ожиданию в драйвере.
+     *
+     * @template Resource тип ресурса
+    */
+    template<typename Resource>
+    class FrameResource
+    {
+    public:
+        /**
+         * Конструктор.
+         *
+         * @param frames менеджер кадров
+         * @param factory функция, создающая версию ресурса по индексу кадра
+        */
+        template<typename Factory>
+        explicit FrameResource(const FramePipeline& frames, Factory factory) :
+            _frames{frames}
+        {
+            _resources.reserve(frames.framesInFlight());
+
+            for (uint32_t i{0}; i < frames.framesInFlight(); i++) {
+                _resources.push_back(factory(i));
+            }
+        }
+
+        FrameResource(FrameResource&& resource) :
+            _frames{resource._frames},
+            _resources{move(resource._resources)}
+        {
+        }
+
+        FrameResource(const FrameResource&) = delete;
+        FrameResource& operator=(const FrameResource&) = delete;
+        FrameResource& operator=(FrameResource&&) = delete;
+
+        /**
+         * @return версия ресурса текущего кадра
+        */
+        Resource& current() noexcept
+        {
+            return _resources[_frames.frameIndex()];
+        }
+
+        /**
+         * @return версия ресурса текущего кадра
+        */
+        const Resource& current() const noexcept
+        {
+            return _resources[_frames.frameIndex()];
+        }
+
+        Resource& operator[](size_t i) noexcept
+        {
+            return _resources[i];
+        }
+
+        const Resource& operator[](size_t i) const noexcept
+        {
+            return _resources[i];
+        }
+
+        size_t size() const noexcept
+        {
+            return _resources.size();
+        }
+
+    private:
+        const FramePipeline& _frames;
+        vector<Resource> _resources;
+    };
+}
@@ -0,0 +1,14 @@
+//
+//  ThreadPool.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef ThreadPool_hpp
+#define ThreadPool_hpp
+
+#include "ThreadPool.inl"
+
+#endif /* ThreadPool_hpp */
@@ -0,0 +1,338 @@
+//
+//  ThreadPool.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <cstdint>
+
+#include <vector>
+#include <deque>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <future>
+
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <type_traits>
+#include <exception>
+
+using namespace std;
+
+namespace WOGL
+{
+    /**
+     * Пул потоков для выполнения работы на CPU (генерация mipmap'ов, сжатие и декодирование текстур и т.д.).
+     * Функции OpenGL из задач пула вызывать нельзя, так как контекст привязан к потоку отрисовки.
+     *
+     * У каждого рабочего потока есть своя очередь: задачи, поставленные из рабочего потока, попадают в его очередь
+     * и выполняются им в обратном порядке (последняя поставленная - первой, пока её данные ещё в кэше),
+     * а освободившиеся потоки забирают ("крадут") самые старые задачи из чужих очередей.
+     * Задачи, поставленные из других потоков, попадают в общую очередь.
+    */
+    class ThreadPool
+    {
+    public:
+        /**
+         * Конструктор.
+         *
+         * @param numberOfThreads количество рабочих потоков (если 0, то пул выполняет всё в вызывающем потоке)
+        */
+        explicit ThreadPool(size_t numberOfThreads = max(thread::hardware_concurrency(), 1u) - 1) :
+            _pending{0},
+            _stop{false}
+        {
+            _queues.reserve(numberOfThreads + 1);
+
+            for (size_t i{0}; i <= numberOfThreads; i++) {
+                _queues.push_back(make_unique<_Queue>());
+            }
+
+            _workers.reserve(numberOfThreads);
+
+            for (size_t i{0}; i < numberOfThreads; i++) {
+                _workers.emplace_back([this, i] {
+                    _work(i);
+                });
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ThreadPool& operator=(ThreadPool&&) = delete;
+
+        virtual ~ThreadPool()
+        {
+            {
+                lock_guard<mutex> lock(_mutex);
+                _stop = true;
+            }
+
+            _condition.notify_all();
+
+            for (auto& worker: _workers) {
+                worker.join();
+            }
+        }
+
+        /**
+         * Метод ставящий задачу в очередь.
+         *
+         * @param func функция
+         * @param args аргументы функции
+         * @return future с результатом функции
+        */
+        template<typename Func, typename... Args>
+        auto submit(Func&& func, Args&&... args)
+        {
+            using Result = invoke_result_t<decay_t<Func>, decay_t<Args>...>;
+
+            auto task = make_shared<packaged_task<Result()>>(bind(forward<Func>(func), forward<Args>(args)...));
+            auto result = task->get_future();
+
+            if (_workers.empty()) {
+                (*task)();
+                return result;
+            }
+
+            _push([task] {
+                (*task)();
+            });
+
+            return result;
+        }
+
+        /**
+         * Метод выполняющий func для всех поддиапазонов [begin, end) размером не меньше grain.
+         * Вызывающий поток участвует в работе и возвращается только после обработки всего диапазона.
+         * Пока вызывающий поток ждёт, он выполняет задачи из очереди, поэтому метод можно вызывать из задач пула.
+         *
+         * @param begin начало диапазона
+         * @param end конец диапазона
+         * @param func функция вида func(size_t begin, size_t end)
+         * @param grain минимальный размер поддиапазона
+         * @throw исключение, выброшенное func (первое из них)
+        */
+        template<typename Func>
+        void parallelFor(size_t begin, size_t end, Func&& func, size_t grain = 1)
+        {
+            if (begin >= end) {
+                return;
+            }
+
+            grain = max<size_t>(grain, 1);
+
+            const size_t size = end - begin;
+            const size_t numberOfChunks = min((size + grain - 1) / grain, (_workers.size() + 1) * 4);
+
+            if (numberOfChunks == 1 || _workers.empty()) {
+                func(begin, end);
+                return;
+            }
+
+            struct State
+            {
+                atomic<size_t> next;
+                atomic<size_t> done;
+                exception_ptr exception;
+                mutex exceptionMutex;
+            };
+
+            auto state = make_shared<State>();
+            state->next = 0;
+            state->done = 0;
+
+            auto run = [state, begin, size, numberOfChunks, &func] {
+                for (size_t chunk; (chunk = state->next.fetch_add(1)) < numberOfChunks;) {
+                    size_t chunkBegin = begin + size * chunk / numberOfChunks;
+                    size_t chunkEnd = begin + size * (chunk + 1) / numberOfChunks;
+
+                    try {
+                        func(chunkBegin, chunkEnd);
+                    } catch (...) {
+                        lock_guard<mutex> lock(state->exceptionMutex);
+
+                        if (!state->exception) {
+                            state->exception = current_exception();
+                        }
+                    }
+
+                    state->done.fetch_add(1, memory_order_release);
+                }
+            };
+
+            for (size_t i{0}, n = min(_workers.size(), numberOfChunks - 1); i < n; i++) {
+                _push(run);
+            }
+
+            run();
+
+            while (state->done.load(memory_order_acquire) < numberOfChunks) {
+                if (!_runPendingTask()) {
+                    this_thread::yield();
+                }
+            }
+
+            if (state->exception) {
+                rethrow_exception(state->exception);
+            }
+        }
+
+        size_t numberOfThreads() const noexcept
+        {
+            return _workers.size();
+        }
+
+        /**
+         * Метод возвращающий общий пул потоков библиотеки.
+         *
+         * @return пул потоков
+        */
+        static ThreadPool& global()
+        {
+            static ThreadPool pool;
+            return pool;
+        }
+
+    private:
+        struct _Queue
+        {
+            mutex tasksMutex;
+            deque<function<void()>> tasks;
+        };
+
+        /**
+         * Метод возвращающий номер очереди текущего потока: номер рабочего потока,
+         * если текущий поток принадлежит этому пулу, иначе номер общей очереди.
+        */
+        size_t _queueIndex() const noexcept
+        {
+            const auto& current = _currentWorker();
+            return current.first == this ? current.second : _workers.size();
+        }
+
+        static pair<const ThreadPool*, size_t>& _currentWorker() noexcept
+        {
+            thread_local pair<const ThreadPool*, size_t> current {nullptr, 0};
+            return current;
+        }
+
+        void _push(function<void()> task)
+        {
+            auto& queue = *_queues[_queueIndex()];
+
+            // Счётчик увеличивается до постановки задачи, чтобы он никогда не был меньше количества задач в очередях.
+            _pending.fetch_add(1, memory_order_release);
+
+            {
+                lock_guard<mutex> lock(queue.tasksMutex);
+                queue.tasks.push_back(move(task));
+            }
+
+            {
+                lock_guard<mutex> lock(_mutex);
+            }
+
+            _condition.notify_one();
+        }
+
+        /**
+         * Метод забирающий задачу: сначала последнюю из своей очереди, затем первую из общей,
+         * затем первую из очередей других рабочих потоков.
+        */
+        bool _pop(size_t index, function<void()>& task)
+        {
+            const size_t numberOfQueues = _queues.size();
+            const size_t shared = numberOfQueues - 1;
+
+            if (index != shared && _take(*_queues[index], task, true)) {
+                return true;
+            }
+
+            if (_take(*_queues[shared], task, false)) {
+                return true;
+            }
+
+            for (size_t i{1}; i < numberOfQueues; i++) {
+                const size_t victim = (index + i) % numberOfQueues;
+
+                if (victim != shared && _take(*_queues[victim], task, false)) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        bool _take(_Queue& queue, function<void()>& task, bool back)
+        {
+            lock_guard<mutex> lock(queue.tasksMutex);
+
+            if (queue.tasks.empty()) {
+                return false;
+            }
+
+            if (back) {
+                task = move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+
+            _pending.fetch_sub(1, memory_order_acq_rel);
+
+            return true;
+        }
+
+        void _work(size_t index)
+        {
+            _currentWorker() = {this, index};
+
+            while (true) {
+                function<void()> task;
+
+                if (_pop(index, task)) {
+                    task();
+                    continue;
+                }
+
+                unique_lock<mutex> lock(_mutex);
+
+                _condition.wait(lock, [this] {
+                    return _stop || _pending.load(memory_order_acquire) > 0;
+                });
+
+                if (_stop && !_pending.load(memory_order_acquire)) {
+                    return;
+                }
+            }
+        }
+
+        bool _runPendingTask()
+        {
+            function<void()> task;
+
+            if (!_pop(_queueIndex(), task)) {
+                return false;
+            }
+
+            task();
+            return true;
+        }
+
+        vector<thread> _workers;
+        vector<unique_ptr<_Queue>> _queues;
+        atomic<size_t> _pending;
+        mutex _mutex;
+        condition_variable _condition;
+        bool _stop;
+    };
+}
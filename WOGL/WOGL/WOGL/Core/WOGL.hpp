@@ -11,6 +11,8 @@
 
 #include "Window.hpp"
 #include "Context.hpp"
+#include "FramePipeline.hpp"
+#include "ThreadPool.hpp"
 
 namespace WOGL
 {
@@ -0,0 +1,37 @@
+//
+//  BlockCompression.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef BlockCompression_hpp
+#define BlockCompression_hpp
+
+#include <GL/glew.h>
+
+namespace WOGL
+{
+    /**
+     * Форматы блочного сжатия. Значения совпадают с соответствующими значениями TexelFormat.
+     *
+     * @field BC1 RGB, 8 байт на блок 4x4 (DXT1)
+     * @field BC3 RGBA, 16 байт на блок 4x4 (DXT5)
+     * @field BC4 один канал, 8 байт на блок 4x4 (RGTC1)
+     * @field BC5 два канала, 16 байт на блок 4x4 (RGTC2), подходит для карт нормалей
+     * @field BC7 RGBA, 16 байт на блок 4x4 (BPTC)
+    */
+    enum class BlockFormat: GLenum
+    {
+        BC1 = GL_COMPRESSED_RGB_S3TC_DXT1_EXT,
+        BC3 = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+        BC4 = GL_COMPRESSED_RED_RGTC1,
+        BC5 = GL_COMPRESSED_RG_RGTC2,
+        BC7 = GL_COMPRESSED_RGBA_BPTC_UNORM
+    };
+}
+
+#include "BlockCompression.inl"
+
+#endif /* BlockCompression_hpp */
@@ -0,0 +1,621 @@
+//
+//  BlockCompression.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include "Texture2D.hpp"
+#include "MipChain.hpp"
+#include "../Core/ThreadPool.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <vector>
+#include <array>
+#include <limits>
+
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#   include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace WOGL
+{
+    /**
+     * Двумерная текстура, сжатая одним из форматов BlockFormat.
+     * Все уровни mipmap'а хранятся в одном непрерывном массиве.
+    */
+    class CompressedTexture2D
+    {
+        friend class BaseTextureRenderer2D;
+        friend class InitializeCubeMapTextureRenderer;
+
+        struct Level
+        {
+            size_t offset;
+            size_t size;
+            size_t width;
+            size_t height;
+        };
+
+    public:
+        /**
+         * Конструктор выделяющий память под numberOfLevels уровней.
+         *
+         * @param bf формат сжатия
+         * @param width ширина нулевого уровня
+         * @param height высота нулевого уровня
+         * @param numberOfLevels количество уровней
+         * @throw invalid_argument в случае если width, height или numberOfLevels равны нулю
+        */
+        explicit CompressedTexture2D(BlockFormat bf, size_t width, size_t height, size_t numberOfLevels = 1) :
+            _format{bf},
+            _width{width},
+            _height{height}
+        {
+            if (!width || !height || !numberOfLevels) {
+                throw invalid_argument("Compressed texture is empty");
+            }
+
+            size_t size = 0;
+
+            for (size_t i{0}; i < numberOfLevels; i++) {
+                const size_t levelSize = ((width + 3) / 4) * ((height + 3) / 4) * blockSize(bf);
+
+                _levels.push_back(Level{size, levelSize, width, height});
+                size += levelSize;
+
+                width = max<size_t>(width / 2, 1);
+                height = max<size_t>(height / 2, 1);
+            }
+
+            _data.resize(size);
+        }
+
+        CompressedTexture2D(CompressedTexture2D&& texture) :
+            _data{move(texture._data)},
+            _levels{move(texture._levels)},
+            _format{texture._format},
+            _width{texture._width},
+            _height{texture._height}
+        {
+        }
+
+        CompressedTexture2D(const CompressedTexture2D&) = delete;
+        CompressedTexture2D& operator=(const CompressedTexture2D&) = delete;
+        CompressedTexture2D& operator=(CompressedTexture2D&&) = delete;
+
+        BlockFormat format() const noexcept
+        {
+            return _format;
+        }
+
+        size_t width() const noexcept
+        {
+            return _width;
+        }
+
+        size_t height() const noexcept
+        {
+            return _height;
+        }
+
+        size_t numberOfLevels() const noexcept
+        {
+            return _levels.size();
+        }
+
+        size_t width(size_t level) const
+        {
+            return _levels.at(level).width;
+        }
+
+        size_t height(size_t level) const
+        {
+            return _levels.at(level).height;
+        }
+
+        /**
+         * Метод возвращающий размер уровня в байтах.
+         *
+         * @param level уровень
+         * @return размер в байтах
+         * @throw out_of_range в случае если уровня нет
+        */
+        size_t size(size_t level) const
+        {
+            return _levels.at(level).size;
+        }
+
+        size_t sizeInBytes() const noexcept
+        {
+            return _data.size();
+        }
+
+        const uint8_t* data(size_t level = 0) const
+        {
+            return &_data[_levels.at(level).offset];
+        }
+
+        uint8_t* data(size_t level = 0)
+        {
+            return &_data[_levels.at(level).offset];
+        }
+
+        /**
+         * Метод возвращающий размер блока 4x4 в байтах.
+         *
+         * @param bf формат сжатия
+         * @return размер блока
+        */
+        static constexpr size_t blockSize(BlockFormat bf) noexcept
+        {
+            return bf == BlockFormat::BC1 || bf == BlockFormat::BC4 ? 8 : 16;
+        }
+
+    private:
+        vector<uint8_t> _data;
+        vector<Level> _levels;
+        BlockFormat _format;
+        size_t _width;
+        size_t _height;
+    };
+
+    /**
+     * Кодировщик блочного сжатия на CPU.
+     * Блоки кодируются в пуле потоков; поиск ограничивающего прямоугольника блока выполняется с помощью SSE2.
+     *
+     * BC1/BC3 - цвета концов отрезка берутся из ограничивающего прямоугольника (с отступом внутрь),
+     * индексы - ближайший цвет палитры.
+     * BC4/BC5 - восьмизначная палитра между минимумом и максимумом канала.
+     * BC7 - используется только режим 6 (одно подмножество RGBA 7777 + p-бит, 4-х битные индексы).
+    */
+    class BlockEncoder
+    {
+    public:
+        /**
+         * Метод сжимающий текстуру.
+         *
+         * @param texture текстура
+         * @param bf формат сжатия
+         * @param pool пул потоков
+         * @return сжатая текстура
+         * @throw invalid_argument в случае если текстура пустая
+        */
+        template<TexelType Tx>
+        static CompressedTexture2D compress(const Texture2D<uint8_t, Tx>& texture, BlockFormat bf, ThreadPool& pool = ThreadPool::global())
+        {
+            CompressedTexture2D compressed(bf, texture._width, texture._height);
+            compressLevel(&texture._data[0], texture._width, texture._height, numberOfChannels(Tx), bf, compressed.data(0), pool);
+            return compressed;
+        }
+
+        /**
+         * Метод сжимающий все уровни mipmap-цепочки.
+         *
+         * @param chain mipmap-цепочка
+         * @param bf формат сжатия
+         * @param pool пул потоков
+         * @return сжатая текстура
+        */
+        template<TexelType Tx>
+        static CompressedTexture2D compress(const MipChain2D<uint8_t, Tx>& chain, BlockFormat bf, ThreadPool& pool = ThreadPool::global())
+        {
+            CompressedTexture2D compressed(bf, chain.width(0), chain.height(0), chain.numberOfLevels());
+
+            for (size_t i{0}; i < chain.numberOfLevels(); i++) {
+                compressLevel(chain.data(i), chain.width(i), chain.height(i), numberOfChannels(Tx), bf, compressed.data(i), pool);
+            }
+
+            return compressed;
+        }
+
+        /**
+         * Метод сжимающий одно изображение с чередующимися каналами.
+         *
+         * @param data данные изображения
+         * @param width ширина
+         * @param height высота
+         * @param channels количество каналов (1 - 4)
+         * @param bf формат сжатия
+         * @param out массив размером не меньше ((width + 3) / 4) * ((height + 3) / 4) * CompressedTexture2D::blockSize(bf)
+         * @param pool пул потоков
+        */
+        static void compressLevel(const uint8_t* data, size_t width, size_t height, size_t channels, BlockFormat bf, uint8_t* out, ThreadPool& pool = ThreadPool::global())
+        {
+            const size_t blocksX = (width + 3) / 4;
+            const size_t blocksY = (height + 3) / 4;
+            const size_t blockSize = CompressedTexture2D::blockSize(bf);
+
+            pool.parallelFor(0, blocksY, [=] (size_t begin, size_t end) {
+                alignas(16) uint8_t rgba[64];
+
+                for (size_t by = begin; by < end; by++) {
+                    for (size_t bx{0}; bx < blocksX; bx++) {
+                        uint8_t* block = out + (by * blocksX + bx) * blockSize;
+
+                        _fetchBlock(data, width, height, channels, bx * 4, by * 4, rgba);
+
+                        switch (bf) {
+                            case BlockFormat::BC1:
+                                encodeBC1(rgba, block);
+                                break;
+                            case BlockFormat::BC3:
+                                encodeBC3(rgba, block);
+                                break;
+                            case BlockFormat::BC4:
+                                encodeBC4(rgba, 0, block);
+                                break;
+                            case BlockFormat::BC5:
+                                encodeBC5(rgba, block);
+                                break;
+                            case BlockFormat::BC7:
+                                encodeBC7(rgba, block);
+                                break;
+                        }
+                    }
+                }
+            }, 4);
+        }
+
+        /**
+         * Методы кодирующие один блок 4x4.
+         *
+         * @param rgba 16 пикселей RGBA (64 байта)
+         * @param out блок
+        */
+
+        static void encodeBC1(const uint8_t* rgba, uint8_t* out) noexcept
+        {
+            uint8_t mn[4], mx[4];
+            _bounds(rgba, mn, mx);
+
+            for (size_t c{0}; c < 3; c++) {
+                const uint8_t inset = (mx[c] - mn[c]) >> 4;
+                mn[c] += inset;
+                mx[c] -= inset;
+            }
+
+            _orientDiagonal(rgba, 3, mn, mx);
+
+            uint16_t c0 = _to565(mx);
+            uint16_t c1 = _to565(mn);
+
+            // В четырёхцветном режиме c0 должен быть больше c1.
+            if (c0 < c1) {
+                swap(c0, c1);
+            }
+
+            int32_t palette[4][3];
+            _from565(c0, palette[0]);
+            _from565(c1, palette[1]);
+
+            for (size_t c{0}; c < 3; c++) {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+            }
+
+            uint32_t indices = 0;
+
+            if (c0 != c1) {
+                for (size_t i{0}; i < 16; i++) {
+                    const uint8_t* p = rgba + i * 4;
+                    uint32_t best = 0;
+                    int32_t bestDistance = numeric_limits<int32_t>::max();
+
+                    for (uint32_t j{0}; j < 4; j++) {
+                        const int32_t dr = p[0] - palette[j][0];
+                        const int32_t dg = p[1] - palette[j][1];
+                        const int32_t db = p[2] - palette[j][2];
+                        const int32_t distance = dr * dr + dg * dg + db * db;
+
+                        if (distance < bestDistance) {
+                            bestDistance = distance;
+                            best = j;
+                        }
+                    }
+
+                    indices |= best << (2 * i);
+                }
+            }
+
+            out[0] = c0 & 0xFF;
+            out[1] = c0 >> 8;
+            out[2] = c1 & 0xFF;
+            out[3] = c1 >> 8;
+            out[4] = indices & 0xFF;
+            out[5] = (indices >> 8) & 0xFF;
+            out[6] = (indices >> 16) & 0xFF;
+            out[7] = indices >> 24;
+        }
+
+        static void encodeBC3(const uint8_t* rgba, uint8_t* out) noexcept
+        {
+            encodeBC4(rgba, 3, out);
+            encodeBC1(rgba, out + 8);
+        }
+
+        /**
+         * @param channel номер канала, который необходимо закодировать
+        */
+        static void encodeBC4(const uint8_t* rgba, size_t channel, uint8_t* out) noexcept
+        {
+            uint8_t a0 = 0;
+            uint8_t a1 = 255;
+
+            for (size_t i{0}; i < 16; i++) {
+                a0 = max(a0, rgba[i * 4 + channel]);
+                a1 = min(a1, rgba[i * 4 + channel]);
+            }
+
+            out[0] = a0;
+            out[1] = a1;
+
+            uint64_t indices = 0;
+
+            if (a0 != a1) {
+                int32_t palette[8] = {a0, a1};
+
+                for (int32_t j{1}; j < 7; j++) {
+                    palette[j + 1] = ((7 - j) * a0 + j * a1 + 3) / 7;
+                }
+
+                for (size_t i{0}; i < 16; i++) {
+                    const int32_t value = rgba[i * 4 + channel];
+                    uint64_t best = 0;
+                    int32_t bestDistance = 256;
+
+                    for (uint64_t j{0}; j < 8; j++) {
+                        const int32_t distance = abs(value - palette[j]);
+
+                        if (distance < bestDistance) {
+                            bestDistance = distance;
+                            best = j;
+                        }
+                    }
+
+                    indices |= best << (3 * i);
+                }
+            }
+
+            for (size_t i{0}; i < 6; i++) {
+                out[2 + i] = (indices >> (8 * i)) & 0xFF;
+            }
+        }
+
+        static void encodeBC5(const uint8_t* rgba, uint8_t* out) noexcept
+        {
+            encodeBC4(rgba, 0, out);
+            encodeBC4(rgba, 1, out + 8);
+        }
+
+        static void encodeBC7(const uint8_t* rgba, uint8_t* out) noexcept
+        {
+            static constexpr int32_t weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+            uint8_t mn[4], mx[4];
+            _bounds(rgba, mn, mx);
+
+            for (size_t c{0}; c < 4; c++) {
+                const uint8_t inset = (mx[c] - mn[c]) >> 5;
+                mn[c] += inset;
+                mx[c] -= inset;
+            }
+
+            _orientDiagonal(rgba, 4, mn, mx);
+
+            uint8_t endpoints[2][4];
+            uint32_t pbits[2];
+            int32_t reconstructed[2][4];
+
+            _quantizeBC7(mn, endpoints[0], pbits[0], reconstructed[0]);
+            _quantizeBC7(mx, endpoints[1], pbits[1], reconstructed[1]);
+
+            int32_t direction[4];
+            int32_t length = 0;
+
+            for (size_t c{0}; c < 4; c++) {
+                direction[c] = reconstructed[1][c] - reconstructed[0][c];
+                length += direction[c] * direction[c];
+            }
+
+            uint32_t indices[16] = {};
+
+            if (length > 0) {
+                for (size_t i{0}; i < 16; i++) {
+                    int32_t projection = 0;
+
+                    for (size_t c{0}; c < 4; c++) {
+                        projection += (rgba[i * 4 + c] - reconstructed[0][c]) * direction[c];
+                    }
+
+                    const int32_t weight = min(max((projection * 64 + length / 2) / length, 0), 64);
+                    uint32_t best = 0;
+
+                    for (uint32_t j{1}; j < 16; j++) {
+                        if (abs(weights[j] - weight) < abs(weights[best] - weight)) {
+                            best = j;
+                        }
+                    }
+
+                    indices[i] = best;
+                }
+            }
+
+            // Старший бит индекса первого пикселя не хранится и должен быть равен нулю.
+            if (indices[0] & 8) {
+                swap(endpoints[0], endpoints[1]);
+                swap(pbits[0], pbits[1]);
+
+                for (auto& index: indices) {
+                    index = 15 - index;
+                }
+            }
+
+            memset(out, 0, 16);
+            size_t position = 0;
+
+            _writeBits(out, position, 1 << 6, 7);
+
+            for (size_t c{0}; c < 4; c++) {
+                _writeBits(out, position, endpoints[0][c], 7);
+                _writeBits(out, position, endpoints[1][c], 7);
+            }
+
+            _writeBits(out, position, pbits[0], 1);
+            _writeBits(out, position, pbits[1], 1);
+            _writeBits(out, position, indices[0], 3);
+
+            for (size_t i{1}; i < 16; i++) {
+                _writeBits(out, position, indices[i], 4);
+            }
+        }
+
+    private:
+        static void _fetchBlock(const uint8_t* data, size_t width, size_t height, size_t channels, size_t x0, size_t y0, uint8_t* rgba) noexcept
+        {
+            if (channels == 4 && x0 + 4 <= width && y0 + 4 <= height) {
+                for (size_t y{0}; y < 4; y++) {
+                    memcpy(rgba + y * 16, data + ((y0 + y) * width + x0) * 4, 16);
+                }
+
+                return;
+            }
+
+            for (size_t y{0}; y < 4; y++) {
+                const size_t sy = min(y0 + y, height - 1);
+
+                for (size_t x{0}; x < 4; x++) {
+                    const size_t sx = min(x0 + x, width - 1);
+                    const uint8_t* src = data + (sy * width + sx) * channels;
+                    uint8_t* dst = rgba + (y * 4 + x) * 4;
+
+                    dst[0] = src[0];
+                    dst[1] = channels > 1 ? src[1] : 0;
+                    dst[2] = channels > 2 ? src[2] : 0;
+                    dst[3] = channels > 3 ? src[3] : 255;
+                }
+            }
+        }
+
+        static void _bounds(const uint8_t* rgba, uint8_t* mn, uint8_t* mx) noexcept
+        {
+#if defined(__SSE2__) || defined(_M_X64)
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + 16));
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + 32));
+            const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + 48));
+
+            __m128i minimum = _mm_min_epu8(_mm_min_epu8(a, b), _mm_min_epu8(c, d));
+            __m128i maximum = _mm_max_epu8(_mm_max_epu8(a, b), _mm_max_epu8(c, d));
+
+            minimum = _mm_min_epu8(minimum, _mm_srli_si128(minimum, 8));
+            minimum = _mm_min_epu8(minimum, _mm_srli_si128(minimum, 4));
+            maximum = _mm_max_epu8(maximum, _mm_srli_si128(maximum, 8));
+            maximum = _mm_max_epu8(maximum, _mm_srli_si128(maximum, 4));
+
+            const int32_t packedMinimum = _mm_cvtsi128_si32(minimum);
+            const int32_t packedMaximum = _mm_cvtsi128_si32(maximum);
+
+            memcpy(mn, &packedMinimum, 4);
+            memcpy(mx, &packedMaximum, 4);
+#else
+            for (size_t c{0}; c < 4; c++) {
+                mn[c] = 255;
+                mx[c] = 0;
+            }
+
+            for (size_t i{0}; i < 16; i++) {
+                for (size_t c{0}; c < 4; c++) {
+                    mn[c] = min(mn[c], rgba[i * 4 + c]);
+                    mx[c] = max(mx[c], rgba[i * 4 + c]);
+                }
+            }
+#endif
+        }
+
+        /**
+         * Метод выбирающий диагональ ограничивающего прямоугольника: если канал убывает
+         * при возрастании канала с наибольшим разбросом, то его минимум и максимум меняются местами.
+        */
+        static void _orientDiagonal(const uint8_t* rgba, size_t channels, uint8_t* mn, uint8_t* mx) noexcept
+        {
+            size_t main = 0;
+
+            for (size_t c{1}; c < channels; c++) {
+                if (mx[c] - mn[c] > mx[main] - mn[main]) {
+                    main = c;
+                }
+            }
+
+            int32_t mean[4] = {};
+
+            for (size_t i{0}; i < 16; i++) {
+                for (size_t c{0}; c < channels; c++) {
+                    mean[c] += rgba[i * 4 + c];
+                }
+            }
+
+            for (size_t c{0}; c < channels; c++) {
+                if (c == main) {
+                    continue;
+                }
+
+                int32_t covariance = 0;
+
+                for (size_t i{0}; i < 16; i++) {
+                    covariance += (16 * rgba[i * 4 + c] - mean[c]) * (16 * rgba[i * 4 + main] - mean[main]);
+                }
+
+                if (covariance < 0) {
+                    swap(mn[c], mx[c]);
+                }
+            }
+        }
+
+        static uint16_t _to565(const uint8_t* color) noexcept
+        {
+            const uint32_t r = (color[0] * 31 + 127) / 255;
+            const uint32_t g = (color[1] * 63 + 127) / 255;
+            const uint32_t b = (color[2] * 31 + 127) / 255;
+
+            return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+        }
+
+        static void _from565(uint16_t color, int32_t* rgb) noexcept
+        {
+            const int32_t r = (color >> 11) & 31;
+            const int32_t g = (color >> 5) & 63;
+            const int32_t b = color & 31;
+
+            rgb[0] = (r << 3) | (r >> 2);
+            rgb[1] = (g << 2) | (g >> 4);
+            rgb[2] = (b << 3) | (b >> 2);
+        }
+
+        static void _quantizeBC7(const uint8_t* color, uint8_t* endpoint, uint32_t& pbit, int32_t* reconstructed) noexcept
+        {
+            pbit = ((color[0] & 1) + (color[1] & 1) + (color[2] & 1) + (color[3] & 1)) >= 2;
+
+            for (size_t c{0}; c < 4; c++) {
+                endpoint[c] = color[c] >> 1;
+                reconstructed[c] = (endpoint[c] << 1) | pbit;
+            }
+        }
+
+        static void _writeBits(uint8_t* block, size_t& position, uint32_t value, size_t count) noexcept
+        {
+            for (size_t i{0}; i < count; i++, position++) {
+                block[position >> 3] |= ((value >> i) & 1) << (position & 7);
+            }
+        }
+    };
+}
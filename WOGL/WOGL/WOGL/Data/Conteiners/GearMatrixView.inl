@@ -7,12 +7,10 @@
 //
 
 #include "ArrayView.hpp"
-#include <vector>
+#include "StridedView.hpp"
+#include <iterator>
 #include <stdexcept>
 
-template<typename DataType>
-class GearMatrixView;
-
 namespace WOGL
 {
     /**
@@ -21,16 +19,66 @@ namespace WOGL
      * как с 2-мерным массивом. 
      * 
      * Данный класс удобно использовать например при указании на какую то
-     * часть текустуры.
+     * часть текустуры. Строки возвращаются в виде ArrayView, которые создаются при обращении,
+     * поэтому создание обёртки ничего не выделяет (см. StridedView2D).
      * 
      * @template DataType тип (например float)
     */
     template<typename DataType>
     class GearMatrixView
     {
-        using ArraysView = vector<ArrayView<DataType>>;
-
     public:
+        /**
+         * Итератор по строкам.
+        */
+        class Iterator
+        {
+        public:
+            using iterator_category = forward_iterator_tag;
+            using value_type = ArrayView<DataType>;
+            using difference_type = ptrdiff_t;
+            using pointer = void;
+            using reference = ArrayView<DataType>;
+
+            Iterator(const StridedView2D<DataType>& view, size_t i) noexcept :
+                _view{view},
+                _i{i}
+            {
+            }
+
+            ArrayView<DataType> operator*() const
+            {
+                return ArrayView<DataType>(_view[_i], _view.width());
+            }
+
+            Iterator& operator++() noexcept
+            {
+                _i++;
+                return *this;
+            }
+
+            Iterator operator++(int) noexcept
+            {
+                Iterator it = *this;
+                _i++;
+                return it;
+            }
+
+            bool operator==(const Iterator& it) const noexcept
+            {
+                return _i == it._i;
+            }
+
+            bool operator!=(const Iterator& it) const noexcept
+            {
+                return _i != it._i;
+            }
+
+        private:
+            StridedView2D<DataType> _view;
+            size_t _i;
+        };
+
         /**
          * Конструкор.
          *
@@ -41,26 +89,15 @@ namespace WOGL
          * @param offsetCol сдвиг по столбцу
          * @param width ширина срезки
          * @param height высота срезки
-         * @throw invalid_argument в случае, если координаты срезки будут больше размеров срезки или если размер срезки больше data
+         * @throw invalid_argument в случае, если срезка выходит за пределы data
         */
         template<typename T>
-        explicit GearMatrixView(const T& data, size_t dataWidth, size_t dataHeight, size_t offsetLine, size_t offsetCol, size_t width, size_t height) :
-            _view(width)
+        explicit GearMatrixView(const T& data, size_t dataWidth, size_t dataHeight, size_t offsetLine, size_t offsetCol, size_t width, size_t height)
         {
-            if (offsetLine > height || offsetCol > width || height > dataHeight || width > dataWidth) {
-                throw invalid_argument("Incorrect arguments");
-            }
-
-            const DataType* begin;
-
             if constexpr (is_same_v<T, shared_ptr<DataType>> || is_same_v<T, weak_ptr<DataType>>) {
-                begin = data.get() + (offsetLine * dataHeight + offsetCol);
+                _init(data.get(), dataWidth, dataHeight, offsetLine, offsetCol, width, height);
             } else {
-                begin = &data[0] + (offsetLine * dataHeight + offsetCol);
-            }
-
-            for (size_t i{0}; i < height; i++, begin += dataWidth) {
-                _view.push_back(ArrayView<DataType>(begin, width));
+                _init(const_cast<DataType*>(&data[0]), dataWidth, dataHeight, offsetLine, offsetCol, width, height);
             }
         }
 
@@ -74,26 +111,15 @@ namespace WOGL
          * @param offsetCol сдвиг по столбцу
          * @param width ширина срезки
          * @param height высота срезки
-         * @throw invalid_argument в случае, если координаты срезки будут больше размеров срезки или если размер срезки больше data
+         * @throw invalid_argument в случае, если срезка выходит за пределы data
         */
         template<typename T>
-        explicit GearMatrixView(T& data, size_t dataWidth, size_t dataHeight, size_t offsetLine, size_t offsetCol, size_t width, size_t height) :
-            _view(width)
+        explicit GearMatrixView(T& data, size_t dataWidth, size_t dataHeight, size_t offsetLine, size_t offsetCol, size_t width, size_t height)
         {
-            if (offsetLine > height || offsetCol > width || height > dataHeight || width > dataWidth) {
-                throw invalid_argument("Incorrect arguments");
-            }
-
-            DataType* begin;
-
             if constexpr (is_same_v<T, shared_ptr<DataType>> || is_same_v<T, weak_ptr<DataType>>) {
-                begin = data.get() + (offsetLine * dataHeight + offsetCol);
+                _init(data.get(), dataWidth, dataHeight, offsetLine, offsetCol, width, height);
             } else {
-                begin = &data[0] + (offsetLine * dataHeight + offsetCol);
-            }
-
-            for (size_t i{0}; i < height; i++, begin += dataWidth) {
-                _view.push_back(ArrayView<DataType>(begin, width));
+                _init(&data[0], dataWidth, dataHeight, offsetLine, offsetCol, width, height);
             }
         }
 
@@ -107,23 +133,14 @@ namespace WOGL
          * @param offsetCol сдвиг по столбцу
          * @param width ширина срезки
          * @param height высота срезки
-         * @throw invalid_argument в случае, если координаты срезки будут больше размеров срезки или если размер срезки больше data
+         * @throw invalid_argument в случае, если срезка выходит за пределы data
         */
-        explicit GearMatrixView(const unique_ptr<DataType>& data, size_t dataWidth, size_t dataHeight, size_t offsetLine, size_t offsetCol, size_t width, size_t height) :
-            _view(width)
+        explicit GearMatrixView(const unique_ptr<DataType>& data, size_t dataWidth, size_t dataHeight, size_t offsetLine, size_t offsetCol, size_t width, size_t height)
         {
-            if (offsetLine > height || offsetCol > width || height > dataHeight || width > dataWidth) {
-                throw invalid_argument("Incorrect arguments");
-            }
-
-            DataType* begin = data.get() + (offsetLine * dataHeight + offsetCol);
-
-            for (size_t i{0}; i < height; i++, begin += dataWidth) {
-                _view.push_back(ArrayView<DataType>(begin, width));
-            }
+            _init(data.get(), dataWidth, dataHeight, offsetLine, offsetCol, width, height);
         }
 
-         /**
+        /**
          * Конструкор.
          *
          * @param data указатель на исходные данные
@@ -133,20 +150,11 @@ namespace WOGL
          * @param offsetCol сдвиг по столбцу
          * @param width ширина срезки
          * @param height высота срезки
-         * @throw invalid_argument в случае, если координаты срезки будут больше размеров срезки или если размер срезки больше data
+         * @throw invalid_argument в случае, если срезка выходит за пределы data
         */
-        explicit GearMatrixView(unique_ptr<DataType>& data, size_t dataWidth, size_t dataHeight, size_t offsetLine, size_t offsetCol, size_t width, size_t height) :
-            _view(width)
+        explicit GearMatrixView(unique_ptr<DataType>& data, size_t dataWidth, size_t dataHeight, size_t offsetLine, size_t offsetCol, size_t width, size_t height)
         {
-            if (offsetLine > height || offsetCol > width || height > dataHeight || width > dataWidth) {
-                throw invalid_argument("Incorrect arguments");
-            }
-
-            DataType* begin = data.get() + (offsetLine * dataHeight + offsetCol);
-
-            for (size_t i{0}; i < height; i++, begin += dataWidth) {
-                _view.push_back(ArrayView<DataType>(begin, width));
-            }
+            _init(data.get(), dataWidth, dataHeight, offsetLine, offsetCol, width, height);
         }
 
         /**
@@ -159,20 +167,11 @@ namespace WOGL
          * @param offsetCol сдвиг по столбцу
          * @param width ширина срезки
          * @param height высота срезки
-         * @throw invalid_argument в случае, если координаты срезки будут больше размеров срезки или если размер срезки больше data
+         * @throw invalid_argument в случае, если срезка выходит за пределы data
         */
-        explicit GearMatrixView(const DataType* data, size_t dataWidth, size_t dataHeight, size_t offsetLine, size_t offsetCol, size_t width, size_t height) :
-            _view(width)
+        explicit GearMatrixView(const DataType* data, size_t dataWidth, size_t dataHeight, size_t offsetLine, size_t offsetCol, size_t width, size_t height)
         {
-            if (offsetLine > height || offsetCol > width || height > dataHeight || width > dataWidth || !data) {
-                throw invalid_argument("Incorrect arguments");
-            }
-
-            DataType* begin = data + (offsetLine * dataHeight + offsetCol);
-
-            for (size_t i{0}; i < height; i++, begin += dataWidth) {
-                _view.push_back(ArrayView<DataType>(begin, width));
-            }
+            _init(const_cast<DataType*>(data), dataWidth, dataHeight, offsetLine, offsetCol, width, height);
         }
 
         /**
@@ -185,20 +184,19 @@ namespace WOGL
          * @param offsetCol сдвиг по столбцу
          * @param width ширина срезки
          * @param height высота срезки
-         * @throw invalid_argument в случае, если координаты срезки будут больше размеров срезки или если размер срезки больше data
+         * @throw invalid_argument в случае, если срезка выходит за пределы data
         */
-        explicit GearMatrixView(DataType* data, size_t dataWidth, size_t dataHeight, size_t offsetLine, size_t offsetCol, size_t width, size_t height) :
-            _view(width)
+        explicit GearMatrixView(DataType* data, size_t dataWidth, size_t dataHeight, size_t offsetLine, size_t offsetCol, size_t width, size_t height)
         {
-            if (offsetLine > height || offsetCol > width || height > dataHeight || width > dataWidth || !data) {
-                throw invalid_argument("Incorrect arguments");
-            }
-
-            DataType* begin = data + (offsetLine * dataHeight + offsetCol);
+            _init(data, dataWidth, dataHeight, offsetLine, offsetCol, width, height);
+        }
 
-            for (size_t i{0}; i < height; i++, begin += dataWidth) {
-                _view.push_back(ArrayView<DataType>(begin, width));
-            }
+        /**
+         * Конструкор из StridedView2D.
+        */
+        explicit GearMatrixView(const StridedView2D<DataType>& view) noexcept :
+            _view{view}
+        {
         }
 
         GearMatrixView(const GearMatrixView& gmv) :
@@ -207,7 +205,7 @@ namespace WOGL
         }
 
         GearMatrixView(GearMatrixView&& gmv) :
-            _view{move(gmv._view)}
+            _view{gmv._view}
         {
         }
 
@@ -222,7 +220,15 @@ namespace WOGL
         */
         size_t numLines() const noexcept
         {
-            return _view.size();
+            return _view.height();
+        }
+
+        /**
+         * @return представление срезки с шагом
+        */
+        const StridedView2D<DataType>& view() const noexcept
+        {
+            return _view;
         }
 
         /**
@@ -231,46 +237,55 @@ namespace WOGL
 
         DataType& at(size_t i, size_t j) 
         {
-            return _view[i][j];
+            return _view(i, j);
         }
 
         const DataType& at(size_t i, size_t j) const 
         {
-            return _view[i][j];
+            return _view(i, j);
         }
 
-        auto operator[](size_t i) noexcept
+        auto operator[](size_t i) 
         {
-            return _view[i];
+            return ArrayView<DataType>(_view[i], _view.width());
         }
 
-        const auto operator[](size_t i) const noexcept
+        const auto operator[](size_t i) const 
         {
-            return _view[i];
+            return ArrayView<DataType>(_view[i], _view.width());
         }
 
-        auto begin() noexcept
+        auto begin() const noexcept
         {
-            return _view.begin();
+            return Iterator(_view, 0);
         }
 
         const auto cbegin() const noexcept 
         {
-            return _view.cbegin();
+            return Iterator(_view, 0);
         }
 
-        auto end() noexcept
+        auto end() const noexcept
         {
-            return _view.end();
+            return Iterator(_view, _view.height());
         }
 
         const auto cend() const noexcept 
         {
-            return _view.cend();
+            return Iterator(_view, _view.height());
         }
 
     private:
-        ArraysView _view;
+        void _init(DataType* data, size_t dataWidth, size_t dataHeight, size_t offsetLine, size_t offsetCol, size_t width, size_t height)
+        {
+            if (offsetLine + height > dataHeight || offsetCol + width > dataWidth || (!data && width * height)) {
+                throw invalid_argument("Incorrect arguments");
+            }
+
+            _view = StridedView2D<DataType>(data + (offsetLine * dataWidth + offsetCol), width, height, dataWidth);
+        }
+
+        StridedView2D<DataType> _view;
     };
 }
 
@@ -0,0 +1,14 @@
+//
+//  StridedView.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef StridedView_hpp
+#define StridedView_hpp
+
+#include "StridedView.inl"
+
+#endif /* StridedView_hpp */
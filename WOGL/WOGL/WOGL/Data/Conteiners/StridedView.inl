@@ -0,0 +1,426 @@
+//
+//  StridedView.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <cstdint>
+#include <cstddef>
+
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace WOGL
+{
+    /**
+     * Невладеющее представление двумерного массива с шагом между строками (аналог mdspan):
+     * указатель, размеры и шаг. Создание представления и его частей ничего не выделяет,
+     * строки лежат в памяти непрерывно, поэтому циклы по строке векторизуются.
+     *
+     * Размеры и шаг задаются в элементах (для текстур - в каналах, т. е. ширина в текселях * bpp).
+     *
+     * @template DataType тип элементов (для представления только для чтения - const тип)
+    */
+    template<typename DataType>
+    class StridedView2D
+    {
+    public:
+        using ValueType = remove_const_t<DataType>;
+
+        StridedView2D() noexcept = default;
+
+        /**
+         * Конструктор.
+         *
+         * @param data указатель на первый элемент
+         * @param width количество элементов в строке
+         * @param height количество строк
+         * @param stride расстояние между началами соседних строк (если 0, то равно width)
+        */
+        StridedView2D(DataType* data, size_t width, size_t height, size_t stride = 0) noexcept :
+            _data{data},
+            _width{width},
+            _height{height},
+            _stride{stride ? stride : width}
+        {
+        }
+
+        /**
+         * Преобразование изменяемого представления в представление только для чтения.
+        */
+        template<typename T, typename = enable_if_t<is_same_v<const T, DataType> && !is_same_v<T, DataType>>>
+        StridedView2D(const StridedView2D<T>& view) noexcept :
+            StridedView2D(view.data(), view.width(), view.height(), view.stride())
+        {
+        }
+
+        size_t width() const noexcept
+        {
+            return _width;
+        }
+
+        size_t height() const noexcept
+        {
+            return _height;
+        }
+
+        size_t stride() const noexcept
+        {
+            return _stride;
+        }
+
+        /**
+         * @return количество элементов в представлении
+        */
+        size_t size() const noexcept
+        {
+            return _width * _height;
+        }
+
+        bool empty() const noexcept
+        {
+            return !_width || !_height;
+        }
+
+        /**
+         * @return true, если строки идут в памяти друг за другом без промежутков
+        */
+        bool contiguous() const noexcept
+        {
+            return _stride == _width || _height <= 1;
+        }
+
+        DataType* data() const noexcept
+        {
+            return _data;
+        }
+
+        /**
+         * @return указатель на начало i-ой строки
+        */
+        DataType* operator[](size_t i) const noexcept
+        {
+            return _data + i * _stride;
+        }
+
+        DataType& operator()(size_t i, size_t j) const noexcept
+        {
+            return _data[i * _stride + j];
+        }
+
+        DataType& at(size_t i, size_t j) const
+        {
+            if (i >= _height || j >= _width) {
+                throw out_of_range("Crossing the matrix");
+            }
+
+            return _data[i * _stride + j];
+        }
+
+        /**
+         * Метод возвращающий строку в виде представления высотой 1.
+         *
+         * @param i индекс строки
+         * @throw out_of_range в случае если строки не существует
+        */
+        StridedView2D row(size_t i) const
+        {
+            return subView(i, 0, _width, 1);
+        }
+
+        /**
+         * Метод возвращающий count строк начиная с first.
+         *
+         * @throw out_of_range в случае если строки выходят за пределы представления
+        */
+        StridedView2D rows(size_t first, size_t count) const
+        {
+            return subView(first, 0, _width, count);
+        }
+
+        /**
+         * Метод возвращающий прямоугольную часть представления (например тайл).
+         *
+         * @param offsetY смещение по строкам
+         * @param offsetX смещение по столбцам (в элементах)
+         * @param width ширина части (в элементах)
+         * @param height высота части
+         * @throw out_of_range в случае если часть выходит за пределы представления
+        */
+        StridedView2D subView(size_t offsetY, size_t offsetX, size_t width, size_t height) const
+        {
+            if (offsetY + height > _height || offsetX + width > _width) {
+                throw out_of_range("Sub view is out of range");
+            }
+
+            return StridedView2D(_data + offsetY * _stride + offsetX, width, height, _stride);
+        }
+
+        /**
+         * Метод вызывающий func(DataType* row, size_t size, size_t y) для каждой строки.
+         * Если представление непрерывно, то func вызывается один раз для всех элементов как для одной строки.
+        */
+        template<typename Func>
+        void forEachRow(Func&& func) const
+        {
+            if (contiguous()) {
+                if (!empty()) {
+                    func(_data, _width * _height, size_t{0});
+                }
+            } else {
+                for (size_t i{0}; i < _height; i++) {
+                    func(_data + i * _stride, _width, i);
+                }
+            }
+        }
+
+        /**
+         * Метод вызывающий func(DataType&) для каждого элемента.
+        */
+        template<typename Func>
+        void forEach(Func&& func) const
+        {
+            forEachRow([&func] (DataType* row, size_t size, size_t) {
+                for (size_t j{0}; j < size; j++) {
+                    func(row[j]);
+                }
+            });
+        }
+
+        /**
+         * Метод заполняющий все элементы значением value.
+        */
+        void fill(const ValueType& value) const
+        {
+            forEachRow([&value] (DataType* row, size_t size, size_t) {
+                fill_n(row, size, value);
+            });
+        }
+
+        /**
+         * Метод копирующий элементы в представление того же размера.
+         *
+         * @param view представление, в которое копируются элементы
+         * @throw invalid_argument в случае если размеры представлений не совпадают
+        */
+        void copyTo(const StridedView2D<ValueType>& view) const
+        {
+            if (view.width() != _width || view.height() != _height) {
+                throw invalid_argument("View sizes do not match");
+            }
+
+            if (contiguous() && view.contiguous()) {
+                copy_n(_data, size(), view.data());
+            } else {
+                for (size_t i{0}; i < _height; i++) {
+                    copy_n(_data + i * _stride, _width, view[i]);
+                }
+            }
+        }
+
+    private:
+        DataType* _data = nullptr;
+        size_t _width = 0;
+        size_t _height = 0;
+        size_t _stride = 0;
+    };
+
+    /**
+     * Невладеющее представление трёхмерного массива с шагами между строками и слоями.
+     *
+     * @template DataType тип элементов (для представления только для чтения - const тип)
+    */
+    template<typename DataType>
+    class StridedView3D
+    {
+    public:
+        using ValueType = remove_const_t<DataType>;
+
+        StridedView3D() noexcept = default;
+
+        /**
+         * Конструктор.
+         *
+         * @param data указатель на первый элемент
+         * @param width количество элементов в строке
+         * @param height количество строк в слое
+         * @param depth количество слоёв
+         * @param stride расстояние между началами соседних строк (если 0, то равно width)
+         * @param sliceStride расстояние между началами соседних слоёв (если 0, то равно stride * height)
+        */
+        StridedView3D(DataType* data, size_t width, size_t height, size_t depth, size_t stride = 0, size_t sliceStride = 0) noexcept :
+            _data{data},
+            _width{width},
+            _height{height},
+            _depth{depth},
+            _stride{stride ? stride : width},
+            _sliceStride{sliceStride ? sliceStride : _stride * height}
+        {
+        }
+
+        template<typename T, typename = enable_if_t<is_same_v<const T, DataType> && !is_same_v<T, DataType>>>
+        StridedView3D(const StridedView3D<T>& view) noexcept :
+            StridedView3D(view.data(), view.width(), view.height(), view.depth(), view.stride(), view.sliceStride())
+        {
+        }
+
+        size_t width() const noexcept
+        {
+            return _width;
+        }
+
+        size_t height() const noexcept
+        {
+            return _height;
+        }
+
+        size_t depth() const noexcept
+        {
+            return _depth;
+        }
+
+        size_t stride() const noexcept
+        {
+            return _stride;
+        }
+
+        size_t sliceStride() const noexcept
+        {
+            return _sliceStride;
+        }
+
+        size_t size() const noexcept
+        {
+            return _width * _height * _depth;
+        }
+
+        bool empty() const noexcept
+        {
+            return !_width || !_height || !_depth;
+        }
+
+        /**
+         * @return true, если все элементы лежат в памяти непрерывно
+        */
+        bool contiguous() const noexcept
+        {
+            return (_stride == _width || _height <= 1) && (_sliceStride == _width * _height || _depth <= 1);
+        }
+
+        DataType* data() const noexcept
+        {
+            return _data;
+        }
+
+        DataType& operator()(size_t k, size_t i, size_t j) const noexcept
+        {
+            return _data[k * _sliceStride + i * _stride + j];
+        }
+
+        DataType& at(size_t k, size_t i, size_t j) const
+        {
+            if (k >= _depth || i >= _height || j >= _width) {
+                throw out_of_range("Crossing the matrix");
+            }
+
+            return _data[k * _sliceStride + i * _stride + j];
+        }
+
+        /**
+         * Метод возвращающий слой.
+         *
+         * @param k индекс слоя
+         * @throw out_of_range в случае если слоя не существует
+        */
+        StridedView2D<DataType> slice(size_t k) const
+        {
+            if (k >= _depth) {
+                throw out_of_range("Sub view is out of range");
+            }
+
+            return StridedView2D<DataType>(_data + k * _sliceStride, _width, _height, _stride);
+        }
+
+        /**
+         * Метод возвращающий часть представления.
+         *
+         * @throw out_of_range в случае если часть выходит за пределы представления
+        */
+        StridedView3D subView(size_t offsetZ, size_t offsetY, size_t offsetX, size_t width, size_t height, size_t depth) const
+        {
+            if (offsetZ + depth > _depth || offsetY + height > _height || offsetX + width > _width) {
+                throw out_of_range("Sub view is out of range");
+            }
+
+            return StridedView3D(_data + offsetZ * _sliceStride + offsetY * _stride + offsetX, width, height, depth, _stride, _sliceStride);
+        }
+
+        /**
+         * Метод вызывающий func(DataType* row, size_t size, size_t y, size_t z) для каждой строки.
+         * Если представление непрерывно, то func вызывается один раз для всех элементов.
+        */
+        template<typename Func>
+        void forEachRow(Func&& func) const
+        {
+            if (contiguous()) {
+                if (!empty()) {
+                    func(_data, size(), size_t{0}, size_t{0});
+                }
+            } else {
+                for (size_t k{0}; k < _depth; k++) {
+                    slice(k).forEachRow([&func, k] (DataType* row, size_t size, size_t i) {
+                        func(row, size, i, k);
+                    });
+                }
+            }
+        }
+
+        template<typename Func>
+        void forEach(Func&& func) const
+        {
+            forEachRow([&func] (DataType* row, size_t size, size_t, size_t) {
+                for (size_t j{0}; j < size; j++) {
+                    func(row[j]);
+                }
+            });
+        }
+
+        void fill(const ValueType& value) const
+        {
+            forEachRow([&value] (DataType* row, size_t size, size_t, size_t) {
+                fill_n(row, size, value);
+            });
+        }
+
+        /**
+         * @throw invalid_argument в случае если размеры представлений не совпадают
+        */
+        void copyTo(const StridedView3D<ValueType>& view) const
+        {
+            if (view.width() != _width || view.height() != _height || view.depth() != _depth) {
+                throw invalid_argument("View sizes do not match");
+            }
+
+            if (contiguous() && view.contiguous()) {
+                copy_n(_data, size(), view.data());
+            } else {
+                for (size_t k{0}; k < _depth; k++) {
+                    slice(k).copyTo(view.slice(k));
+                }
+            }
+        }
+
+    private:
+        DataType* _data = nullptr;
+        size_t _width = 0;
+        size_t _height = 0;
+        size_t _depth = 0;
+        size_t _stride = 0;
+        size_t _sliceStride = 0;
+    };
+}
@@ -0,0 +1,14 @@
+//
+//  ViewAlgorithms.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef ViewAlgorithms_hpp
+#define ViewAlgorithms_hpp
+
+#include "ViewAlgorithms.inl"
+
+#endif /* ViewAlgorithms_hpp */
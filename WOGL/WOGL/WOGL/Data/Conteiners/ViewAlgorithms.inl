@@ -0,0 +1,471 @@
+//
+//  ViewAlgorithms.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include "ArrayView.hpp"
+#include "MatrixView.hpp"
+#include "GearMatrixView.hpp"
+#include "StridedView.hpp"
+#include "../../Core/ThreadPool.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+#include <vector>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace WOGL
+{
+    /**
+     * Параллельные алгоритмы над представлениями (ArrayView, MatrixView, GearMatrixView, StridedView2D, StridedView3D).
+     *
+     * Работа делится между потоками пула по строкам (или, если представление непрерывно, по отрезкам одинаковой длины),
+     * а внутри потока обрабатываются непрерывные строки простыми циклами, которые векторизуются компилятором.
+     * Количество частей зависит только от размера представления и количества потоков,
+     * поэтому результаты редукций не зависят от расписания потоков.
+    */
+    class ViewAlgorithms
+    {
+        /**
+         * Минимальное количество элементов, обрабатываемое одной задачей.
+        */
+        static constexpr size_t _GRAIN = 32768;
+
+        /**
+         * Набор строк: count строк длиной width, строки слоя идут с шагом stride, слои - с шагом sliceStride.
+        */
+        template<typename T>
+        struct _Rows
+        {
+            T* data;
+            size_t width;
+            size_t count;
+            size_t stride;
+            size_t rowsPerSlice;
+            size_t sliceStride;
+
+            T* row(size_t i) const noexcept
+            {
+                return data + (i / rowsPerSlice) * sliceStride + (i % rowsPerSlice) * stride;
+            }
+
+            bool contiguous() const noexcept
+            {
+                return (stride == width || rowsPerSlice <= 1) && (sliceStride == width * rowsPerSlice || count <= rowsPerSlice);
+            }
+
+            _Rows flat() const noexcept
+            {
+                return _Rows{data, width * count, count ? size_t{1} : size_t{0}, width * count, 1, width * count};
+            }
+        };
+
+    public:
+        /**
+         * Метод заполняющий все элементы представления значением value.
+         *
+         * @param view представление
+         * @param value значение
+         * @param pool пул потоков
+        */
+        template<typename View, typename T>
+        static void fill(const View& view, const T& value, ThreadPool& pool = ThreadPool::global())
+        {
+            auto rows = _rows(view);
+            using DataType = remove_pointer_t<decltype(rows.data)>;
+            const DataType v = static_cast<DataType>(value);
+
+            _parallel(rows, pool, 1, [&v] (DataType* data, size_t n, size_t) {
+                fill_n(data, n, v);
+            });
+        }
+
+        /**
+         * Метод заменяющий каждый элемент x представления на func(x).
+         *
+         * @param view представление
+         * @param func функция вида T func(const T&)
+         * @param pool пул потоков
+        */
+        template<typename View, typename Func>
+        static void transform(const View& view, Func&& func, ThreadPool& pool = ThreadPool::global())
+        {
+            auto rows = _rows(view);
+            using DataType = remove_pointer_t<decltype(rows.data)>;
+
+            _parallel(rows, pool, 1, [&func] (DataType* data, size_t n, size_t) {
+                for (size_t i{0}; i < n; i++) {
+                    data[i] = func(data[i]);
+                }
+            });
+        }
+
+        /**
+         * Метод записывающий в dst значения func(x) для каждого элемента x из src.
+         * Представления должны иметь одинаковый размер (в элементах) по каждому измерению.
+         *
+         * @param src исходное представление
+         * @param dst представление для результата
+         * @param func функция вида U func(const T&)
+         * @param pool пул потоков
+         * @throw invalid_argument в случае если размеры представлений не совпадают
+        */
+        template<typename SrcView, typename DstView, typename Func>
+        static void transform(const SrcView& src, const DstView& dst, Func&& func, ThreadPool& pool = ThreadPool::global())
+        {
+            auto srcRows = _rows(src);
+            auto dstRows = _rows(dst);
+
+            if (srcRows.width != dstRows.width || srcRows.count != dstRows.count || srcRows.rowsPerSlice != dstRows.rowsPerSlice) {
+                throw invalid_argument("View sizes do not match");
+            }
+
+            if (srcRows.contiguous() && dstRows.contiguous()) {
+                srcRows = srcRows.flat();
+                dstRows = dstRows.flat();
+            }
+
+            using DstType = remove_pointer_t<decltype(dstRows.data)>;
+
+            _parallel(dstRows, pool, 1, [&func, &srcRows] (DstType* data, size_t n, size_t index) {
+                const auto* source = srcRows.count == 1 ? srcRows.data + index : srcRows.row(index);
+
+                for (size_t i{0}; i < n; i++) {
+                    data[i] = func(source[i]);
+                }
+            }, false);
+        }
+
+        /**
+         * Метод вычисляющий reduce(... reduce(reduce(identity, map(x0)), map(x1)) ..., map(xn)).
+         * reduce должна быть ассоциативной, identity - её нейтральным элементом,
+         * так как части представления сворачиваются независимо, а затем их результаты объединяются по порядку.
+         *
+         * @param view представление
+         * @param identity нейтральный элемент
+         * @param map функция вида R map(const T&)
+         * @param reduce функция вида R reduce(R, R)
+         * @param pool пул потоков
+         * @return результат свёртки
+        */
+        template<typename View, typename R, typename Map, typename Reduce>
+        static R mapReduce(const View& view, R identity, Map&& map, Reduce&& reduce, ThreadPool& pool = ThreadPool::global())
+        {
+            return _reduce(_rows(view), pool, identity, [&map, &reduce, &identity] (const auto* data, size_t n) {
+                R result = identity;
+
+                for (size_t i{0}; i < n; i++) {
+                    result = reduce(result, map(data[i]));
+                }
+
+                return result;
+            }, reduce);
+        }
+
+        /**
+         * Метод вычисляющий сумму элементов.
+         * Целые числа суммируются в 64-битных целых, остальные - в double.
+        */
+        template<typename View>
+        static auto sum(const View& view, ThreadPool& pool = ThreadPool::global())
+        {
+            auto rows = _rows(view);
+            using SumType = _SumType<remove_const_t<remove_pointer_t<decltype(rows.data)>>>;
+
+            return _reduce(rows, pool, SumType{0}, [] (const auto* data, size_t n) {
+                SumType s0{0}, s1{0}, s2{0}, s3{0};
+                size_t i{0};
+
+                for (; i + 4 <= n; i += 4) {
+                    s0 += static_cast<SumType>(data[i]);
+                    s1 += static_cast<SumType>(data[i + 1]);
+                    s2 += static_cast<SumType>(data[i + 2]);
+                    s3 += static_cast<SumType>(data[i + 3]);
+                }
+
+                for (; i < n; i++) {
+                    s0 += static_cast<SumType>(data[i]);
+                }
+
+                return (s0 + s1) + (s2 + s3);
+            }, [] (SumType a, SumType b) {
+                return a + b;
+            });
+        }
+
+        /**
+         * Метод вычисляющий наименьший и наибольший элементы.
+         *
+         * @return пара (наименьший, наибольший)
+         * @throw invalid_argument в случае если представление пустое
+        */
+        template<typename View>
+        static auto minMax(const View& view, ThreadPool& pool = ThreadPool::global())
+        {
+            auto rows = _rows(view);
+            using DataType = remove_const_t<remove_pointer_t<decltype(rows.data)>>;
+            using Result = pair<DataType, DataType>;
+
+            if (!rows.width || !rows.count) {
+                throw invalid_argument("View is empty");
+            }
+
+            const DataType first = *rows.data;
+
+            return _reduce(rows, pool, Result(first, first), [first] (const auto* data, size_t n) {
+                DataType lo[4] = {first, first, first, first};
+                DataType hi[4] = {first, first, first, first};
+                size_t i{0};
+
+                for (; i + 4 <= n; i += 4) {
+                    for (size_t j{0}; j < 4; j++) {
+                        lo[j] = data[i + j] < lo[j] ? data[i + j] : lo[j];
+                        hi[j] = hi[j] < data[i + j] ? data[i + j] : hi[j];
+                    }
+                }
+
+                for (; i < n; i++) {
+                    lo[0] = data[i] < lo[0] ? data[i] : lo[0];
+                    hi[0] = hi[0] < data[i] ? data[i] : hi[0];
+                }
+
+                return Result(min(min(lo[0], lo[1]), min(lo[2], lo[3])), max(max(hi[0], hi[1]), max(hi[2], hi[3])));
+            }, [] (const Result& a, const Result& b) {
+                return Result(min(a.first, b.first), max(a.second, b.second));
+            });
+        }
+
+        /**
+         * @throw invalid_argument в случае если представление пустое
+        */
+        template<typename View>
+        static auto minValue(const View& view, ThreadPool& pool = ThreadPool::global())
+        {
+            return minMax(view, pool).first;
+        }
+
+        /**
+         * @throw invalid_argument в случае если представление пустое
+        */
+        template<typename View>
+        static auto maxValue(const View& view, ThreadPool& pool = ThreadPool::global())
+        {
+            return minMax(view, pool).second;
+        }
+
+        /**
+         * Метод строящий гистограмму значений для каждого канала.
+         * Диапазон [lo, hi) делится на bins равных корзин, значения за пределами диапазона (включая бесконечности)
+         * попадают в крайние корзины, NaN - в первую корзину.
+         *
+         * @param view представление (ширина строки должна быть кратна channels)
+         * @param bins количество корзин
+         * @param lo нижняя граница диапазона
+         * @param hi верхняя граница диапазона
+         * @param channels количество каналов в текселе
+         * @param pool пул потоков
+         * @return вектор размером channels * bins, корзина b канала c имеет индекс c * bins + b
+         * @throw invalid_argument в случае если bins или channels равны нулю, lo >= hi или ширина строки не кратна channels
+        */
+        template<typename View>
+        static vector<size_t> histogram(const View& view, size_t bins, double lo, double hi, size_t channels = 1, ThreadPool& pool = ThreadPool::global())
+        {
+            auto rows = _rows(view);
+
+            if (!bins || !channels || !(lo < hi) || rows.width % channels) {
+                throw invalid_argument("Incorrect histogram arguments");
+            }
+
+            const double scale = static_cast<double>(bins) / (hi - lo);
+            const auto last = static_cast<double>(bins - 1);
+
+            auto result = _reduce(rows, pool, vector<size_t>(), [bins, channels, lo, scale, last] (const auto* data, size_t n) {
+                vector<size_t> local (bins * channels, 0);
+
+                for (size_t i{0}; i < n; i += channels) {
+                    for (size_t c{0}; c < channels; c++) {
+                        // Ограничение выполняется до приведения к целому: бесконечности и большие значения попадают в крайние корзины,
+                        // NaN (сравнение с ним ложно) - в первую.
+                        const double bin = (static_cast<double>(data[i + c]) - lo) * scale;
+                        local[c * bins + static_cast<size_t>(bin > 0.0 ? min(bin, last) : 0.0)]++;
+                    }
+                }
+
+                return local;
+            }, [] (vector<size_t> a, const vector<size_t>& b) {
+                if (a.empty()) {
+                    return b;
+                }
+
+                for (size_t i{0}; i < b.size(); i++) {
+                    a[i] += b[i];
+                }
+
+                return a;
+            }, channels);
+
+            result.resize(bins * channels, 0);
+
+            return result;
+        }
+
+        /**
+         * Метод строящий гистограмму значений для каждого канала по всему диапазону типа (для целых типов)
+         * или по [0, 1] (для остальных типов).
+         *
+         * @throw invalid_argument в случае если bins или channels равны нулю или ширина строки не кратна channels
+        */
+        template<typename View>
+        static vector<size_t> histogram(const View& view, size_t bins, size_t channels = 1, ThreadPool& pool = ThreadPool::global())
+        {
+            using DataType = remove_const_t<remove_pointer_t<decltype(_rows(view).data)>>;
+
+            if constexpr (is_integral_v<DataType>) {
+                return histogram(view, bins, static_cast<double>(numeric_limits<DataType>::min()), static_cast<double>(numeric_limits<DataType>::max()) + 1.0, channels, pool);
+            } else {
+                return histogram(view, bins, 0.0, 1.0, channels, pool);
+            }
+        }
+
+    private:
+        template<typename T>
+        using _SumType = conditional_t<is_integral_v<T>, conditional_t<is_signed_v<T>, int64_t, uint64_t>, double>;
+
+        template<typename T>
+        static _Rows<T> _rows(const StridedView2D<T>& view) noexcept
+        {
+            return _Rows<T>{view.data(), view.width(), view.height(), view.stride(), max<size_t>(view.height(), 1), view.stride() * view.height()};
+        }
+
+        template<typename T>
+        static _Rows<T> _rows(const StridedView3D<T>& view) noexcept
+        {
+            return _Rows<T>{view.data(), view.width(), view.height() * view.depth(), view.stride(), max<size_t>(view.height(), 1), view.sliceStride()};
+        }
+
+        template<typename T>
+        static _Rows<T> _rows(const ArrayView<T>& view) noexcept
+        {
+            T* data = const_cast<T*>(view.cbegin());
+            return _Rows<T>{data, view.size(), view.size() ? size_t{1} : size_t{0}, view.size(), 1, view.size()};
+        }
+
+        template<typename T>
+        static _Rows<T> _rows(const MatrixView<T>& view) noexcept
+        {
+            return _rows(StridedView2D<T>(const_cast<T*>(view.cbegin()), view.width(), view.height()));
+        }
+
+        template<typename T>
+        static _Rows<T> _rows(const GearMatrixView<T>& view) noexcept
+        {
+            return _rows(view.view());
+        }
+
+        /**
+         * Метод вычисляющий количество частей, на которые делится работа.
+        */
+        template<typename T>
+        static size_t _numberOfChunks(const _Rows<T>& rows, ThreadPool& pool) noexcept
+        {
+            const size_t size = rows.width * rows.count;
+
+            if (!size) {
+                return 0;
+            }
+
+            const size_t units = rows.count == 1 ? rows.width : rows.count;
+            const size_t unitSize = rows.count == 1 ? 1 : rows.width;
+            const size_t grain = max<size_t>(_GRAIN / unitSize, 1);
+
+            return min((units + grain - 1) / grain, (pool.numberOfThreads() + 1) * 4);
+        }
+
+        /**
+         * Метод вызывающий func(chunk, rowFunc) для каждой части, rowFunc(kernel) вызывает kernel(data, n, index)
+         * для каждой непрерывной строки части (index - номер строки или, если представление непрерывно, смещение отрезка).
+         * Границы частей непрерывного представления кратны align.
+        */
+        template<typename T, typename Func>
+        static void _chunks(const _Rows<T>& rows, ThreadPool& pool, size_t numberOfChunks, size_t align, Func&& func)
+        {
+            if (!numberOfChunks) {
+                return;
+            }
+
+            const bool flat = rows.count == 1;
+            const size_t units = flat ? rows.width : rows.count;
+
+            const auto bound = [units, numberOfChunks, flat, align] (size_t chunk) {
+                const size_t b = units * chunk / numberOfChunks;
+                return flat && chunk != numberOfChunks ? b / align * align : b;
+            };
+
+            pool.parallelFor(0, numberOfChunks, [&] (size_t begin, size_t end) {
+                for (size_t chunk{begin}; chunk < end; chunk++) {
+                    const size_t first = bound(chunk);
+                    const size_t last = bound(chunk + 1);
+
+                    func(chunk, [&rows, flat, first, last] (auto&& kernel) {
+                        if (flat) {
+                            if (first < last) {
+                                kernel(rows.data + first, last - first, first);
+                            }
+                        } else {
+                            for (size_t i{first}; i < last; i++) {
+                                kernel(rows.row(i), rows.width, i);
+                            }
+                        }
+                    });
+                }
+            });
+        }
+
+        template<typename T, typename Kernel>
+        static void _parallel(_Rows<T> rows, ThreadPool& pool, size_t align, Kernel&& kernel, bool flatten = true)
+        {
+            if (flatten && rows.contiguous()) {
+                rows = rows.flat();
+            }
+
+            _chunks(rows, pool, _numberOfChunks(rows, pool), align, [&kernel] (size_t, auto&& forEachRow) {
+                forEachRow(kernel);
+            });
+        }
+
+        template<typename T, typename R, typename RowReduce, typename Reduce>
+        static R _reduce(_Rows<T> rows, ThreadPool& pool, const R& identity, RowReduce&& rowReduce, Reduce&& reduce, size_t align = 1)
+        {
+            if (rows.contiguous()) {
+                rows = rows.flat();
+            }
+
+            const size_t numberOfChunks = _numberOfChunks(rows, pool);
+            vector<R> partial (numberOfChunks, identity);
+
+            _chunks(rows, pool, numberOfChunks, align, [&partial, &rowReduce, &reduce] (size_t chunk, auto&& forEachRow) {
+                forEachRow([&] (const T* data, size_t n, size_t) {
+                    partial[chunk] = reduce(partial[chunk], rowReduce(data, n));
+                });
+            });
+
+            R result = identity;
+
+            for (auto& value: partial) {
+                result = reduce(result, value);
+            }
+
+            return result;
+        }
+    };
+}
@@ -0,0 +1,14 @@
+//
+//  Half.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef Half_hpp
+#define Half_hpp
+
+#include "Half.inl"
+
+#endif /* Half_hpp */
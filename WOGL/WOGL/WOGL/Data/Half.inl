@@ -0,0 +1,194 @@
+//
+//  Half.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <cstdint>
+#include <cstring>
+
+#include <limits>
+
+using namespace std;
+
+namespace WOGL
+{
+    /**
+     * Половинное число с плавающей точкой (IEEE 754 binary16), соответствует GL_HALF_FLOAT.
+     * Используется как тип каналов текстур (например Texture2D<half, TexelType::RGBA>)
+     * для форматов RGB16_F и RGBA16_F: в памяти хранится 2 байта на канал, а при загрузке
+     * драйверу не требуется переводить данные из float.
+     * Арифметика выполняется через float.
+    */
+    class half
+    {
+    public:
+        half() noexcept = default;
+
+        /**
+         * Конструктор, переводящий float в half с округлением к ближайшему чётному.
+         *
+         * @param value число
+        */
+        half(float value) noexcept :
+            _bits{_fromFloat(value)}
+        {
+        }
+
+        operator float() const noexcept
+        {
+            return _toFloat(_bits);
+        }
+
+        /**
+         * Метод создающий число из его двоичного представления.
+         *
+         * @param bits биты половинного числа
+        */
+        static half fromBits(uint16_t bits) noexcept
+        {
+            half value;
+            value._bits = bits;
+
+            return value;
+        }
+
+        /**
+         * Метод возвращающий двоичное представление числа.
+        */
+        uint16_t bits() const noexcept
+        {
+            return _bits;
+        }
+
+        half& operator+=(float value) noexcept
+        {
+            return *this = half(static_cast<float>(*this) + value);
+        }
+
+        half& operator-=(float value) noexcept
+        {
+            return *this = half(static_cast<float>(*this) - value);
+        }
+
+        half& operator*=(float value) noexcept
+        {
+            return *this = half(static_cast<float>(*this) * value);
+        }
+
+        half& operator/=(float value) noexcept
+        {
+            return *this = half(static_cast<float>(*this) / value);
+        }
+
+    private:
+        static uint16_t _fromFloat(float value) noexcept
+        {
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+
+            const uint32_t sign = (bits >> 16) & 0x8000u;
+            bits &= 0x7fffffffu;
+
+            if (bits >= 0x47800000u) {
+                return static_cast<uint16_t>(sign | (bits > 0x7f800000u ? 0x7e00u : 0x7c00u));
+            }
+
+            if (bits < 0x38800000u) {
+                float denormal;
+                memcpy(&denormal, &bits, sizeof(denormal));
+                denormal += 0.5f;
+                memcpy(&bits, &denormal, sizeof(bits));
+
+                return static_cast<uint16_t>(sign | (bits - 0x3f000000u));
+            }
+
+            bits += 0xc8000fffu + ((bits >> 13) & 1u);
+
+            return static_cast<uint16_t>(sign | (bits >> 13));
+        }
+
+        static float _toFloat(uint16_t value) noexcept
+        {
+            constexpr uint32_t shiftedExponent = 0x7c00u << 13;
+
+            uint32_t bits = (value & 0x7fffu) << 13;
+            const uint32_t exponent = bits & shiftedExponent;
+            bits += (127 - 15) << 23;
+
+            float result;
+
+            if (exponent == shiftedExponent) {
+                bits += (128 - 16) << 23;
+                memcpy(&result, &bits, sizeof(result));
+            } else if (exponent == 0) {
+                bits += 1 << 23;
+                memcpy(&result, &bits, sizeof(result));
+                result -= 6.103515625e-05f;
+            } else {
+                memcpy(&result, &bits, sizeof(result));
+            }
+
+            uint32_t resultBits;
+            memcpy(&resultBits, &result, sizeof(resultBits));
+            resultBits |= static_cast<uint32_t>(value & 0x8000u) << 16;
+            memcpy(&result, &resultBits, sizeof(result));
+
+            return result;
+        }
+
+        uint16_t _bits;
+    };
+
+    static_assert(sizeof(half) == sizeof(uint16_t), "half must occupy 2 bytes");
+}
+
+namespace std
+{
+    template<>
+    class numeric_limits<WOGL::half>
+    {
+    public:
+        static constexpr bool is_specialized = true;
+        static constexpr bool is_signed = true;
+        static constexpr bool is_integer = false;
+        static constexpr bool is_exact = false;
+        static constexpr bool has_infinity = true;
+        static constexpr bool has_quiet_NaN = true;
+        static constexpr int digits = 11;
+        static constexpr int max_exponent = 16;
+        static constexpr int min_exponent = -13;
+
+        static WOGL::half min() noexcept
+        {
+            return WOGL::half::fromBits(0x0400);
+        }
+
+        static WOGL::half max() noexcept
+        {
+            return WOGL::half::fromBits(0x7bff);
+        }
+
+        static WOGL::half lowest() noexcept
+        {
+            return WOGL::half::fromBits(0xfbff);
+        }
+
+        static WOGL::half epsilon() noexcept
+        {
+            return WOGL::half::fromBits(0x1400);
+        }
+
+        static WOGL::half infinity() noexcept
+        {
+            return WOGL::half::fromBits(0x7c00);
+        }
+
+        static WOGL::half quiet_NaN() noexcept
+        {
+            return WOGL::half::fromBits(0x7e00);
+        }
+    };
+}
@@ -0,0 +1,47 @@
+//
+//  HdrLoader.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef HdrLoader_hpp
+#define HdrLoader_hpp
+
+#include <cstdint>
+
+namespace WOGL
+{
+    /**
+     * Способы сжатия OpenEXR.
+     * HdrLoader поддерживает NONE, RLE, ZIPS и ZIP.
+    */
+    enum class ExrCompression : uint8_t
+    {
+        NONE,
+        RLE,
+        ZIPS,
+        ZIP,
+        PIZ,
+        PXR24,
+        B44,
+        B44A,
+        DWAA,
+        DWAB
+    };
+
+    /**
+     * Типы каналов OpenEXR.
+    */
+    enum class ExrPixelType : int32_t
+    {
+        UINT,
+        HALF,
+        FLOAT
+    };
+}
+
+#include "HdrLoader.inl"
+
+#endif /* HdrLoader_hpp */
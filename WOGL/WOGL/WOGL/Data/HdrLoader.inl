@@ -0,0 +1,688 @@
+//
+//  HdrLoader.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <zlib.h>
+
+#include "Texture2D.hpp"
+#include "Half.hpp"
+#include "PixelConversion.hpp"
+#include "../Core/ThreadPool.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+
+#include <array>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <fstream>
+#include <limits>
+#include <type_traits>
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace WOGL
+{
+    /**
+     * Загрузчик HDR изображений: Radiance RGBE (.hdr) и OpenEXR (.exr, scanline и tile, каналы half/float/uint).
+     * Изображение декодируется сразу в Texture2D<float> или Texture2D<half> без потери диапазона.
+     *
+     * Блоки OpenEXR (и преобразование RGBE в float) обрабатываются параллельно в пуле потоков.
+     * Каналы R, G, B, A (или Y для изображений в оттенках серого) раскладываются по каналам текстуры,
+     * отсутствующий альфа-канал заполняется единицами, остальные каналы пропускаются.
+     *
+     * Строки текстуры хранятся сверху вниз, как и у Texture2D::loadTexture.
+    */
+    class HdrLoader
+    {
+        struct Reader
+        {
+            const uint8_t* ptr;
+            const uint8_t* end;
+
+            size_t remaining() const noexcept
+            {
+                return static_cast<size_t>(end - ptr);
+            }
+
+            const uint8_t* bytes(size_t n)
+            {
+                if (remaining() < n) {
+                    throw invalid_argument("Unexpected end of HDR file");
+                }
+
+                const auto* result = ptr;
+                ptr += n;
+
+                return result;
+            }
+
+            template<typename T>
+            T read()
+            {
+                T value;
+                memcpy(&value, bytes(sizeof(T)), sizeof(T));
+
+                return value;
+            }
+
+            string_view string()
+            {
+                const auto* zero = static_cast<const uint8_t*>(memchr(ptr, 0, remaining()));
+
+                if (!zero) {
+                    throw invalid_argument("Unexpected end of HDR file");
+                }
+
+                const string_view result (reinterpret_cast<const char*>(ptr), static_cast<size_t>(zero - ptr));
+                ptr = zero + 1;
+
+                return result;
+            }
+
+            string_view line()
+            {
+                const auto* newline = static_cast<const uint8_t*>(memchr(ptr, '\n', remaining()));
+
+                if (!newline) {
+                    throw invalid_argument("Unexpected end of HDR file");
+                }
+
+                const string_view result (reinterpret_cast<const char*>(ptr), static_cast<size_t>(newline - ptr));
+                ptr = newline + 1;
+
+                return result;
+            }
+        };
+
+        /**
+         * Каналы в блоке хранятся подряд, поэтому канал начинается в строке шириной w со смещения offset * w.
+        */
+        struct ExrChannel
+        {
+            ExrPixelType type;
+            int32_t target;
+            size_t offset;
+        };
+
+        struct ExrHeader
+        {
+            vector<ExrChannel> channels;
+            ExrCompression compression = ExrCompression::NONE;
+            int32_t xMin = 0, yMin = 0, xMax = -1, yMax = -1;
+            bool tiled = false;
+            uint32_t tileWidth = 0, tileHeight = 0;
+            size_t pixelSize = 0;
+        };
+
+        static constexpr int32_t LUMINANCE = -1;
+
+    public:
+        /**
+         * Функция загружающая HDR изображение. Формат определяется по сигнатуре файла.
+         *
+         * @template DataType тип каналов текстуры (float или half)
+         * @template Tx тип текселя
+         * @param path путь до изображения
+         * @param pool пул потоков, в котором декодируется изображение
+         * @throw invalid_argument в случае если не удалось прочитать файл, он повреждён или его формат не поддерживается
+        */
+        template<typename DataType, TexelType Tx>
+        static Texture2D<DataType, Tx> load(const string_view path, ThreadPool& pool = ThreadPool::global())
+        {
+            ifstream file (string(path), ios::binary | ios::ate);
+
+            if (!file) {
+                throw invalid_argument("Failed to load the image at the specified path");
+            }
+
+            vector<uint8_t> data (static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(reinterpret_cast<char*>(data.data()), static_cast<streamsize>(data.size()));
+
+            if (!file) {
+                throw invalid_argument("Failed to load the image at the specified path");
+            }
+
+            return decode<DataType, Tx>(data.data(), data.size(), pool);
+        }
+
+        /**
+         * Функция запускающая загрузку HDR изображения в пуле потоков.
+         *
+         * @param path путь до изображения
+         * @param pool пул потоков, в котором декодируется изображение
+         * @return future<Texture2D> загруженная текстура (если не удалось загрузить изображение, то future хранит invalid_argument)
+        */
+        template<typename DataType, TexelType Tx>
+        static auto loadAsync(const string_view path, ThreadPool& pool = ThreadPool::global())
+        {
+            return pool.submit([path = string(path), &pool] {
+                return load<DataType, Tx>(path, pool);
+            });
+        }
+
+        /**
+         * Функция декодирующая HDR изображение из памяти. Формат определяется по сигнатуре.
+         *
+         * @param data содержимое файла
+         * @param size размер содержимого в байтах
+         * @param pool пул потоков, в котором декодируется изображение
+         * @throw invalid_argument в случае если данные повреждены или их формат не поддерживается
+        */
+        template<typename DataType, TexelType Tx>
+        static Texture2D<DataType, Tx> decode(const uint8_t* data, size_t size, ThreadPool& pool = ThreadPool::global())
+        {
+            if (size >= 4 && data[0] == 0x76 && data[1] == 0x2f && data[2] == 0x31 && data[3] == 0x01) {
+                return decodeOpenEXR<DataType, Tx>(data, size, pool);
+            }
+
+            if (size >= 2 && data[0] == '#' && data[1] == '?') {
+                return decodeRadiance<DataType, Tx>(data, size, pool);
+            }
+
+            throw invalid_argument("Unknown HDR image format");
+        }
+
+        /**
+         * Функция декодирующая изображение Radiance RGBE (.hdr).
+         * Строки распаковываются последовательно, а преобразование RGBE в float выполняется параллельно.
+        */
+        template<typename DataType, TexelType Tx>
+        static Texture2D<DataType, Tx> decodeRadiance(const uint8_t* data, size_t size, ThreadPool& pool = ThreadPool::global())
+        {
+            _checkDataType<DataType>();
+
+            Reader reader {data, data + size};
+
+            if (reader.line().substr(0, 2) != "#?") {
+                throw invalid_argument("Invalid Radiance HDR file");
+            }
+
+            for (auto line = reader.line(); !line.empty(); line = reader.line()) {
+                if (line.substr(0, 7) == "FORMAT=" && line != "FORMAT=32-bit_rle_rgbe") {
+                    throw invalid_argument("Unsupported Radiance HDR pixel format");
+                }
+            }
+
+            const string resolution (reader.line());
+            char ySign, xSign;
+            int32_t height, width;
+
+            if (sscanf(resolution.c_str(), "%cY %d %cX %d", &ySign, &height, &xSign, &width) != 4 || xSign != '+' || width <= 0 || height <= 0) {
+                throw invalid_argument("Unsupported Radiance HDR orientation");
+            }
+
+            vector<uint8_t> rgbe (static_cast<size_t>(width) * height * 4);
+
+            for (size_t y{0}; y < static_cast<size_t>(height); y++) {
+                _readRadianceScanline(reader, &rgbe[y * width * 4], width);
+            }
+
+            Texture2D<DataType, Tx> texture (width, height);
+            constexpr size_t channels = numberOfChannels(Tx);
+            static const auto scales = _rgbeScales();
+
+            // "+Y" означает, что строки записаны снизу вверх.
+            const bool flip = ySign == '+';
+
+            pool.parallelFor(0, height, [&] (size_t begin, size_t end) {
+                for (size_t y{begin}; y < end; y++) {
+                    const auto* src = &rgbe[(flip ? height - 1 - y : y) * width * 4];
+                    auto* dst = &texture._data[y * width * channels];
+
+                    for (size_t x{0}; x < static_cast<size_t>(width); x++, src += 4, dst += channels) {
+                        const float scale = scales[src[3]];
+                        const array<float, 4> rgba {src[0] * scale, src[1] * scale, src[2] * scale, 1.0f};
+
+                        for (size_t c{0}; c < channels; c++) {
+                            dst[c] = DataType(rgba[c]);
+                        }
+                    }
+                }
+            }, 16);
+
+            return texture;
+        }
+
+        /**
+         * Функция декодирующая изображение OpenEXR (.exr).
+         * Поддерживаются однослойные scanline и tile файлы (из tile файлов с mipmap'ами читается нулевой уровень)
+         * со сжатием NONE, RLE, ZIPS и ZIP и каналами с дискретизацией 1. Блоки декодируются параллельно.
+        */
+        template<typename DataType, TexelType Tx>
+        static Texture2D<DataType, Tx> decodeOpenEXR(const uint8_t* data, size_t size, ThreadPool& pool = ThreadPool::global())
+        {
+            _checkDataType<DataType>();
+
+            Reader reader {data, data + size};
+            const auto header = _readExrHeader(reader);
+
+            const size_t width = static_cast<size_t>(header.xMax - header.xMin) + 1;
+            const size_t height = static_cast<size_t>(header.yMax - header.yMin) + 1;
+
+            size_t blockWidth, blockHeight, blocksX, blocksY;
+
+            if (header.tiled) {
+                blockWidth = header.tileWidth;
+                blockHeight = header.tileHeight;
+            } else {
+                blockWidth = width;
+                blockHeight = _linesPerBlock(header.compression);
+            }
+
+            blocksX = (width + blockWidth - 1) / blockWidth;
+            blocksY = (height + blockHeight - 1) / blockHeight;
+
+            const size_t numberOfBlocks = blocksX * blocksY;
+            vector<uint64_t> offsets (numberOfBlocks);
+            memcpy(offsets.data(), reader.bytes(numberOfBlocks * sizeof(uint64_t)), numberOfBlocks * sizeof(uint64_t));
+
+            Texture2D<DataType, Tx> texture (width, height);
+            constexpr size_t channels = numberOfChannels(Tx);
+
+            if constexpr (channels == 4) {
+                bool alpha = false;
+
+                for (const auto& channel: header.channels) {
+                    alpha = alpha || channel.target == 3;
+                }
+
+                for (size_t i{3}; i < texture._data.size() && !alpha; i += 4) {
+                    texture._data[i] = DataType(1.0f);
+                }
+            }
+
+            pool.parallelFor(0, numberOfBlocks, [&] (size_t begin, size_t end) {
+                vector<uint8_t> unpacked;
+                vector<uint8_t> raw;
+                vector<float> row (blockWidth);
+                vector<uint16_t> halfRow (blockWidth);
+
+                for (size_t i{begin}; i < end; i++) {
+                    Reader block {data, data + size};
+
+                    if (offsets[i] >= size) {
+                        throw invalid_argument("Corrupted OpenEXR file");
+                    }
+
+                    block.ptr += offsets[i];
+
+                    size_t x0, y0;
+
+                    if (header.tiled) {
+                        const auto tileX = block.read<int32_t>();
+                        const auto tileY = block.read<int32_t>();
+                        const auto levelX = block.read<int32_t>();
+                        const auto levelY = block.read<int32_t>();
+
+                        if (levelX || levelY || tileX < 0 || tileY < 0 || static_cast<size_t>(tileX) >= blocksX || static_cast<size_t>(tileY) >= blocksY) {
+                            throw invalid_argument("Corrupted OpenEXR file");
+                        }
+
+                        x0 = tileX * blockWidth;
+                        y0 = tileY * blockHeight;
+                    } else {
+                        const auto y = block.read<int32_t>();
+
+                        if (y < header.yMin || y > header.yMax) {
+                            throw invalid_argument("Corrupted OpenEXR file");
+                        }
+
+                        x0 = 0;
+                        y0 = static_cast<size_t>(y - header.yMin);
+                    }
+
+                    const auto packedSize = block.read<int32_t>();
+
+                    if (packedSize < 0) {
+                        throw invalid_argument("Corrupted OpenEXR file");
+                    }
+
+                    const auto* packed = block.bytes(static_cast<size_t>(packedSize));
+                    const size_t w = min(blockWidth, width - x0);
+                    const size_t h = min(blockHeight, height - y0);
+                    const size_t lineSize = w * header.pixelSize;
+                    const size_t rawSize = lineSize * h;
+
+                    const uint8_t* pixels = _unpackExrBlock(header.compression, packed, static_cast<size_t>(packedSize), rawSize, unpacked, raw);
+
+                    for (size_t y{0}; y < h; y++) {
+                        const auto* line = pixels + y * lineSize;
+                        auto* dst = &texture._data[((y0 + y) * width + x0) * channels];
+
+                        for (const auto& channel: header.channels) {
+                            if (channel.target >= static_cast<int32_t>(channels)) {
+                                continue;
+                            }
+
+                            const auto* src = line + channel.offset * w;
+
+                            if constexpr (is_same_v<DataType, half>) {
+                                if (channel.type == ExrPixelType::HALF) {
+                                    memcpy(halfRow.data(), src, w * sizeof(uint16_t));
+                                } else {
+                                    _readExrFloats(channel.type, src, row.data(), w);
+                                    PixelConversion::floatToHalf(row.data(), halfRow.data(), w);
+                                }
+
+                                _scatter<channels>(channel.target, halfRow.data(), w, dst, [] (uint16_t bits) {
+                                    return half::fromBits(bits);
+                                });
+                            } else {
+                                if (channel.type == ExrPixelType::HALF) {
+                                    memcpy(halfRow.data(), src, w * sizeof(uint16_t));
+                                    PixelConversion::halfToFloat(halfRow.data(), row.data(), w);
+                                } else {
+                                    _readExrFloats(channel.type, src, row.data(), w);
+                                }
+
+                                _scatter<channels>(channel.target, row.data(), w, dst, [] (float value) {
+                                    return value;
+                                });
+                            }
+                        }
+                    }
+                }
+            });
+
+            return texture;
+        }
+
+    private:
+        template<typename DataType>
+        static constexpr void _checkDataType() noexcept
+        {
+            static_assert(is_same_v<DataType, float> || is_same_v<DataType, half>, "HDR images are decoded into float or half textures");
+        }
+
+        static array<float, 256> _rgbeScales() noexcept
+        {
+            array<float, 256> scales {};
+
+            for (size_t e{1}; e < scales.size(); e++) {
+                scales[e] = ldexp(1.0f, static_cast<int32_t>(e) - (128 + 8));
+            }
+
+            return scales;
+        }
+
+        static void _readRadianceScanline(Reader& reader, uint8_t* out, size_t width)
+        {
+            // Строки шириной от 8 до 32767 обычно сжаты RLE отдельно по каждому компоненту.
+            if (width >= 8 && width < 32768 && reader.remaining() >= 4 &&
+                reader.ptr[0] == 2 && reader.ptr[1] == 2 && !(reader.ptr[2] & 0x80)) {
+                const auto* header = reader.bytes(4);
+
+                if (((header[2] << 8) | header[3]) != static_cast<int32_t>(width)) {
+                    throw invalid_argument("Corrupted Radiance HDR file");
+                }
+
+                for (size_t c{0}; c < 4; c++) {
+                    for (size_t x{0}; x < width; ) {
+                        size_t count = *reader.bytes(1);
+
+                        if (count > 128) {
+                            count -= 128;
+
+                            if (x + count > width) {
+                                throw invalid_argument("Corrupted Radiance HDR file");
+                            }
+
+                            const uint8_t value = *reader.bytes(1);
+
+                            for (size_t i{0}; i < count; i++, x++) {
+                                out[x * 4 + c] = value;
+                            }
+                        } else {
+                            if (!count || x + count > width) {
+                                throw invalid_argument("Corrupted Radiance HDR file");
+                            }
+
+                            const auto* values = reader.bytes(count);
+
+                            for (size_t i{0}; i < count; i++, x++) {
+                                out[x * 4 + c] = values[i];
+                            }
+                        }
+                    }
+                }
+
+                return;
+            }
+
+            // Несжатая строка или старый RLE (1, 1, 1, n повторяет предыдущий пиксель).
+            size_t shift = 0;
+
+            for (size_t x{0}; x < width; ) {
+                const auto* pixel = reader.bytes(4);
+
+                if (pixel[0] == 1 && pixel[1] == 1 && pixel[2] == 1) {
+                    const size_t count = shift < 24 ? static_cast<size_t>(pixel[3]) << shift : 0;
+
+                    if (!x || x + count > width) {
+                        throw invalid_argument("Corrupted Radiance HDR file");
+                    }
+
+                    for (size_t i{0}; i < count; i++, x++) {
+                        memcpy(out + x * 4, out + (x - 1) * 4, 4);
+                    }
+
+                    shift += 8;
+                } else {
+                    memcpy(out + x * 4, pixel, 4);
+                    x++;
+                    shift = 0;
+                }
+            }
+        }
+
+        static ExrHeader _readExrHeader(Reader& reader)
+        {
+            reader.bytes(4);
+
+            const auto version = reader.read<uint32_t>();
+
+            // Биты 11 и 12: deep данные и несколько частей.
+            if ((version & 0xff) != 2 || (version & 0x1800)) {
+                throw invalid_argument("Unsupported OpenEXR file");
+            }
+
+            ExrHeader header;
+            header.tiled = version & 0x200;
+
+            bool hasChannels = false, hasDataWindow = false, hasTiles = false;
+
+            for (auto name = reader.string(); !name.empty(); name = reader.string()) {
+                reader.string();
+
+                const auto attributeSize = reader.read<int32_t>();
+
+                if (attributeSize < 0) {
+                    throw invalid_argument("Corrupted OpenEXR file");
+                }
+
+                const auto* value = reader.bytes(static_cast<size_t>(attributeSize));
+                Reader attribute {value, value + attributeSize};
+
+                if (name == "channels") {
+                    hasChannels = true;
+
+                    for (auto channelName = attribute.string(); !channelName.empty(); channelName = attribute.string()) {
+                        const auto type = static_cast<ExrPixelType>(attribute.read<int32_t>());
+                        attribute.bytes(4);
+                        const auto xSampling = attribute.read<int32_t>();
+                        const auto ySampling = attribute.read<int32_t>();
+
+                        if (type != ExrPixelType::UINT && type != ExrPixelType::HALF && type != ExrPixelType::FLOAT) {
+                            throw invalid_argument("Unsupported OpenEXR pixel type");
+                        }
+
+                        if (xSampling != 1 || ySampling != 1) {
+                            throw invalid_argument("Subsampled OpenEXR channels are not supported");
+                        }
+
+                        header.channels.push_back(ExrChannel{type, _exrChannelTarget(channelName), header.pixelSize});
+                        header.pixelSize += type == ExrPixelType::HALF ? 2 : 4;
+                    }
+                } else if (name == "compression") {
+                    header.compression = static_cast<ExrCompression>(attribute.read<uint8_t>());
+                } else if (name == "dataWindow") {
+                    hasDataWindow = true;
+                    header.xMin = attribute.read<int32_t>();
+                    header.yMin = attribute.read<int32_t>();
+                    header.xMax = attribute.read<int32_t>();
+                    header.yMax = attribute.read<int32_t>();
+                } else if (name == "tiles") {
+                    hasTiles = true;
+                    header.tileWidth = attribute.read<uint32_t>();
+                    header.tileHeight = attribute.read<uint32_t>();
+                }
+            }
+
+            if (!hasChannels || !hasDataWindow || (header.tiled && (!hasTiles || !header.tileWidth || !header.tileHeight)) ||
+                header.xMax < header.xMin || header.yMax < header.yMin) {
+                throw invalid_argument("Corrupted OpenEXR file");
+            }
+
+            if (header.compression != ExrCompression::NONE && header.compression != ExrCompression::RLE &&
+                header.compression != ExrCompression::ZIPS && header.compression != ExrCompression::ZIP) {
+                throw invalid_argument("Unsupported OpenEXR compression");
+            }
+
+            return header;
+        }
+
+        static int32_t _exrChannelTarget(const string_view name) noexcept
+        {
+            if (name == "R") {
+                return 0;
+            } else if (name == "G") {
+                return 1;
+            } else if (name == "B") {
+                return 2;
+            } else if (name == "A") {
+                return 3;
+            } else if (name == "Y") {
+                return LUMINANCE;
+            }
+
+            return numeric_limits<int32_t>::max();
+        }
+
+        static size_t _linesPerBlock(ExrCompression compression) noexcept
+        {
+            return compression == ExrCompression::ZIP ? 16 : 1;
+        }
+
+        static const uint8_t* _unpackExrBlock(ExrCompression compression, const uint8_t* packed, size_t packedSize, size_t rawSize,
+                                              vector<uint8_t>& unpacked, vector<uint8_t>& raw)
+        {
+            // Блок, который не удалось сжать, хранится как есть.
+            if (compression == ExrCompression::NONE || packedSize == rawSize) {
+                if (packedSize != rawSize) {
+                    throw invalid_argument("Corrupted OpenEXR file");
+                }
+
+                return packed;
+            }
+
+            unpacked.resize(rawSize);
+
+            if (compression == ExrCompression::RLE) {
+                size_t size = 0;
+
+                for (const auto* end = packed + packedSize; packed < end; ) {
+                    const auto count = static_cast<int8_t>(*packed++);
+
+                    if (count < 0) {
+                        if (size - count > rawSize || static_cast<size_t>(end - packed) < static_cast<size_t>(-count)) {
+                            throw invalid_argument("Corrupted OpenEXR file");
+                        }
+
+                        memcpy(&unpacked[size], packed, -count);
+                        packed += -count;
+                        size += -count;
+                    } else {
+                        if (size + count + 1 > rawSize || packed == end) {
+                            throw invalid_argument("Corrupted OpenEXR file");
+                        }
+
+                        memset(&unpacked[size], *packed++, count + 1);
+                        size += count + 1;
+                    }
+                }
+
+                if (size != rawSize) {
+                    throw invalid_argument("Corrupted OpenEXR file");
+                }
+            } else {
+                uLongf size = static_cast<uLongf>(rawSize);
+
+                if (uncompress(unpacked.data(), &size, packed, static_cast<uLong>(packedSize)) != Z_OK || size != rawSize) {
+                    throw invalid_argument("Corrupted OpenEXR file");
+                }
+            }
+
+            // Перед сжатием байты разделяются на две половины и к ним применяется дельта-кодирование.
+            for (size_t i{1}; i < rawSize; i++) {
+                unpacked[i] = static_cast<uint8_t>(unpacked[i - 1] + unpacked[i] - 128);
+            }
+
+            raw.resize(rawSize);
+
+            const size_t half = (rawSize + 1) / 2;
+
+            for (size_t i{0}; i < rawSize / 2; i++) {
+                raw[2 * i] = unpacked[i];
+                raw[2 * i + 1] = unpacked[half + i];
+            }
+
+            if (rawSize & 1) {
+                raw[rawSize - 1] = unpacked[half - 1];
+            }
+
+            return raw.data();
+        }
+
+        static void _readExrFloats(ExrPixelType type, const uint8_t* src, float* dst, size_t n) noexcept
+        {
+            if (type == ExrPixelType::FLOAT) {
+                memcpy(dst, src, n * sizeof(float));
+            } else {
+                for (size_t i{0}; i < n; i++) {
+                    uint32_t value;
+                    memcpy(&value, src + i * sizeof(uint32_t), sizeof(uint32_t));
+                    dst[i] = static_cast<float>(value);
+                }
+            }
+        }
+
+        template<size_t Channels, typename T, typename DataType, typename Func>
+        static void _scatter(int32_t target, const T* src, size_t n, DataType* dst, Func&& func) noexcept
+        {
+            if (target == LUMINANCE) {
+                for (size_t i{0}; i < n; i++) {
+                    const DataType value = func(src[i]);
+
+                    for (size_t c{0}; c < min<size_t>(Channels, 3); c++) {
+                        dst[i * Channels + c] = value;
+                    }
+                }
+            } else {
+                for (size_t i{0}; i < n; i++) {
+                    dst[i * Channels + target] = func(src[i]);
+                }
+            }
+        }
+    };
+}
@@ -0,0 +1,29 @@
+//
+//  ImagePipeline.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef ImagePipeline_hpp
+#define ImagePipeline_hpp
+
+namespace WOGL
+{
+    /**
+     * Фильтр изменения размера изображения.
+     *
+     * @field BILINEAR треугольный фильтр (при уменьшении расширяется, поэтому не даёт алиасинга)
+     * @field LANCZOS3 фильтр Ланцоша на 6 отсчётов, даёт более чёткий результат
+    */
+    enum class ResampleFilter
+    {
+        BILINEAR,
+        LANCZOS3
+    };
+}
+
+#include "ImagePipeline.inl"
+
+#endif /* ImagePipeline_hpp */
@@ -0,0 +1,833 @@
+//
+//  ImagePipeline.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include "Texture2D.hpp"
+#include "PixelConversion.hpp"
+#include "../Core/ThreadPool.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace WOGL
+{
+    /**
+     * Полоса строк изображения, каналы которой хранятся во float.
+     * Строки нумеруются так же, как в изображении, полоса хранит строки [first, first + rows).
+    */
+    class ImageBand
+    {
+    public:
+        void reset(size_t width, size_t channels, size_t first, size_t rows, size_t imageHeight)
+        {
+            _width = width;
+            _channels = channels;
+            _first = first;
+            _rows = rows;
+            _imageHeight = imageHeight;
+            _data.resize(width * channels * rows);
+        }
+
+        float* row(size_t y) noexcept
+        {
+            return &_data[(y - _first) * _width * _channels];
+        }
+
+        const float* row(size_t y) const noexcept
+        {
+            return &_data[(y - _first) * _width * _channels];
+        }
+
+        /**
+         * Метод возвращающий строку y, ограниченную краями изображения (строки за краем повторяют крайнюю).
+        */
+        const float* clampedRow(ptrdiff_t y) const noexcept
+        {
+            return row(static_cast<size_t>(clamp<ptrdiff_t>(y, 0, static_cast<ptrdiff_t>(_imageHeight) - 1)));
+        }
+
+        size_t width() const noexcept
+        {
+            return _width;
+        }
+
+        size_t channels() const noexcept
+        {
+            return _channels;
+        }
+
+        size_t first() const noexcept
+        {
+            return _first;
+        }
+
+        size_t rows() const noexcept
+        {
+            return _rows;
+        }
+
+        size_t imageHeight() const noexcept
+        {
+            return _imageHeight;
+        }
+
+    private:
+        size_t _width = 0;
+        size_t _channels = 0;
+        size_t _first = 0;
+        size_t _rows = 0;
+        size_t _imageHeight = 0;
+        vector<float> _data;
+    };
+
+    /**
+     * Стадия конвейера обработки изображений.
+     *
+     * Стадия получает полосу входных строк и записывает полосу выходных строк. Поточечные стадии (pointwise)
+     * изменяют полосу на месте и не требуют отдельного буфера.
+    */
+    class ImageStage
+    {
+    public:
+        virtual ~ImageStage() = default;
+
+        /**
+         * Метод готовящий стадию к обработке изображения заданного размера.
+         *
+         * @param width ширина входного изображения
+         * @param height высота входного изображения
+         * @param channels количество каналов
+         * @return подготовленная стадия или nullptr, если стадия не зависит от размера
+         * @throw invalid_argument в случае если стадия не применима к изображению
+        */
+        virtual shared_ptr<const ImageStage> prepare(size_t, size_t, size_t) const
+        {
+            return nullptr;
+        }
+
+        virtual pair<size_t, size_t> outputSize(size_t width, size_t height) const noexcept
+        {
+            return {width, height};
+        }
+
+        /**
+         * Метод возвращающий входные строки [first, last), необходимые для выходных строк [outputFirst, outputLast).
+        */
+        virtual pair<size_t, size_t> inputRows(size_t outputFirst, size_t outputLast, size_t) const noexcept
+        {
+            return {outputFirst, outputLast};
+        }
+
+        virtual bool pointwise() const noexcept
+        {
+            return false;
+        }
+
+        /**
+         * Метод изменяющий полосу на месте (для поточечных стадий).
+        */
+        virtual void apply(ImageBand&) const
+        {
+        }
+
+        /**
+         * Метод вычисляющий выходную полосу по входной.
+         *
+         * @param input входная полоса (содержит строки inputRows(...))
+         * @param output выходная полоса
+         * @param scratch временный буфер, принадлежащий потоку
+        */
+        virtual void process(const ImageBand&, ImageBand&, vector<float>&) const
+        {
+        }
+    };
+
+    /**
+     * Поточечная стадия: func(float* texel) изменяет каналы каждого текселя.
+    */
+    template<typename Func>
+    class PixelStage :
+        public ImageStage
+    {
+    public:
+        explicit PixelStage(Func func, size_t requiredChannels = 0) :
+            _func{move(func)},
+            _requiredChannels{requiredChannels}
+        {
+        }
+
+        virtual shared_ptr<const ImageStage> prepare(size_t, size_t, size_t channels) const override
+        {
+            if (_requiredChannels && channels != _requiredChannels) {
+                throw invalid_argument("Pixel operation does not support this texel type");
+            }
+
+            return nullptr;
+        }
+
+        virtual bool pointwise() const noexcept override
+        {
+            return true;
+        }
+
+        virtual void apply(ImageBand& band) const override
+        {
+            const size_t channels = band.channels();
+
+            for (size_t y{band.first()}; y < band.first() + band.rows(); y++) {
+                float* texel = band.row(y);
+
+                for (size_t x{0}; x < band.width(); x++, texel += channels) {
+                    _func(texel);
+                }
+            }
+        }
+
+    private:
+        Func _func;
+        size_t _requiredChannels;
+    };
+
+    /**
+     * Сепарабельная свёртка: строки сворачиваются с ядром horizontal, затем столбцы - с ядром vertical.
+     * За краями изображения повторяются крайние тексели.
+    */
+    class ConvolutionStage :
+        public ImageStage
+    {
+    public:
+        /**
+         * @param horizontal ядро по строкам (нечётной длины)
+         * @param vertical ядро по столбцам (нечётной длины)
+         * @throw invalid_argument в случае если длина ядра чётная
+        */
+        ConvolutionStage(vector<float> horizontal, vector<float> vertical) :
+            _horizontal{move(horizontal)},
+            _vertical{move(vertical)}
+        {
+            if (!(_horizontal.size() & 1) || !(_vertical.size() & 1)) {
+                throw invalid_argument("Convolution kernel size must be odd");
+            }
+        }
+
+        virtual pair<size_t, size_t> inputRows(size_t outputFirst, size_t outputLast, size_t inputHeight) const noexcept override
+        {
+            const size_t radius = _vertical.size() / 2;
+            return {outputFirst > radius ? outputFirst - radius : 0, min(outputLast + radius, inputHeight)};
+        }
+
+        virtual void process(const ImageBand& input, ImageBand& output, vector<float>& scratch) const override
+        {
+            const size_t channels = input.channels();
+            const size_t rowSize = input.width() * channels;
+            const auto radius = static_cast<ptrdiff_t>(_vertical.size() / 2);
+
+            scratch.resize(rowSize * input.rows());
+
+            for (size_t y{0}; y < input.rows(); y++) {
+                _convolveRow(input.row(input.first() + y), &scratch[y * rowSize], input.width(), channels);
+            }
+
+            for (size_t y{output.first()}; y < output.first() + output.rows(); y++) {
+                float* dst = output.row(y);
+                fill_n(dst, rowSize, 0.0f);
+
+                for (size_t k{0}; k < _vertical.size(); k++) {
+                    const auto source = clamp<ptrdiff_t>(static_cast<ptrdiff_t>(y) + static_cast<ptrdiff_t>(k) - radius, 0, static_cast<ptrdiff_t>(input.imageHeight()) - 1);
+                    const float* src = &scratch[(static_cast<size_t>(source) - input.first()) * rowSize];
+                    const float w = _vertical[k];
+
+                    for (size_t i{0}; i < rowSize; i++) {
+                        dst[i] += w * src[i];
+                    }
+                }
+            }
+        }
+
+    private:
+        void _convolveRow(const float* src, float* dst, size_t width, size_t channels) const noexcept
+        {
+            const size_t radius = _horizontal.size() / 2;
+            const size_t rowSize = width * channels;
+
+            fill_n(dst, rowSize, 0.0f);
+
+            // Внутренняя часть строки сворачивается сдвигами целой строки, что векторизуется,
+            // а края, для которых нужны повторения крайних текселей, обрабатываются отдельно.
+            const size_t interiorBegin = min(radius, width);
+            const size_t interiorEnd = width > radius ? max(width - radius, interiorBegin) : interiorBegin;
+
+            for (size_t k{0}; k < _horizontal.size(); k++) {
+                const float w = _horizontal[k];
+                const float* shifted = src + (static_cast<ptrdiff_t>(k) - static_cast<ptrdiff_t>(radius)) * static_cast<ptrdiff_t>(channels);
+
+                for (size_t i{interiorBegin * channels}; i < interiorEnd * channels; i++) {
+                    dst[i] += w * shifted[i];
+                }
+            }
+
+            const auto edge = [&] (size_t x) {
+                for (size_t k{0}; k < _horizontal.size(); k++) {
+                    const auto source = clamp<ptrdiff_t>(static_cast<ptrdiff_t>(x + k) - static_cast<ptrdiff_t>(radius), 0, static_cast<ptrdiff_t>(width) - 1);
+
+                    for (size_t c{0}; c < channels; c++) {
+                        dst[x * channels + c] += _horizontal[k] * src[static_cast<size_t>(source) * channels + c];
+                    }
+                }
+            };
+
+            for (size_t x{0}; x < interiorBegin; x++) {
+                edge(x);
+            }
+
+            for (size_t x{interiorEnd}; x < width; x++) {
+                edge(x);
+            }
+        }
+
+        vector<float> _horizontal;
+        vector<float> _vertical;
+    };
+
+    /**
+     * Изменение размера изображения сепарабельным фильтром.
+    */
+    class ResampleStage :
+        public ImageStage
+    {
+        struct Contributors
+        {
+            vector<size_t> offsets;
+            vector<size_t> indices;
+            vector<float> weights;
+        };
+
+    public:
+        ResampleStage(size_t width, size_t height, ResampleFilter filter) :
+            _width{width},
+            _height{height},
+            _filter{filter}
+        {
+            if (!width || !height) {
+                throw invalid_argument("Incorrect resample size");
+            }
+        }
+
+        virtual shared_ptr<const ImageStage> prepare(size_t width, size_t height, size_t) const override
+        {
+            auto stage = make_shared<ResampleStage>(*this);
+            stage->_x = _contributors(width, _width);
+            stage->_y = _contributors(height, _height);
+
+            return stage;
+        }
+
+        virtual pair<size_t, size_t> outputSize(size_t, size_t) const noexcept override
+        {
+            return {_width, _height};
+        }
+
+        virtual pair<size_t, size_t> inputRows(size_t outputFirst, size_t outputLast, size_t) const noexcept override
+        {
+            size_t first = SIZE_MAX;
+            size_t last = 0;
+
+            for (size_t y{outputFirst}; y < outputLast; y++) {
+                for (size_t i{_y.offsets[y]}; i < _y.offsets[y + 1]; i++) {
+                    first = min(first, _y.indices[i]);
+                    last = max(last, _y.indices[i] + 1);
+                }
+            }
+
+            return {first, last};
+        }
+
+        virtual void process(const ImageBand& input, ImageBand& output, vector<float>& scratch) const override
+        {
+            const size_t channels = input.channels();
+            const size_t rowSize = _width * channels;
+
+            scratch.assign(rowSize * input.rows(), 0.0f);
+
+            for (size_t y{0}; y < input.rows(); y++) {
+                const float* src = input.row(input.first() + y);
+                float* dst = &scratch[y * rowSize];
+
+                for (size_t x{0}; x < _width; x++, dst += channels) {
+                    for (size_t i{_x.offsets[x]}; i < _x.offsets[x + 1]; i++) {
+                        const float w = _x.weights[i];
+                        const float* texel = src + _x.indices[i] * channels;
+
+                        for (size_t c{0}; c < channels; c++) {
+                            dst[c] += w * texel[c];
+                        }
+                    }
+                }
+            }
+
+            for (size_t y{output.first()}; y < output.first() + output.rows(); y++) {
+                float* dst = output.row(y);
+                fill_n(dst, rowSize, 0.0f);
+
+                for (size_t i{_y.offsets[y]}; i < _y.offsets[y + 1]; i++) {
+                    const float w = _y.weights[i];
+                    const float* src = &scratch[(_y.indices[i] - input.first()) * rowSize];
+
+                    for (size_t j{0}; j < rowSize; j++) {
+                        dst[j] += w * src[j];
+                    }
+                }
+            }
+        }
+
+    private:
+        float _kernel(float x) const noexcept
+        {
+            x = fabs(x);
+
+            if (_filter == ResampleFilter::BILINEAR) {
+                return x < 1.0f ? 1.0f - x : 0.0f;
+            }
+
+            if (x < 1e-6f) {
+                return 1.0f;
+            }
+
+            if (x >= 3.0f) {
+                return 0.0f;
+            }
+
+            const float pix = 3.14159265358979f * x;
+            return 3.0f * sin(pix) * sin(pix / 3.0f) / (pix * pix);
+        }
+
+        /**
+         * Метод вычисляющий для каждого выходного отсчёта входные отсчёты и их нормированные веса.
+        */
+        Contributors _contributors(size_t inputSize, size_t outputSize) const
+        {
+            const float scale = static_cast<float>(inputSize) / static_cast<float>(outputSize);
+            const float stretch = max(scale, 1.0f);
+            const float support = (_filter == ResampleFilter::BILINEAR ? 1.0f : 3.0f) * stretch;
+
+            Contributors result;
+            result.offsets.push_back(0);
+
+            for (size_t i{0}; i < outputSize; i++) {
+                const float center = (static_cast<float>(i) + 0.5f) * scale - 0.5f;
+                const auto from = static_cast<ptrdiff_t>(floor(center - support)) + 1;
+                const auto to = static_cast<ptrdiff_t>(ceil(center + support));
+                const size_t begin = result.weights.size();
+                float sum = 0.0f;
+
+                for (ptrdiff_t j{from}; j < to; j++) {
+                    const float w = _kernel((static_cast<float>(j) - center) / stretch);
+
+                    if (w != 0.0f) {
+                        result.indices.push_back(static_cast<size_t>(clamp<ptrdiff_t>(j, 0, static_cast<ptrdiff_t>(inputSize) - 1)));
+                        result.weights.push_back(w);
+                        sum += w;
+                    }
+                }
+
+                if (result.weights.size() == begin) {
+                    result.indices.push_back(static_cast<size_t>(clamp<ptrdiff_t>(static_cast<ptrdiff_t>(lround(center)), 0, static_cast<ptrdiff_t>(inputSize) - 1)));
+                    result.weights.push_back(1.0f);
+                    sum = 1.0f;
+                }
+
+                for (size_t j{begin}; j < result.weights.size(); j++) {
+                    result.weights[j] /= sum;
+                }
+
+                result.offsets.push_back(result.weights.size());
+            }
+
+            return result;
+        }
+
+        size_t _width;
+        size_t _height;
+        ResampleFilter _filter;
+        Contributors _x;
+        Contributors _y;
+    };
+
+    /**
+     * Построение карты нормалей по карте высот (высота берётся из первого канала).
+     * Нормаль записывается в первые три канала в виде n * 0.5 + 0.5, альфа-канал сохраняется.
+    */
+    class NormalMapStage :
+        public ImageStage
+    {
+    public:
+        explicit NormalMapStage(float strength) noexcept :
+            _strength{strength}
+        {
+        }
+
+        virtual shared_ptr<const ImageStage> prepare(size_t, size_t, size_t channels) const override
+        {
+            if (channels < 3) {
+                throw invalid_argument("Normal map requires at least three channels");
+            }
+
+            return nullptr;
+        }
+
+        virtual pair<size_t, size_t> inputRows(size_t outputFirst, size_t outputLast, size_t inputHeight) const noexcept override
+        {
+            return {outputFirst > 0 ? outputFirst - 1 : 0, min(outputLast + 1, inputHeight)};
+        }
+
+        virtual void process(const ImageBand& input, ImageBand& output, vector<float>&) const override
+        {
+            const size_t channels = input.channels();
+            const size_t width = input.width();
+
+            for (size_t y{output.first()}; y < output.first() + output.rows(); y++) {
+                const float* up = input.clampedRow(static_cast<ptrdiff_t>(y) - 1);
+                const float* center = input.row(y);
+                const float* down = input.clampedRow(static_cast<ptrdiff_t>(y) + 1);
+                float* dst = output.row(y);
+
+                for (size_t x{0}; x < width; x++) {
+                    const size_t left = (x ? x - 1 : 0) * channels;
+                    const size_t right = min(x + 1, width - 1) * channels;
+
+                    const float nx = (center[left] - center[right]) * _strength;
+                    const float ny = (down[x * channels] - up[x * channels]) * _strength;
+                    const float length = sqrt(nx * nx + ny * ny + 1.0f);
+
+                    dst[x * channels] = nx / length * 0.5f + 0.5f;
+                    dst[x * channels + 1] = ny / length * 0.5f + 0.5f;
+                    dst[x * channels + 2] = 1.0f / length * 0.5f + 0.5f;
+
+                    for (size_t c{3}; c < channels; c++) {
+                        dst[x * channels + c] = center[x * channels + c];
+                    }
+                }
+            }
+        }
+
+    private:
+        float _strength;
+    };
+
+    /**
+     * Конвейер обработки изображений на CPU (например перед загрузкой текстуры в GPU).
+     *
+     * Стадии (свёртка, изменение размера, поточечные операции) записываются в конвейер и выполняются методом run.
+     * Выходное изображение делится на полосы строк, которые обрабатываются параллельно. Для каждой полосы
+     * стадии выполняются подряд: каждая стадия читает только те строки предыдущей, которые нужны для полосы,
+     * поэтому промежуточные изображения целиком не создаются, а поточечные стадии выполняются на месте.
+     * Все вычисления ведутся во float, целочисленные каналы нормализуются в [0, 1].
+     *
+     * Пример:
+     *     auto mip = ImagePipeline().gaussianBlur(1.5f).resize(512, 512).premultiplyAlpha().run(texture);
+    */
+    class ImagePipeline
+    {
+    public:
+        /**
+         * Метод добавляющий сепарабельную свёртку с одинаковым ядром по строкам и столбцам.
+         *
+         * @param kernel ядро нечётной длины
+         * @throw invalid_argument в случае если длина ядра чётная
+        */
+        ImagePipeline& convolve(const vector<float>& kernel)
+        {
+            return convolve(kernel, kernel);
+        }
+
+        /**
+         * Метод добавляющий сепарабельную свёртку.
+         *
+         * @param horizontal ядро по строкам
+         * @param vertical ядро по столбцам
+         * @throw invalid_argument в случае если длина ядра чётная
+        */
+        ImagePipeline& convolve(const vector<float>& horizontal, const vector<float>& vertical)
+        {
+            _stages.push_back(make_shared<ConvolutionStage>(horizontal, vertical));
+            return *this;
+        }
+
+        /**
+         * Метод добавляющий размытие Гаусса.
+         *
+         * @param sigma среднеквадратичное отклонение в текселях
+         * @throw invalid_argument в случае если sigma не положительна
+        */
+        ImagePipeline& gaussianBlur(float sigma)
+        {
+            if (!(sigma > 0.0f)) {
+                throw invalid_argument("Sigma must be positive");
+            }
+
+            const auto radius = static_cast<ptrdiff_t>(ceil(3.0f * sigma));
+            vector<float> kernel;
+            float sum = 0.0f;
+
+            for (ptrdiff_t i{-radius}; i <= radius; i++) {
+                kernel.push_back(exp(-0.5f * static_cast<float>(i * i) / (sigma * sigma)));
+                sum += kernel.back();
+            }
+
+            for (auto& w: kernel) {
+                w /= sum;
+            }
+
+            return convolve(kernel);
+        }
+
+        /**
+         * Метод добавляющий изменение размера.
+         *
+         * @param width новая ширина
+         * @param height новая высота
+         * @param filter фильтр
+         * @throw invalid_argument в случае если новый размер нулевой
+        */
+        ImagePipeline& resize(size_t width, size_t height, ResampleFilter filter = ResampleFilter::LANCZOS3)
+        {
+            _stages.push_back(make_shared<ResampleStage>(width, height, filter));
+            return *this;
+        }
+
+        /**
+         * Метод добавляющий построение карты нормалей по карте высот из первого канала.
+         *
+         * @param strength множитель наклона
+        */
+        ImagePipeline& normalFromHeight(float strength = 1.0f)
+        {
+            _stages.push_back(make_shared<NormalMapStage>(strength));
+            return *this;
+        }
+
+        /**
+         * Метод добавляющий умножение цвета на альфа-канал (только для RGBA).
+        */
+        ImagePipeline& premultiplyAlpha()
+        {
+            return pixel([] (float* texel) {
+                texel[0] *= texel[3];
+                texel[1] *= texel[3];
+                texel[2] *= texel[3];
+            }, 4);
+        }
+
+        /**
+         * Метод добавляющий поточечную операцию.
+         *
+         * @param func функция вида void func(float* texel), изменяющая каналы текселя
+         * @param requiredChannels количество каналов, с которым работает операция (0 - любое)
+        */
+        template<typename Func>
+        ImagePipeline& pixel(Func&& func, size_t requiredChannels = 0)
+        {
+            _stages.push_back(make_shared<PixelStage<decay_t<Func>>>(forward<Func>(func), requiredChannels));
+            return *this;
+        }
+
+        /**
+         * Метод добавляющий произвольную стадию.
+        */
+        ImagePipeline& stage(shared_ptr<const ImageStage> stage)
+        {
+            _stages.push_back(move(stage));
+            return *this;
+        }
+
+        /**
+         * Метод задающий высоту полосы строк, обрабатываемой одной задачей (0 - выбирается по ширине изображения
+         * и по полям, которые стадии добавляют к полосе, но не больше, чем нужно для загрузки всех потоков пула).
+        */
+        ImagePipeline& bandHeight(size_t height) noexcept
+        {
+            _bandHeight = height;
+            return *this;
+        }
+
+        /**
+         * Метод применяющий конвейер к текстуре.
+         *
+         * @template OutType тип каналов результата
+         * @param texture исходная текстура
+         * @param pool пул потоков
+         * @param sRGB true - если целочисленные каналы хранятся в пространстве sRGB
+         * @return обработанная текстура
+         * @throw invalid_argument в случае если стадия не применима к текстуре
+        */
+        template<typename OutType = void, typename DataType, TexelType Tx>
+        auto run(const Texture2D<DataType, Tx>& texture, ThreadPool& pool = ThreadPool::global(), bool sRGB = false) const
+        {
+            using Result = conditional_t<is_void_v<OutType>, DataType, OutType>;
+            const DataType* data = texture.textureMatrix().data();
+            const size_t width = texture.width();
+            const size_t channels = numberOfChannels(Tx);
+
+            return _run<Result, Tx>(width, texture.height(), pool, sRGB, [data, width, channels, sRGB] (ImageBand& band) {
+                for (size_t y{band.first()}; y < band.first() + band.rows(); y++) {
+                    PixelConversion::convert(data + y * width * channels, band.row(y), width * channels, channels, sRGB);
+                }
+            });
+        }
+
+        /**
+         * Метод создающий текстуру: тексели заполняются функцией gen, затем к ним применяется конвейер.
+         *
+         * @template OutType тип каналов результата
+         * @template Tx тип текселя
+         * @param width ширина
+         * @param height высота
+         * @param gen функция вида void gen(float* texel, size_t x, size_t y), вызываемая параллельно
+         * @param pool пул потоков
+         * @return текстура
+        */
+        template<typename OutType, TexelType Tx, typename Gen>
+        auto generate(size_t width, size_t height, Gen&& gen, ThreadPool& pool = ThreadPool::global()) const
+        {
+            const size_t channels = numberOfChannels(Tx);
+
+            return _run<OutType, Tx>(width, height, pool, false, [&gen, width, channels] (ImageBand& band) {
+                for (size_t y{band.first()}; y < band.first() + band.rows(); y++) {
+                    float* texel = band.row(y);
+
+                    for (size_t x{0}; x < width; x++, texel += channels) {
+                        gen(texel, x, y);
+                    }
+                }
+            });
+        }
+
+        size_t numberOfStages() const noexcept
+        {
+            return _stages.size();
+        }
+
+    private:
+        template<typename OutType, TexelType Tx, typename Source>
+        Texture2D<OutType, Tx> _run(size_t width, size_t height, ThreadPool& pool, bool sRGB, Source&& source) const
+        {
+            const size_t channels = numberOfChannels(Tx);
+            vector<shared_ptr<const ImageStage>> stages;
+            vector<pair<size_t, size_t>> sizes {{width, height}};
+
+            for (const auto& stage: _stages) {
+                auto prepared = stage->prepare(sizes.back().first, sizes.back().second, channels);
+                stages.push_back(prepared ? prepared : stage);
+                sizes.push_back(stages.back()->outputSize(sizes.back().first, sizes.back().second));
+            }
+
+            const auto [outputWidth, outputHeight] = sizes.back();
+            Texture2D<OutType, Tx> result (outputWidth, outputHeight);
+            OutType* output = result.textureMatrix().data();
+
+            if (!outputWidth || !outputHeight) {
+                return result;
+            }
+
+            const size_t rows = _bandHeight ? _bandHeight : _defaultBandHeight(stages, sizes, channels, pool.numberOfThreads() + 1);
+            const size_t numberOfBands = (outputHeight + rows - 1) / rows;
+
+            pool.parallelFor(0, numberOfBands, [&] (size_t begin, size_t end) {
+                ImageBand current;
+                ImageBand next;
+                vector<float> scratch;
+                vector<pair<size_t, size_t>> ranges (stages.size() + 1);
+
+                for (size_t band{begin}; band < end; band++) {
+                    ranges.back() = {band * rows, min((band + 1) * rows, outputHeight)};
+
+                    for (size_t k{stages.size()}; k-- > 0;) {
+                        ranges[k] = stages[k]->inputRows(ranges[k + 1].first, ranges[k + 1].second, sizes[k].second);
+                    }
+
+                    current.reset(width, channels, ranges[0].first, ranges[0].second - ranges[0].first, height);
+                    source(current);
+
+                    for (size_t k{0}; k < stages.size(); k++) {
+                        if (stages[k]->pointwise()) {
+                            stages[k]->apply(current);
+                        } else {
+                            next.reset(sizes[k + 1].first, channels, ranges[k + 1].first, ranges[k + 1].second - ranges[k + 1].first, sizes[k + 1].second);
+                            stages[k]->process(current, next, scratch);
+                            swap(current, next);
+                        }
+                    }
+
+                    for (size_t y{current.first()}; y < current.first() + current.rows(); y++) {
+                        PixelConversion::convert(current.row(y), output + y * outputWidth * channels, outputWidth * channels, channels, sRGB);
+                    }
+                }
+            });
+
+            return result;
+        }
+
+        /**
+         * Метод возвращающий входные строки источника, необходимые для выходных строк [first, last).
+        */
+        static pair<size_t, size_t> _sourceRows(const vector<shared_ptr<const ImageStage>>& stages,
+                                                const vector<pair<size_t, size_t>>& sizes, size_t first, size_t last) noexcept
+        {
+            pair<size_t, size_t> range {first, last};
+
+            for (size_t k{stages.size()}; k-- > 0;) {
+                range = stages[k]->inputRows(range.first, range.second, sizes[k].second);
+            }
+
+            return range;
+        }
+
+        /**
+         * Метод выбирающий высоту полосы: начиная с 64 КБ выходных каналов, высота удваивается,
+         * пока строки источника, общие для соседних полос (поля стадий), составляют больше 1/8 полосы.
+         * Общие строки каждая полоса преобразует и обрабатывает заново, поэтому при узкой полосе и большом
+         * радиусе размытия повторные вычисления в несколько раз превышали полезные.
+         * Высота не растёт дальше, чем нужно, чтобы полос было не меньше, чем потоков.
+        */
+        static size_t _defaultBandHeight(const vector<shared_ptr<const ImageStage>>& stages,
+                                         const vector<pair<size_t, size_t>>& sizes, size_t channels, size_t threads) noexcept
+        {
+            const auto [outputWidth, outputHeight] = sizes.back();
+            const size_t minimum = max<size_t>(65536 / (outputWidth * channels), 4);
+            const size_t maximum = max((outputHeight + threads - 1) / threads, minimum);
+            size_t rows = minimum;
+
+            while (rows < maximum && 2 * rows <= outputHeight) {
+                const size_t first = (outputHeight - 2 * rows) / 2;
+                const auto lower = _sourceRows(stages, sizes, first, first + rows);
+                const auto upper = _sourceRows(stages, sizes, first + rows, first + 2 * rows);
+                const size_t span = lower.second - lower.first;
+                const size_t overlap = lower.second > upper.first ? lower.second - upper.first : 0;
+
+                if (overlap * 8 <= span) {
+                    break;
+                }
+
+                rows *= 2;
+            }
+
+            return min(rows, maximum);
+        }
+
+        vector<shared_ptr<const ImageStage>> _stages;
+        size_t _bandHeight = 0;
+    };
+}
@@ -0,0 +1,29 @@
+//
+//  MipChain.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef MipChain_hpp
+#define MipChain_hpp
+
+namespace WOGL
+{
+    /**
+     * Фильтр, которым уменьшается каждый следующий уровень mipmap-цепочки.
+     *
+     * @field BOX усреднение 2x2 (2x2x2 для трёхмерных текстур)
+     * @field KAISER сепарабельный фильтр на 6 отсчётов (sinc с окном Кайзера), даёт более чёткие уровни без алиасинга
+    */
+    enum class MipFilter
+    {
+        BOX,
+        KAISER
+    };
+}
+
+#include "MipChain.inl"
+
+#endif /* MipChain_hpp */
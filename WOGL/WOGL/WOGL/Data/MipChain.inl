@@ -0,0 +1,596 @@
+//
+//  MipChain.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include "Texture2D.hpp"
+#include "Texture3D.hpp"
+#include "PixelConversion.hpp"
+#include "../Core/ThreadPool.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+
+#include <vector>
+#include <array>
+#include <limits>
+
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#   include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace WOGL
+{
+    /**
+     * Ядро уменьшения изображения в два раза, используемое MipChain2D и MipChain3D.
+     * Работает с данными типа float с чередующимися каналами.
+    */
+    class MipDownsampler
+    {
+    public:
+        static constexpr size_t MAX_TAPS = 6;
+
+        struct Filter
+        {
+            int32_t offset;
+            size_t size;
+            array<float, MAX_TAPS> weights;
+        };
+
+        static Filter filter(MipFilter mf) noexcept
+        {
+            Filter filter {0, 2, {0.5f, 0.5f}};
+
+            if (mf == MipFilter::KAISER) {
+                constexpr double alpha = 4.0;
+                constexpr double radius = 3.0;
+                constexpr double pi = 3.14159265358979323846;
+
+                filter.offset = -2;
+                filter.size = 6;
+
+                double sum = 0.0;
+                array<double, MAX_TAPS> weights;
+
+                for (size_t k{0}; k < filter.size; k++) {
+                    double d = static_cast<double>(k) - 2.5;
+                    double x = d * 0.5;
+                    double sinc = sin(pi * x) / (pi * x);
+                    double t = d / radius;
+
+                    weights[k] = sinc * _besselI0(alpha * sqrt(1.0 - t * t)) / _besselI0(alpha);
+                    sum += weights[k];
+                }
+
+                for (size_t k{0}; k < filter.size; k++) {
+                    filter.weights[k] = static_cast<float>(weights[k] / sum);
+                }
+            }
+
+            return filter;
+        }
+
+        /**
+         * Метод вычисляющий строки [rowBegin, rowEnd) следующего уровня.
+         * Строки нумеруются сквозным образом по всем слоям: row = z * dstHeight + y.
+         *
+         * @param filterDepth true - если нужно фильтровать по оси Z (трёхмерная текстура)
+        */
+        static void downsample(const float* src, size_t srcWidth, size_t srcHeight, size_t srcDepth,
+                               float* dst, size_t dstWidth, size_t dstHeight,
+                               size_t channels, const Filter& filter, bool filterDepth,
+                               size_t rowBegin, size_t rowEnd)
+        {
+            const size_t srcRowSize = srcWidth * channels;
+            const size_t dstRowSize = dstWidth * channels;
+            const size_t depthTaps = filterDepth ? filter.size : 1;
+
+            vector<float> tmp(srcRowSize);
+            array<const float*, MAX_TAPS * MAX_TAPS> rows;
+            array<float, MAX_TAPS * MAX_TAPS> weights;
+
+            for (size_t row = rowBegin; row < rowEnd; row++) {
+                const size_t z = row / dstHeight;
+                const size_t y = row % dstHeight;
+
+                size_t n = 0;
+
+                for (size_t kz{0}; kz < depthTaps; kz++) {
+                    const size_t sz = filterDepth ? _clamp(2 * static_cast<int64_t>(z) + filter.offset + static_cast<int64_t>(kz), srcDepth) : z;
+                    const float wz = filterDepth ? filter.weights[kz] : 1.0f;
+
+                    for (size_t ky{0}; ky < filter.size; ky++) {
+                        const size_t sy = _clamp(2 * static_cast<int64_t>(y) + filter.offset + static_cast<int64_t>(ky), srcHeight);
+
+                        rows[n] = src + (sz * srcHeight + sy) * srcRowSize;
+                        weights[n] = wz * filter.weights[ky];
+                        n++;
+                    }
+                }
+
+                combineRows(&rows[0], &weights[0], n, srcRowSize, &tmp[0]);
+                filterRow(&tmp[0], srcWidth, channels, filter, dst + row * dstRowSize, dstWidth);
+            }
+        }
+
+        /**
+         * Метод вычисляющий out[i] = sum(weights[k] * rows[k][i]).
+        */
+        static void combineRows(const float* const* rows, const float* weights, size_t numberOfRows, size_t size, float* out) noexcept
+        {
+            size_t i = 0;
+
+#if defined(__AVX__)
+            for (; i + 8 <= size; i += 8) {
+                __m256 acc = _mm256_mul_ps(_mm256_set1_ps(weights[0]), _mm256_loadu_ps(rows[0] + i));
+
+                for (size_t k{1}; k < numberOfRows; k++) {
+                    acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_set1_ps(weights[k]), _mm256_loadu_ps(rows[k] + i)));
+                }
+
+                _mm256_storeu_ps(out + i, acc);
+            }
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+            for (; i + 4 <= size; i += 4) {
+                __m128 acc = _mm_mul_ps(_mm_set1_ps(weights[0]), _mm_loadu_ps(rows[0] + i));
+
+                for (size_t k{1}; k < numberOfRows; k++) {
+                    acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(rows[k] + i)));
+                }
+
+                _mm_storeu_ps(out + i, acc);
+            }
+#endif
+
+            for (; i < size; i++) {
+                float acc = weights[0] * rows[0][i];
+
+                for (size_t k{1}; k < numberOfRows; k++) {
+                    acc += weights[k] * rows[k][i];
+                }
+
+                out[i] = acc;
+            }
+        }
+
+        /**
+         * Метод уменьшающий строку в два раза по оси X.
+        */
+        static void filterRow(const float* src, size_t srcWidth, size_t channels, const Filter& filter, float* out, size_t dstWidth) noexcept
+        {
+#if defined(__SSE2__) || defined(_M_X64)
+            if (channels == 4) {
+                for (size_t x{0}; x < dstWidth; x++) {
+                    __m128 acc = _mm_setzero_ps();
+
+                    for (size_t k{0}; k < filter.size; k++) {
+                        const size_t sx = _clamp(2 * static_cast<int64_t>(x) + filter.offset + static_cast<int64_t>(k), srcWidth);
+                        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(filter.weights[k]), _mm_loadu_ps(src + sx * 4)));
+                    }
+
+                    _mm_storeu_ps(out + x * 4, acc);
+                }
+
+                return;
+            }
+#endif
+
+            for (size_t x{0}; x < dstWidth; x++) {
+                for (size_t c{0}; c < channels; c++) {
+                    out[x * channels + c] = 0.0f;
+                }
+
+                for (size_t k{0}; k < filter.size; k++) {
+                    const size_t sx = _clamp(2 * static_cast<int64_t>(x) + filter.offset + static_cast<int64_t>(k), srcWidth);
+
+                    for (size_t c{0}; c < channels; c++) {
+                        out[x * channels + c] += filter.weights[k] * src[sx * channels + c];
+                    }
+                }
+            }
+        }
+
+        static float srgbToLinear(float x) noexcept
+        {
+            return PixelConversion::srgbToLinear(x);
+        }
+
+        static float linearToSRGB(float x) noexcept
+        {
+            return PixelConversion::linearToSRGB(x);
+        }
+
+        /**
+         * Метод переводящий элементы [begin, end) в float.
+         * Если sRGB равен true, то значения нормализуются, а цветовые каналы переводятся в линейное пространство.
+         * begin должен быть кратен channels.
+        */
+        template<typename DataType>
+        static void decode(const DataType* src, float* dst, size_t begin, size_t end, size_t channels, bool sRGB) noexcept
+        {
+            if constexpr (is_same_v<DataType, uint8_t>) {
+                if (sRGB) {
+                    PixelConversion::srgbToLinear(src + begin, dst + begin, end - begin, channels);
+                } else {
+                    PixelConversion::unormToFloat(src + begin, dst + begin, end - begin, 1.0f);
+                }
+
+                return;
+            }
+
+            const float scale = sRGB ? 1.0f / _maxValue<DataType>() : 1.0f;
+            const size_t colorChannels = min<size_t>(channels, 3);
+
+            for (size_t i = begin; i < end; i++) {
+                float value = static_cast<float>(src[i]) * scale;
+                dst[i] = sRGB && (i % channels) < colorChannels ? srgbToLinear(value) : value;
+            }
+        }
+
+        /**
+         * Метод обратный decode.
+        */
+        template<typename DataType>
+        static void encode(const float* src, DataType* dst, size_t begin, size_t end, size_t channels, bool sRGB) noexcept
+        {
+            if constexpr (is_same_v<DataType, uint8_t>) {
+                if (sRGB) {
+                    PixelConversion::linearToSRGB(src + begin, dst + begin, end - begin, channels);
+                } else {
+                    PixelConversion::floatToUnorm(src + begin, dst + begin, end - begin, 1.0f);
+                }
+
+                return;
+            }
+
+            const float scale = sRGB ? _maxValue<DataType>() : 1.0f;
+            const size_t colorChannels = min<size_t>(channels, 3);
+
+            for (size_t i = begin; i < end; i++) {
+                float value = sRGB && (i % channels) < colorChannels ? linearToSRGB(src[i]) : src[i];
+                value *= scale;
+
+                if constexpr (is_integral_v<DataType>) {
+                    value = min(max(roundf(value), static_cast<float>(numeric_limits<DataType>::lowest())), static_cast<float>(numeric_limits<DataType>::max()));
+                }
+
+                dst[i] = static_cast<DataType>(value);
+            }
+        }
+
+    private:
+        static size_t _clamp(int64_t i, size_t size) noexcept
+        {
+            return static_cast<size_t>(min<int64_t>(max<int64_t>(i, 0), static_cast<int64_t>(size) - 1));
+        }
+
+        template<typename DataType>
+        static float _maxValue() noexcept
+        {
+            if constexpr (is_integral_v<DataType>) {
+                return static_cast<float>(numeric_limits<DataType>::max());
+            } else {
+                return 1.0f;
+            }
+        }
+
+        static double _besselI0(double x) noexcept
+        {
+            double sum = 1.0;
+            double term = 1.0;
+
+            for (int32_t k{1}; k < 32; k++) {
+                term *= (x * 0.5 / k) * (x * 0.5 / k);
+                sum += term;
+            }
+
+            return sum;
+        }
+    };
+
+    /**
+     * Mipmap-цепочка двумерной текстуры, построенная на CPU.
+     * Уровни вычисляются в пуле потоков; все уровни хранятся в одном непрерывном массиве,
+     * поэтому загружаются в GPU за один проход (см. BaseTextureRenderer2D::update).
+     *
+     * @template DataType тип каждого из каналов текстуры(например float)
+     * @template Tx тип текселя
+    */
+    template<typename DataType, TexelType Tx>
+    class MipChain2D
+    {
+        struct Level
+        {
+            size_t offset;
+            size_t width;
+            size_t height;
+        };
+
+    public:
+        /**
+         * Конструктор.
+         *
+         * @param texture текстура (нулевой уровень)
+         * @param mf фильтр
+         * @param sRGB true - если данные в пространстве sRGB (фильтрация выполняется в линейном пространстве)
+         * @param pool пул потоков
+         * @throw invalid_argument в случае если текстура пустая
+        */
+        explicit MipChain2D(const Texture2D<DataType, Tx>& texture, MipFilter mf = MipFilter::BOX, bool sRGB = false, ThreadPool& pool = ThreadPool::global()) :
+            _sRGB{sRGB}
+        {
+            if (!texture._width || !texture._height) {
+                throw invalid_argument("Texture is empty");
+            }
+
+            constexpr size_t channels = numberOfChannels(Tx);
+
+            size_t width = texture._width;
+            size_t height = texture._height;
+            size_t size = 0;
+
+            for (size_t i{0}, n = numberOfMipLevels(width, height); i < n; i++) {
+                _levels.push_back(Level{size, width, height});
+                size += width * height * channels;
+                width = max<size_t>(width / 2, 1);
+                height = max<size_t>(height / 2, 1);
+            }
+
+            _data.resize(size);
+            copy(texture._data.begin(), texture._data.end(), _data.begin());
+
+            vector<float> current(texture._data.size());
+            vector<float> next;
+
+            pool.parallelFor(0, _levels[0].height, [&] (size_t begin, size_t end) {
+                MipDownsampler::decode(&texture._data[0], &current[0], begin * _levels[0].width * channels, end * _levels[0].width * channels, channels, _sRGB);
+            }, 16);
+
+            const auto filter = MipDownsampler::filter(mf);
+
+            for (size_t i{1}; i < _levels.size(); i++) {
+                const Level& src = _levels[i - 1];
+                const Level& dst = _levels[i];
+
+                next.resize(dst.width * dst.height * channels);
+
+                pool.parallelFor(0, dst.height, [&] (size_t begin, size_t end) {
+                    MipDownsampler::downsample(&current[0], src.width, src.height, 1, &next[0], dst.width, dst.height, channels, filter, false, begin, end);
+                    MipDownsampler::encode(&next[0], &_data[dst.offset], begin * dst.width * channels, end * dst.width * channels, channels, _sRGB);
+                }, max<size_t>(4096 / (dst.width * channels), 1));
+
+                swap(current, next);
+            }
+        }
+
+        MipChain2D(MipChain2D&& chain) :
+            _data{move(chain._data)},
+            _levels{move(chain._levels)},
+            _sRGB{chain._sRGB}
+        {
+        }
+
+        MipChain2D(const MipChain2D&) = delete;
+        MipChain2D& operator=(const MipChain2D&) = delete;
+        MipChain2D& operator=(MipChain2D&&) = delete;
+
+        size_t numberOfLevels() const noexcept
+        {
+            return _levels.size();
+        }
+
+        size_t width(size_t level) const
+        {
+            return _levels.at(level).width;
+        }
+
+        size_t height(size_t level) const
+        {
+            return _levels.at(level).height;
+        }
+
+        /**
+         * Метод возвращающий указатель на данные уровня.
+         *
+         * @param level уровень
+         * @return указатель на данные
+         * @throw out_of_range в случае если уровня нет
+        */
+        const DataType* data(size_t level = 0) const
+        {
+            return &_data[_levels.at(level).offset];
+        }
+
+        /**
+         * Метод возвращающий размер всех уровней в байтах.
+         *
+         * @return размер в байтах
+        */
+        size_t sizeInBytes() const noexcept
+        {
+            return _data.size() * sizeof(DataType);
+        }
+
+        /**
+         * Метод копирующий уровень в отдельную текстуру.
+         *
+         * @param level уровень
+         * @return текстура
+         * @throw out_of_range в случае если уровня нет
+        */
+        Texture2D<DataType, Tx> texture(size_t level) const
+        {
+            const Level& l = _levels.at(level);
+            Texture2D<DataType, Tx> texture(l.width, l.height);
+
+            copy(_data.begin() + l.offset, _data.begin() + l.offset + texture._data.size(), texture._data.begin());
+
+            return texture;
+        }
+
+        bool sRGB() const noexcept
+        {
+            return _sRGB;
+        }
+
+    private:
+        vector<DataType> _data;
+        vector<Level> _levels;
+        bool _sRGB;
+    };
+
+    /**
+     * Mipmap-цепочка трёхмерной текстуры, построенная на CPU.
+     *
+     * @template DataType тип каждого из каналов текстуры(например float)
+     * @template Tx тип текселя
+    */
+    template<typename DataType, TexelType Tx>
+    class MipChain3D
+    {
+        struct Level
+        {
+            size_t offset;
+            size_t width;
+            size_t height;
+            size_t depth;
+        };
+
+    public:
+        /**
+         * Конструктор.
+         *
+         * @param texture текстура (нулевой уровень)
+         * @param mf фильтр
+         * @param sRGB true - если данные в пространстве sRGB (фильтрация выполняется в линейном пространстве)
+         * @param pool пул потоков
+         * @throw invalid_argument в случае если текстура пустая
+        */
+        explicit MipChain3D(const Texture3D<DataType, Tx>& texture, MipFilter mf = MipFilter::BOX, bool sRGB = false, ThreadPool& pool = ThreadPool::global()) :
+            _sRGB{sRGB}
+        {
+            if (!texture._width || !texture._height || !texture._depth) {
+                throw invalid_argument("Texture is empty");
+            }
+
+            constexpr size_t channels = numberOfChannels(Tx);
+
+            size_t width = texture._width;
+            size_t height = texture._height;
+            size_t depth = texture._depth;
+            size_t size = 0;
+
+            for (size_t i{0}, n = numberOfMipLevels(width, height, depth); i < n; i++) {
+                _levels.push_back(Level{size, width, height, depth});
+                size += width * height * depth * channels;
+                width = max<size_t>(width / 2, 1);
+                height = max<size_t>(height / 2, 1);
+                depth = max<size_t>(depth / 2, 1);
+            }
+
+            _data.resize(size);
+            copy(texture._data.begin(), texture._data.end(), _data.begin());
+
+            vector<float> current(texture._data.size());
+            vector<float> next;
+
+            const size_t rowSize0 = _levels[0].width * channels;
+
+            pool.parallelFor(0, _levels[0].height * _levels[0].depth, [&] (size_t begin, size_t end) {
+                MipDownsampler::decode(&texture._data[0], &current[0], begin * rowSize0, end * rowSize0, channels, _sRGB);
+            }, 16);
+
+            const auto filter = MipDownsampler::filter(mf);
+
+            for (size_t i{1}; i < _levels.size(); i++) {
+                const Level& src = _levels[i - 1];
+                const Level& dst = _levels[i];
+                const size_t rowSize = dst.width * channels;
+
+                next.resize(dst.width * dst.height * dst.depth * channels);
+
+                pool.parallelFor(0, dst.height * dst.depth, [&] (size_t begin, size_t end) {
+                    MipDownsampler::downsample(&current[0], src.width, src.height, src.depth, &next[0], dst.width, dst.height, channels, filter, src.depth > 1, begin, end);
+                    MipDownsampler::encode(&next[0], &_data[dst.offset], begin * rowSize, end * rowSize, channels, _sRGB);
+                }, max<size_t>(4096 / rowSize, 1));
+
+                swap(current, next);
+            }
+        }
+
+        MipChain3D(MipChain3D&& chain) :
+            _data{move(chain._data)},
+            _levels{move(chain._levels)},
+            _sRGB{chain._sRGB}
+        {
+        }
+
+        MipChain3D(const MipChain3D&) = delete;
+        MipChain3D& operator=(const MipChain3D&) = delete;
+        MipChain3D& operator=(MipChain3D&&) = delete;
+
+        size_t numberOfLevels() const noexcept
+        {
+            return _levels.size();
+        }
+
+        size_t width(size_t level) const
+        {
+            return _levels.at(level).width;
+        }
+
+        size_t height(size_t level) const
+        {
+            return _levels.at(level).height;
+        }
+
+        size_t depth(size_t level) const
+        {
+            return _levels.at(level).depth;
+        }
+
+        /**
+         * Метод возвращающий указатель на данные уровня.
+         *
+         * @param level уровень
+         * @return указатель на данные
+         * @throw out_of_range в случае если уровня нет
+        */
+        const DataType* data(size_t level = 0) const
+        {
+            return &_data[_levels.at(level).offset];
+        }
+
+        /**
+         * Метод возвращающий размер всех уровней в байтах.
+         *
+         * @return размер в байтах
+        */
+        size_t sizeInBytes() const noexcept
+        {
+            return _data.size() * sizeof(DataType);
+        }
+
+        bool sRGB() const noexcept
+        {
+            return _sRGB;
+        }
+
+    private:
+        vector<DataType> _data;
+        vector<Level> _levels;
+        bool _sRGB;
+    };
+}
@@ -8,8 +8,11 @@
 
 #include "Texture2D.hpp"
 #include "Mesh.hpp"
+#include "../Core/ThreadPool.hpp"
 
+#include <string>
 #include <string_view>
+#include <memory>
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
@@ -22,6 +25,9 @@ using namespace std;
 
 namespace WOGL
 {
+    template<typename DataType, TexelType Tx>
+    class TextureCache;
+
     class InitializeModelMesh
     {
         using Meshes = vector<Mesh>;
@@ -140,7 +146,8 @@ namespace WOGL
         using Meshes = vector<Mesh>;
         using Models = vector<Model>;
         using TextureType = Texture2D<TextureDataType, Tx>;
-        using TextureAndTextureSlot = pair<TextureType, int32_t>;
+        using TexturePtr = shared_ptr<const TextureType>;
+        using TextureAndTextureSlot = pair<TexturePtr, int32_t>;
 
         friend class InitializeModelRenderer;
 
@@ -220,7 +227,31 @@ namespace WOGL
         */
         inline void pushTexture(const string_view path, int32_t slot)
         {
-            _textures.push_back(TextureAndTextureSlot(Texture2D<TextureDataType, Tx>::loadTexture(path), slot));
+            _textures.push_back(TextureAndTextureSlot(make_shared<TextureType>(TextureType::loadTexture(path)), slot));
+        }
+
+        /**
+         * Метод, необходимый для добавления текстуры через кэш.
+         * Если изображение уже есть в кэше, то модель будет разделять его с другими моделями.
+         * 
+         * @param path путь до 2d текстуры
+         * @param slot текстурный слот
+         * @param cache кэш текстур
+        */
+        inline void pushTexture(const string_view path, int32_t slot, TextureCache<TextureDataType, Tx>& cache)
+        {
+            _textures.push_back(TextureAndTextureSlot(cache.load(path), slot));
+        }
+
+        /**
+         * Метод, необходимый для добавления текстуры, разделяемой с другими моделями.
+         * 
+         * @param texture указатель на 2d текстуру
+         * @param slot текстурный слот
+        */
+        inline void pushTexture(TexturePtr texture, int32_t slot)
+        {
+            _textures.push_back(TextureAndTextureSlot(move(texture), slot));
         }
 
         /**
@@ -235,7 +266,7 @@ namespace WOGL
         template<template<typename> typename Ptr>
         inline void pushTexture(const Ptr<Texture2D<TextureDataType, Tx>>& ptrTexture, int32_t slot)
         {
-            _textures.push_back(TextureAndTextureSlot(*ptrTexture), slot);
+            _textures.push_back(TextureAndTextureSlot(make_shared<TextureType>(*ptrTexture), slot));
         }
 
         /**
@@ -250,7 +281,7 @@ namespace WOGL
         template<typename DelType, template<typename, typename> typename Ptr>
         inline void pushTexture(const Ptr<Texture2D<TextureDataType, Tx>, DelType>& ptrTexture, int32_t slot)
         {
-            _textures.push_back(TextureAndTextureSlot(*ptrTexture), slot);
+            _textures.push_back(TextureAndTextureSlot(make_shared<TextureType>(*ptrTexture), slot));
         }
 
         /**
@@ -264,7 +295,7 @@ namespace WOGL
         */
         inline void pushTexture(Texture2D<TextureDataType, Tx>&& texture, int32_t slot)
         {
-            _textures.push_back(TextureAndTextureSlot(texture), slot);
+            _textures.push_back(TextureAndTextureSlot(make_shared<TextureType>(move(texture)), slot));
         }
 
         /**
@@ -278,7 +309,39 @@ namespace WOGL
         */
         inline void pushTexture(const Texture2D<TextureDataType, Tx>& texture, int32_t slot)
         {
-            _textures.push_back(TextureAndTextureSlot(texture, slot));
+            _textures.push_back(TextureAndTextureSlot(make_shared<TextureType>(texture), slot));
+        }
+
+        /**
+         * Метод, необходимый для добавления нескольких текстур.
+         * Изображения декодируются параллельно в пуле потоков (вызывающий поток тоже участвует в загрузке),
+         * метод возвращает управление после загрузки всех текстур. Текстуры добавляются в порядке paths.
+         * 
+         * @param paths пути до 2d текстур и текстурные слоты
+         * @param pool пул потоков
+         * @throw invalid_argument в случае если не удалось загрузить одно из изображений (тогда ни одна текстура не добавляется)
+        */
+        void pushTextures(const vector<pair<string, int32_t>>& paths, ThreadPool& pool = ThreadPool::global())
+        {
+            _pushTextures(paths, pool, [] (const string& path) {
+                return make_shared<TextureType>(TextureType::loadTexture(path));
+            });
+        }
+
+        /**
+         * Метод, необходимый для добавления нескольких текстур через кэш.
+         * Изображения, которых нет в кэше, декодируются параллельно в пуле потоков.
+         * 
+         * @param paths пути до 2d текстур и текстурные слоты
+         * @param cache кэш текстур
+         * @param pool пул потоков
+         * @throw invalid_argument в случае если не удалось загрузить одно из изображений (тогда ни одна текстура не добавляется)
+        */
+        void pushTextures(const vector<pair<string, int32_t>>& paths, TextureCache<TextureDataType, Tx>& cache, ThreadPool& pool = ThreadPool::global())
+        {
+            _pushTextures(paths, pool, [&cache] (const string& path) {
+                return cache.load(path);
+            });
         }
 
         /**
@@ -299,7 +362,7 @@ namespace WOGL
 
         /**
          * Метод возвращающий вектор текстур с текстурными слотами.
-         * Каждый объект этого вектора имеет тип pair<...>. В first хранится сама текстура, а в second - текстурный слот.
+         * Каждый объект этого вектора имеет тип pair<...>. В first хранится указатель на константную текстуру (shared_ptr), а в second - текстурный слот.
          * 
          * @return вектор текстур с текстурными слотами
         */
@@ -310,7 +373,7 @@ namespace WOGL
 
         /**
          * Метод возвращающий вектор текстур с текстурными слотами.
-         * Каждый объект этого вектора имеет тип pair<...>. В first хранится сама текстура, а в second - текстурный слот.
+         * Каждый объект этого вектора имеет тип pair<...>. В first хранится указатель на константную текстуру (shared_ptr), а в second - текстурный слот.
          * 
          * @return константный вектор текстур с текстурными слотами
         */
@@ -321,24 +384,14 @@ namespace WOGL
 
         /**
          * Метод возвращающий i'ю 2d текстуру.
-         * 
-         * @param i порядковый индекс текстуры 
-         * @return i'ая 2d текстура
-        */
-        auto& texture(size_t i) 
-        {
-            return _textures.at(i).first;
-        }
-
-        /**
-         * Метод возвращающий i'ю 2d текстуру.
+         * Текстура может разделяться с другими моделями (и с кэшем текстур), поэтому она доступна только для чтения.
          * 
          * @param i порядковый индекс текстуры 
          * @return константная i'ая 2d текстура
         */
         const auto& texture(size_t i) const
         {
-            return _textures.at(i).first;
+            return *_textures.at(i).first;
         }
 
         /**
@@ -397,6 +450,24 @@ namespace WOGL
         }
 
     private:
+        template<typename Load>
+        void _pushTextures(const vector<pair<string, int32_t>>& paths, ThreadPool& pool, Load&& load)
+        {
+            vector<TexturePtr> textures (paths.size());
+
+            pool.parallelFor(0, paths.size(), [&paths, &textures, &load] (size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    textures[i] = load(paths[i].first);
+                }
+            });
+
+            _textures.reserve(_textures.size() + paths.size());
+
+            for (size_t i{0}; i < paths.size(); i++) {
+                _textures.push_back(TextureAndTextureSlot(move(textures[i]), paths[i].second));
+            }
+        }
+
         vector<TextureAndTextureSlot> _textures;
     };
 }
@@ -0,0 +1,42 @@
+//
+//  PixelConversion.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef PixelConversion_hpp
+#define PixelConversion_hpp
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#   define WOGL_PIXEL_CONVERSION_X86 1
+#   define WOGL_TARGET(features) __attribute__((target(features)))
+#else
+#   define WOGL_PIXEL_CONVERSION_X86 0
+#   define WOGL_TARGET(features)
+#endif
+
+namespace WOGL
+{
+    /**
+     * Набор инструкций, которым пользуются ядра преобразования пикселей.
+     * Выбирается во время выполнения по возможностям процессора.
+     *
+     * @field SCALAR скалярный код
+     * @field SSE4 SSE4.1 (включая SSSE3)
+     * @field AVX2 AVX2 + FMA + F16C
+     * @field AVX512 AVX-512F + AVX-512BW
+    */
+    enum class SimdLevel
+    {
+        SCALAR,
+        SSE4,
+        AVX2,
+        AVX512
+    };
+}
+
+#include "PixelConversion.inl"
+
+#endif /* PixelConversion_hpp */
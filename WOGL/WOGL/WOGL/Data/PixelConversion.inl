@@ -0,0 +1,973 @@
+//
+//  PixelConversion.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include "Half.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+
+#include <array>
+#include <limits>
+
+#include <algorithm>
+#include <type_traits>
+
+#if WOGL_PIXEL_CONVERSION_X86
+#   include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace WOGL
+{
+    /**
+     * Векторизованные ядра преобразования пикселей.
+     * Нужный вариант ядра выбирается во время выполнения. Преобразования между 8-битными значениями и float
+     * имеют варианты для SSE4, AVX2 и AVX-512; половинные числа и sRGB - только для AVX2 и AVX-512;
+     * расширение RGB в RGBA и перестановка каналов - для SSE4 и AVX2 (на AVX-512 используется вариант AVX2).
+     * Векторный вариант обрабатывает основную часть массива, а остаток дорабатывается скалярным кодом.
+    */
+    class PixelConversion
+    {
+    public:
+        /**
+         * Метод возвращающий набор инструкций, который используется ядрами.
+        */
+        static SimdLevel simdLevel() noexcept
+        {
+            return _level();
+        }
+
+        /**
+         * Метод ограничивающий набор инструкций, который используется ядрами
+         * (например для сравнения вариантов). Уровень выше поддерживаемого процессором не устанавливается.
+         *
+         * @param level набор инструкций
+        */
+        static void setSimdLevel(SimdLevel level) noexcept
+        {
+            _level() = min(level, _detect());
+        }
+
+        /**
+         * Метод переводящий 8-битные значения в float: dst[i] = src[i] * scale.
+         *
+         * @param src исходные данные
+         * @param dst результат
+         * @param n количество элементов
+         * @param scale множитель (по умолчанию нормализует значения в [0, 1])
+        */
+        static void unormToFloat(const uint8_t* src, float* dst, size_t n, float scale = 1.0f / 255.0f) noexcept
+        {
+            size_t i = 0;
+
+#if WOGL_PIXEL_CONVERSION_X86
+            switch (simdLevel()) {
+                case SimdLevel::AVX512:
+                    i = _unormToFloatAVX512(src, dst, n, scale);
+                    break;
+                case SimdLevel::AVX2:
+                    i = _unormToFloatAVX2(src, dst, n, scale);
+                    break;
+                case SimdLevel::SSE4:
+                    i = _unormToFloatSSE4(src, dst, n, scale);
+                    break;
+                default:
+                    break;
+            }
+#endif
+
+            for (; i < n; i++) {
+                dst[i] = static_cast<float>(src[i]) * scale;
+            }
+        }
+
+        /**
+         * Метод переводящий float в 8-битные значения: dst[i] = round(clamp(src[i] * scale, 0, 255)).
+         *
+         * @param src исходные данные
+         * @param dst результат
+         * @param n количество элементов
+         * @param scale множитель (по умолчанию переводит [0, 1] в [0, 255])
+        */
+        static void floatToUnorm(const float* src, uint8_t* dst, size_t n, float scale = 255.0f) noexcept
+        {
+            size_t i = 0;
+
+#if WOGL_PIXEL_CONVERSION_X86
+            switch (simdLevel()) {
+                case SimdLevel::AVX512:
+                    i = _floatToUnormAVX512(src, dst, n, scale);
+                    break;
+                case SimdLevel::AVX2:
+                    i = _floatToUnormAVX2(src, dst, n, scale);
+                    break;
+                case SimdLevel::SSE4:
+                    i = _floatToUnormSSE4(src, dst, n, scale);
+                    break;
+                default:
+                    break;
+            }
+#endif
+
+            for (; i < n; i++) {
+                dst[i] = _toUnorm(src[i] * scale);
+            }
+        }
+
+        /**
+         * Метод переводящий 8-битные значения в нормализованные половинные числа (IEEE 754 binary16).
+         *
+         * @param src исходные данные
+         * @param dst результат (биты половинных чисел)
+         * @param n количество элементов
+        */
+        static void unormToHalf(const uint8_t* src, uint16_t* dst, size_t n) noexcept
+        {
+            size_t i = 0;
+
+#if WOGL_PIXEL_CONVERSION_X86
+            switch (simdLevel()) {
+                case SimdLevel::AVX512:
+                    i = _unormToHalfAVX512(src, dst, n);
+                    break;
+                case SimdLevel::AVX2:
+                    i = _unormToHalfAVX2(src, dst, n);
+                    break;
+                default:
+                    break;
+            }
+#endif
+
+            for (; i < n; i++) {
+                dst[i] = floatToHalf(static_cast<float>(src[i]) * (1.0f / 255.0f));
+            }
+        }
+
+        /**
+         * Метод переводящий float в половинные числа с округлением к ближайшему чётному.
+         *
+         * @param src исходные данные
+         * @param dst результат (биты половинных чисел)
+         * @param n количество элементов
+        */
+        static void floatToHalf(const float* src, uint16_t* dst, size_t n) noexcept
+        {
+            size_t i = 0;
+
+#if WOGL_PIXEL_CONVERSION_X86
+            switch (simdLevel()) {
+                case SimdLevel::AVX512:
+                    i = _floatToHalfAVX512(src, dst, n);
+                    break;
+                case SimdLevel::AVX2:
+                    i = _floatToHalfAVX2(src, dst, n);
+                    break;
+                default:
+                    break;
+            }
+#endif
+
+            for (; i < n; i++) {
+                dst[i] = floatToHalf(src[i]);
+            }
+        }
+
+        static void floatToHalf(const float* src, half* dst, size_t n) noexcept
+        {
+            floatToHalf(src, reinterpret_cast<uint16_t*>(dst), n);
+        }
+
+        /**
+         * Метод переводящий половинные числа в float.
+         *
+         * @param src исходные данные (биты половинных чисел)
+         * @param dst результат
+         * @param n количество элементов
+        */
+        static void halfToFloat(const uint16_t* src, float* dst, size_t n) noexcept
+        {
+            size_t i = 0;
+
+#if WOGL_PIXEL_CONVERSION_X86
+            switch (simdLevel()) {
+                case SimdLevel::AVX512:
+                    i = _halfToFloatAVX512(src, dst, n);
+                    break;
+                case SimdLevel::AVX2:
+                    i = _halfToFloatAVX2(src, dst, n);
+                    break;
+                default:
+                    break;
+            }
+#endif
+
+            for (; i < n; i++) {
+                dst[i] = halfToFloat(src[i]);
+            }
+        }
+
+        static void halfToFloat(const half* src, float* dst, size_t n) noexcept
+        {
+            halfToFloat(reinterpret_cast<const uint16_t*>(src), dst, n);
+        }
+
+        /**
+         * Метод переводящий 8-битные sRGB значения в нормализованные линейные значения (через таблицу).
+         * Если у текселя 4 канала, то альфа-канал только нормализуется.
+         *
+         * @param src исходные данные
+         * @param dst результат
+         * @param n количество элементов
+         * @param channels количество каналов в текселе
+        */
+        static void srgbToLinear(const uint8_t* src, float* dst, size_t n, size_t channels) noexcept
+        {
+            const float* table = _srgbToLinearTable();
+            size_t i = 0;
+
+#if WOGL_PIXEL_CONVERSION_X86
+            switch (simdLevel()) {
+                case SimdLevel::AVX512:
+                    i = _srgbToLinearAVX512(src, dst, n, channels == 4, table);
+                    break;
+                case SimdLevel::AVX2:
+                    i = _srgbToLinearAVX2(src, dst, n, channels == 4, table);
+                    break;
+                default:
+                    break;
+            }
+#endif
+
+            for (; i < n; i++) {
+                dst[i] = channels == 4 && (i & 3) == 3 ? static_cast<float>(src[i]) * (1.0f / 255.0f) : table[src[i]];
+            }
+        }
+
+        /**
+         * Метод переводящий нормализованные линейные значения в 8-битные sRGB значения (через таблицу).
+         * Если у текселя 4 канала, то альфа-канал только переводится в [0, 255].
+         *
+         * @param src исходные данные
+         * @param dst результат
+         * @param n количество элементов
+         * @param channels количество каналов в текселе
+        */
+        static void linearToSRGB(const float* src, uint8_t* dst, size_t n, size_t channels) noexcept
+        {
+            const uint8_t* table = _linearToSRGBTable();
+            size_t i = 0;
+
+#if WOGL_PIXEL_CONVERSION_X86
+            switch (simdLevel()) {
+                case SimdLevel::AVX512:
+                    i = _linearToSRGBAVX512(src, dst, n, channels == 4, table);
+                    break;
+                case SimdLevel::AVX2:
+                    i = _linearToSRGBAVX2(src, dst, n, channels == 4, table);
+                    break;
+                default:
+                    break;
+            }
+#endif
+
+            for (; i < n; i++) {
+                dst[i] = channels == 4 && (i & 3) == 3 ? _toUnorm(src[i] * 255.0f) : table[_linearToSRGBIndex(src[i])];
+            }
+        }
+
+        /**
+         * Метод дополняющий RGB тексели альфа-каналом.
+         *
+         * @param src исходные данные (pixels * 3 элементов)
+         * @param dst результат (pixels * 4 элементов)
+         * @param pixels количество текселей
+         * @param alpha значение альфа-канала
+        */
+        static void expandRGBToRGBA(const uint8_t* src, uint8_t* dst, size_t pixels, uint8_t alpha = numeric_limits<uint8_t>::max()) noexcept
+        {
+            size_t i = 0;
+
+#if WOGL_PIXEL_CONVERSION_X86
+            switch (simdLevel()) {
+                case SimdLevel::AVX512:
+                case SimdLevel::AVX2:
+                    i = _expandRGBToRGBAAVX2(src, dst, pixels, alpha);
+                    break;
+                case SimdLevel::SSE4:
+                    i = _expandRGBToRGBASSE4(src, dst, pixels, alpha);
+                    break;
+                default:
+                    break;
+            }
+#endif
+
+            _expandRGBToRGBA(src, dst, i, pixels, alpha);
+        }
+
+        /**
+         * Метод дополняющий RGB тексели альфа-каналом.
+         *
+         * @template T тип каналов
+         * @param src исходные данные (pixels * 3 элементов)
+         * @param dst результат (pixels * 4 элементов)
+         * @param pixels количество текселей
+         * @param alpha значение альфа-канала
+        */
+        template<typename T>
+        static void expandRGBToRGBA(const T* src, T* dst, size_t pixels, T alpha) noexcept
+        {
+            _expandRGBToRGBA(src, dst, 0, pixels, alpha);
+        }
+
+        /**
+         * Метод переставляющий каналы текселей: dst[c] = src[order[c]].
+         * Для 8-битных текселей с 4 каналами используется векторный вариант. Допускается src == dst.
+         *
+         * @template T тип каналов
+         * @param src исходные данные
+         * @param dst результат
+         * @param pixels количество текселей
+         * @param channels количество каналов в текселе
+         * @param order номера исходных каналов (используются первые channels значений)
+        */
+        template<typename T>
+        static void swizzle(const T* src, T* dst, size_t pixels, size_t channels, const array<uint8_t, 4>& order) noexcept
+        {
+            size_t i = 0;
+
+#if WOGL_PIXEL_CONVERSION_X86
+            if constexpr (is_same_v<T, uint8_t>) {
+                if (channels == 4) {
+                    switch (simdLevel()) {
+                        case SimdLevel::AVX512:
+                        case SimdLevel::AVX2:
+                            i = _swizzleAVX2(src, dst, pixels, order);
+                            break;
+                        case SimdLevel::SSE4:
+                            i = _swizzleSSE4(src, dst, pixels, order);
+                            break;
+                        default:
+                            break;
+                    }
+                }
+            }
+#endif
+
+            array<T, 4> texel;
+
+            for (; i < pixels; i++) {
+                for (size_t c{0}; c < channels; c++) {
+                    texel[c] = src[i * channels + order[c]];
+                }
+
+                for (size_t c{0}; c < channels; c++) {
+                    dst[i * channels + c] = texel[c];
+                }
+            }
+        }
+
+        /**
+         * Метод переводящий n элементов типа Src в тип Dst.
+         * Целочисленные значения нормализуются при переводе в вещественные и наоборот.
+         * Если sRGB равен true, то цветовые каналы дополнительно переводятся между sRGB и линейным пространством.
+         *
+         * @template Src исходный тип
+         * @template Dst тип результата
+         * @param src исходные данные
+         * @param dst результат
+         * @param n количество элементов
+         * @param channels количество каналов в текселе
+         * @param sRGB true - если целочисленные данные хранятся в пространстве sRGB
+        */
+        template<typename Src, typename Dst>
+        static void convert(const Src* src, Dst* dst, size_t n, size_t channels, bool sRGB = false) noexcept
+        {
+            if constexpr (is_same_v<Src, Dst>) {
+                copy(src, src + n, dst);
+            } else if constexpr (is_same_v<Src, float> && is_same_v<Dst, half>) {
+                floatToHalf(src, dst, n);
+            } else if constexpr (is_same_v<Src, half> && is_same_v<Dst, float>) {
+                halfToFloat(src, dst, n);
+            } else if constexpr (is_same_v<Src, uint8_t> && is_same_v<Dst, half>) {
+                if (sRGB) {
+                    _convertThroughFloat(src, dst, n, channels, sRGB);
+                } else {
+                    unormToHalf(src, reinterpret_cast<uint16_t*>(dst), n);
+                }
+            } else if constexpr (is_same_v<Src, half> || is_same_v<Dst, half>) {
+                _convertThroughFloat(src, dst, n, channels, sRGB);
+            } else if constexpr (is_same_v<Src, uint8_t> && is_same_v<Dst, float>) {
+                if (sRGB) {
+                    srgbToLinear(src, dst, n, channels);
+                } else {
+                    unormToFloat(src, dst, n);
+                }
+            } else if constexpr (is_same_v<Src, float> && is_same_v<Dst, uint8_t>) {
+                if (sRGB) {
+                    linearToSRGB(src, dst, n, channels);
+                } else {
+                    floatToUnorm(src, dst, n);
+                }
+            } else if constexpr (is_integral_v<Src> && is_floating_point_v<Dst>) {
+                const size_t colorChannels = min<size_t>(channels, 3);
+
+                for (size_t i{0}; i < n; i++) {
+                    const float value = static_cast<float>(src[i]) / static_cast<float>(numeric_limits<Src>::max());
+                    dst[i] = static_cast<Dst>(sRGB && (i % channels) < colorChannels ? srgbToLinear(value) : value);
+                }
+            } else if constexpr (is_floating_point_v<Src> && is_integral_v<Dst>) {
+                const size_t colorChannels = min<size_t>(channels, 3);
+                const float maxValue = static_cast<float>(numeric_limits<Dst>::max());
+                const float minValue = static_cast<float>(numeric_limits<Dst>::lowest());
+
+                for (size_t i{0}; i < n; i++) {
+                    float value = static_cast<float>(src[i]);
+                    value = sRGB && (i % channels) < colorChannels ? linearToSRGB(value) : value;
+                    dst[i] = static_cast<Dst>(min(max(roundf(value * maxValue), minValue), maxValue));
+                }
+            } else {
+                for (size_t i{0}; i < n; i++) {
+                    dst[i] = static_cast<Dst>(src[i]);
+                }
+            }
+        }
+
+        static float srgbToLinear(float x) noexcept
+        {
+            return x <= 0.04045f ? x * (1.0f / 12.92f) : powf((x + 0.055f) * (1.0f / 1.055f), 2.4f);
+        }
+
+        static float linearToSRGB(float x) noexcept
+        {
+            x = min(max(x, 0.0f), 1.0f);
+            return x <= 0.0031308f ? x * 12.92f : 1.055f * powf(x, 1.0f / 2.4f) - 0.055f;
+        }
+
+        /**
+         * Метод переводящий float в половинное число с округлением к ближайшему чётному.
+         *
+         * @param value число
+         * @return биты половинного числа
+        */
+        static uint16_t floatToHalf(float value) noexcept
+        {
+            return half(value).bits();
+        }
+
+        /**
+         * Метод переводящий половинное число в float.
+         *
+         * @param value биты половинного числа
+         * @return число
+        */
+        static float halfToFloat(uint16_t value) noexcept
+        {
+            return half::fromBits(value);
+        }
+
+    private:
+        /**
+         * Таблица перевода линейных значений в sRGB индексируется старшими битами float:
+         * 13 октав [2^-13, 1) по 2^11 интервалов в каждой. Значения меньше 2^-13 переводятся в 0.
+        */
+        static constexpr uint32_t LINEAR_TO_SRGB_MIN_BITS = (127 - 13) << 23;
+        static constexpr uint32_t LINEAR_TO_SRGB_MAX_BITS = 0x3f7fffffu;
+        static constexpr uint32_t LINEAR_TO_SRGB_SHIFT = 12;
+        static constexpr size_t LINEAR_TO_SRGB_TABLE_SIZE = ((LINEAR_TO_SRGB_MAX_BITS - LINEAR_TO_SRGB_MIN_BITS) >> LINEAR_TO_SRGB_SHIFT) + 1;
+
+        static SimdLevel& _level() noexcept
+        {
+            static SimdLevel level = _detect();
+            return level;
+        }
+
+        static SimdLevel _detect() noexcept
+        {
+#if WOGL_PIXEL_CONVERSION_X86
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+                return SimdLevel::AVX512;
+            } else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c")) {
+                return SimdLevel::AVX2;
+            } else if (__builtin_cpu_supports("sse4.1")) {
+                return SimdLevel::SSE4;
+            }
+#endif
+
+            return SimdLevel::SCALAR;
+        }
+
+        static uint8_t _toUnorm(float value) noexcept
+        {
+            return static_cast<uint8_t>(min(max(value, 0.0f), 255.0f) + 0.5f);
+        }
+
+        static const float* _srgbToLinearTable() noexcept
+        {
+            static const auto table = [] {
+                array<float, 256> table;
+
+                for (size_t i{0}; i < table.size(); i++) {
+                    table[i] = srgbToLinear(static_cast<float>(i) / 255.0f);
+                }
+
+                return table;
+            }();
+
+            return table.data();
+        }
+
+        /**
+         * Таблица дополнена 3 байтами, так как векторные варианты читают её по 4 байта.
+        */
+        static const uint8_t* _linearToSRGBTable() noexcept
+        {
+            static const auto table = [] {
+                array<uint8_t, LINEAR_TO_SRGB_TABLE_SIZE + 3> table {};
+
+                for (size_t i{0}; i < LINEAR_TO_SRGB_TABLE_SIZE; i++) {
+                    const uint32_t bits = LINEAR_TO_SRGB_MIN_BITS + (static_cast<uint32_t>(i) << LINEAR_TO_SRGB_SHIFT) + (1u << (LINEAR_TO_SRGB_SHIFT - 1));
+                    float value;
+                    memcpy(&value, &bits, sizeof(value));
+                    table[i] = _toUnorm(linearToSRGB(value) * 255.0f);
+                }
+
+                return table;
+            }();
+
+            return table.data();
+        }
+
+        static size_t _linearToSRGBIndex(float value) noexcept
+        {
+            float minValue, maxValue;
+            memcpy(&minValue, &LINEAR_TO_SRGB_MIN_BITS, sizeof(minValue));
+            memcpy(&maxValue, &LINEAR_TO_SRGB_MAX_BITS, sizeof(maxValue));
+
+            value = !(value > minValue) ? minValue : min(value, maxValue);
+
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+
+            return (bits - LINEAR_TO_SRGB_MIN_BITS) >> LINEAR_TO_SRGB_SHIFT;
+        }
+
+        /**
+         * Метод переводящий данные в тип Dst через промежуточный буфер float (используется для half).
+         * Размер буфера кратен 1, 2, 3 и 4, поэтому каналы текселей не смещаются между частями.
+        */
+        template<typename Src, typename Dst>
+        static void _convertThroughFloat(const Src* src, Dst* dst, size_t n, size_t channels, bool sRGB) noexcept
+        {
+            constexpr size_t bufferSize = 768;
+            array<float, bufferSize> buffer;
+
+            for (size_t i{0}; i < n; i += bufferSize) {
+                const size_t size = min(bufferSize, n - i);
+
+                convert(src + i, buffer.data(), size, channels, sRGB);
+                convert(buffer.data(), dst + i, size, channels, sRGB);
+            }
+        }
+
+        template<typename T>
+        static void _expandRGBToRGBA(const T* src, T* dst, size_t begin, size_t end, T alpha) noexcept
+        {
+            for (size_t i = begin; i < end; i++) {
+                dst[i * 4] = src[i * 3];
+                dst[i * 4 + 1] = src[i * 3 + 1];
+                dst[i * 4 + 2] = src[i * 3 + 2];
+                dst[i * 4 + 3] = alpha;
+            }
+        }
+
+#if WOGL_PIXEL_CONVERSION_X86
+        WOGL_TARGET("sse4.1")
+        static size_t _unormToFloatSSE4(const uint8_t* src, float* dst, size_t n, float scale) noexcept
+        {
+            const __m128 s = _mm_set1_ps(scale);
+            size_t i = 0;
+
+            for (; i + 16 <= n; i += 16) {
+                const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+                _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(bytes)), s));
+                _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(bytes, 4))), s));
+                _mm_storeu_ps(dst + i + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(bytes, 8))), s));
+                _mm_storeu_ps(dst + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(bytes, 12))), s));
+            }
+
+            return i;
+        }
+
+        WOGL_TARGET("avx2,fma")
+        static size_t _unormToFloatAVX2(const uint8_t* src, float* dst, size_t n, float scale) noexcept
+        {
+            const __m256 s = _mm256_set1_ps(scale);
+            size_t i = 0;
+
+            for (; i + 16 <= n; i += 16) {
+                const __m256i a = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)));
+                const __m256i b = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i + 8)));
+
+                _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(a), s));
+                _mm256_storeu_ps(dst + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(b), s));
+            }
+
+            return i;
+        }
+
+        WOGL_TARGET("avx512f,avx512bw")
+        static size_t _unormToFloatAVX512(const uint8_t* src, float* dst, size_t n, float scale) noexcept
+        {
+            const __m512 s = _mm512_set1_ps(scale);
+            size_t i = 0;
+
+            for (; i + 32 <= n; i += 32) {
+                const __m512i a = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+                const __m512i b = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16)));
+
+                _mm512_storeu_ps(dst + i, _mm512_mul_ps(_mm512_cvtepi32_ps(a), s));
+                _mm512_storeu_ps(dst + i + 16, _mm512_mul_ps(_mm512_cvtepi32_ps(b), s));
+            }
+
+            return i;
+        }
+
+        WOGL_TARGET("sse4.1")
+        static __m128i _toUnormSSE4(__m128 value) noexcept
+        {
+            value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+            return _mm_cvttps_epi32(_mm_add_ps(value, _mm_set1_ps(0.5f)));
+        }
+
+        WOGL_TARGET("sse4.1")
+        static size_t _floatToUnormSSE4(const float* src, uint8_t* dst, size_t n, float scale) noexcept
+        {
+            const __m128 s = _mm_set1_ps(scale);
+            size_t i = 0;
+
+            for (; i + 16 <= n; i += 16) {
+                const __m128i a = _toUnormSSE4(_mm_mul_ps(_mm_loadu_ps(src + i), s));
+                const __m128i b = _toUnormSSE4(_mm_mul_ps(_mm_loadu_ps(src + i + 4), s));
+                const __m128i c = _toUnormSSE4(_mm_mul_ps(_mm_loadu_ps(src + i + 8), s));
+                const __m128i d = _toUnormSSE4(_mm_mul_ps(_mm_loadu_ps(src + i + 12), s));
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(_mm_packus_epi32(a, b), _mm_packus_epi32(c, d)));
+            }
+
+            return i;
+        }
+
+        WOGL_TARGET("avx2,fma")
+        static __m256i _toUnormAVX2(__m256 value) noexcept
+        {
+            value = _mm256_min_ps(_mm256_max_ps(value, _mm256_setzero_ps()), _mm256_set1_ps(255.0f));
+            return _mm256_cvttps_epi32(_mm256_add_ps(value, _mm256_set1_ps(0.5f)));
+        }
+
+        /**
+         * Метод упаковывающий 16 значений int32 из [0, 255] в байты.
+        */
+        WOGL_TARGET("avx2,fma")
+        static __m128i _packBytesAVX2(__m256i a, __m256i b) noexcept
+        {
+            const __m256i words = _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), 0xd8);
+            return _mm_packus_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1));
+        }
+
+        WOGL_TARGET("avx2,fma")
+        static size_t _floatToUnormAVX2(const float* src, uint8_t* dst, size_t n, float scale) noexcept
+        {
+            const __m256 s = _mm256_set1_ps(scale);
+            size_t i = 0;
+
+            for (; i + 16 <= n; i += 16) {
+                const __m256i a = _toUnormAVX2(_mm256_mul_ps(_mm256_loadu_ps(src + i), s));
+                const __m256i b = _toUnormAVX2(_mm256_mul_ps(_mm256_loadu_ps(src + i + 8), s));
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _packBytesAVX2(a, b));
+            }
+
+            return i;
+        }
+
+        WOGL_TARGET("avx512f,avx512bw")
+        static size_t _floatToUnormAVX512(const float* src, uint8_t* dst, size_t n, float scale) noexcept
+        {
+            const __m512 s = _mm512_set1_ps(scale);
+            const __m512 half = _mm512_set1_ps(0.5f);
+            const __m512 maxValue = _mm512_set1_ps(255.0f);
+            size_t i = 0;
+
+            for (; i + 16 <= n; i += 16) {
+                __m512 value = _mm512_mul_ps(_mm512_loadu_ps(src + i), s);
+                value = _mm512_min_ps(_mm512_max_ps(value, _mm512_setzero_ps()), maxValue);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm512_cvtusepi32_epi8(_mm512_cvttps_epi32(_mm512_add_ps(value, half))));
+            }
+
+            return i;
+        }
+
+        WOGL_TARGET("avx2,fma,f16c")
+        static size_t _unormToHalfAVX2(const uint8_t* src, uint16_t* dst, size_t n) noexcept
+        {
+            const __m256 s = _mm256_set1_ps(1.0f / 255.0f);
+            size_t i = 0;
+
+            for (; i + 8 <= n; i += 8) {
+                const __m256 value = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)))), s);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT));
+            }
+
+            return i;
+        }
+
+        WOGL_TARGET("avx512f,avx512bw")
+        static size_t _unormToHalfAVX512(const uint8_t* src, uint16_t* dst, size_t n) noexcept
+        {
+            const __m512 s = _mm512_set1_ps(1.0f / 255.0f);
+            size_t i = 0;
+
+            for (; i + 16 <= n; i += 16) {
+                const __m512 value = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)))), s);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm512_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT));
+            }
+
+            return i;
+        }
+
+        WOGL_TARGET("avx2,fma,f16c")
+        static size_t _floatToHalfAVX2(const float* src, uint16_t* dst, size_t n) noexcept
+        {
+            size_t i = 0;
+
+            for (; i + 8 <= n; i += 8) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+            }
+
+            return i;
+        }
+
+        WOGL_TARGET("avx512f,avx512bw")
+        static size_t _floatToHalfAVX512(const float* src, uint16_t* dst, size_t n) noexcept
+        {
+            size_t i = 0;
+
+            for (; i + 16 <= n; i += 16) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm512_cvtps_ph(_mm512_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+            }
+
+            return i;
+        }
+
+        WOGL_TARGET("avx2,fma,f16c")
+        static size_t _halfToFloatAVX2(const uint16_t* src, float* dst, size_t n) noexcept
+        {
+            size_t i = 0;
+
+            for (; i + 8 <= n; i += 8) {
+                _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+            }
+
+            return i;
+        }
+
+        WOGL_TARGET("avx512f,avx512bw")
+        static size_t _halfToFloatAVX512(const uint16_t* src, float* dst, size_t n) noexcept
+        {
+            size_t i = 0;
+
+            for (; i + 16 <= n; i += 16) {
+                _mm512_storeu_ps(dst + i, _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i))));
+            }
+
+            return i;
+        }
+
+        WOGL_TARGET("avx2,fma")
+        static size_t _srgbToLinearAVX2(const uint8_t* src, float* dst, size_t n, bool alpha, const float* table) noexcept
+        {
+            const __m256 s = _mm256_set1_ps(1.0f / 255.0f);
+            size_t i = 0;
+
+            for (; i + 8 <= n; i += 8) {
+                const __m256i index = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)));
+                __m256 value = _mm256_i32gather_ps(table, index, 4);
+
+                if (alpha) {
+                    value = _mm256_blend_ps(value, _mm256_mul_ps(_mm256_cvtepi32_ps(index), s), 0x88);
+                }
+
+                _mm256_storeu_ps(dst + i, value);
+            }
+
+            return i;
+        }
+
+        WOGL_TARGET("avx512f,avx512bw")
+        static size_t _srgbToLinearAVX512(const uint8_t* src, float* dst, size_t n, bool alpha, const float* table) noexcept
+        {
+            const __m512 s = _mm512_set1_ps(1.0f / 255.0f);
+            size_t i = 0;
+
+            for (; i + 16 <= n; i += 16) {
+                const __m512i index = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+                __m512 value = _mm512_i32gather_ps(index, table, 4);
+
+                if (alpha) {
+                    value = _mm512_mask_blend_ps(0x8888, value, _mm512_mul_ps(_mm512_cvtepi32_ps(index), s));
+                }
+
+                _mm512_storeu_ps(dst + i, value);
+            }
+
+            return i;
+        }
+
+        WOGL_TARGET("avx2,fma")
+        static __m256i _linearToSRGBAVX2(__m256 value, bool alpha, const uint8_t* table) noexcept
+        {
+            const __m256 minValue = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int32_t>(LINEAR_TO_SRGB_MIN_BITS)));
+            const __m256 maxValue = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int32_t>(LINEAR_TO_SRGB_MAX_BITS)));
+
+            const __m256 clamped = _mm256_min_ps(_mm256_max_ps(value, minValue), maxValue);
+            const __m256i index = _mm256_srli_epi32(_mm256_sub_epi32(_mm256_castps_si256(clamped), _mm256_castps_si256(minValue)), LINEAR_TO_SRGB_SHIFT);
+            __m256i result = _mm256_and_si256(_mm256_i32gather_epi32(reinterpret_cast<const int*>(table), index, 1), _mm256_set1_epi32(0xff));
+
+            if (alpha) {
+                result = _mm256_blend_epi32(result, _toUnormAVX2(_mm256_mul_ps(value, _mm256_set1_ps(255.0f))), 0x88);
+            }
+
+            return result;
+        }
+
+        WOGL_TARGET("avx2,fma")
+        static size_t _linearToSRGBAVX2(const float* src, uint8_t* dst, size_t n, bool alpha, const uint8_t* table) noexcept
+        {
+            size_t i = 0;
+
+            for (; i + 16 <= n; i += 16) {
+                const __m256i a = _linearToSRGBAVX2(_mm256_loadu_ps(src + i), alpha, table);
+                const __m256i b = _linearToSRGBAVX2(_mm256_loadu_ps(src + i + 8), alpha, table);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _packBytesAVX2(a, b));
+            }
+
+            return i;
+        }
+
+        WOGL_TARGET("avx512f,avx512bw")
+        static size_t _linearToSRGBAVX512(const float* src, uint8_t* dst, size_t n, bool alpha, const uint8_t* table) noexcept
+        {
+            const __m512 minValue = _mm512_castsi512_ps(_mm512_set1_epi32(static_cast<int32_t>(LINEAR_TO_SRGB_MIN_BITS)));
+            const __m512 maxValue = _mm512_castsi512_ps(_mm512_set1_epi32(static_cast<int32_t>(LINEAR_TO_SRGB_MAX_BITS)));
+            const __m512 maxAlpha = _mm512_set1_ps(255.0f);
+            const __m512 half = _mm512_set1_ps(0.5f);
+            size_t i = 0;
+
+            for (; i + 16 <= n; i += 16) {
+                const __m512 value = _mm512_loadu_ps(src + i);
+                const __m512 clamped = _mm512_min_ps(_mm512_max_ps(value, minValue), maxValue);
+                const __m512i index = _mm512_srli_epi32(_mm512_sub_epi32(_mm512_castps_si512(clamped), _mm512_castps_si512(minValue)), LINEAR_TO_SRGB_SHIFT);
+                __m512i result = _mm512_and_si512(_mm512_i32gather_epi32(index, table, 1), _mm512_set1_epi32(0xff));
+
+                if (alpha) {
+                    const __m512 a = _mm512_min_ps(_mm512_max_ps(_mm512_mul_ps(value, maxAlpha), _mm512_setzero_ps()), maxAlpha);
+                    result = _mm512_mask_blend_epi32(0x8888, result, _mm512_cvttps_epi32(_mm512_add_ps(a, half)));
+                }
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm512_cvtusepi32_epi8(result));
+            }
+
+            return i;
+        }
+
+        WOGL_TARGET("sse4.1")
+        static size_t _expandRGBToRGBASSE4(const uint8_t* src, uint8_t* dst, size_t pixels, uint8_t alpha) noexcept
+        {
+            const __m128i mask = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+            const __m128i a = _mm_set1_epi32(static_cast<int32_t>(static_cast<uint32_t>(alpha) << 24));
+            size_t i = 0;
+
+            // Читается 16 байт, а используется 12, поэтому последние тексели обрабатываются скалярно.
+            for (; i + 6 <= pixels; i += 4) {
+                const __m128i rgb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_or_si128(_mm_shuffle_epi8(rgb, mask), a));
+            }
+
+            return i;
+        }
+
+        WOGL_TARGET("avx2,fma")
+        static size_t _expandRGBToRGBAAVX2(const uint8_t* src, uint8_t* dst, size_t pixels, uint8_t alpha) noexcept
+        {
+            const __m256i mask = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                                                  0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+            const __m256i a = _mm256_set1_epi32(static_cast<int32_t>(static_cast<uint32_t>(alpha) << 24));
+            size_t i = 0;
+
+            for (; i + 10 <= pixels; i += 8) {
+                const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3));
+                const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3 + 12));
+                const __m256i rgb = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_or_si256(_mm256_shuffle_epi8(rgb, mask), a));
+            }
+
+            return i;
+        }
+
+        static array<int8_t, 16> _swizzleMask(const array<uint8_t, 4>& order) noexcept
+        {
+            array<int8_t, 16> mask;
+
+            for (size_t i{0}; i < mask.size(); i++) {
+                mask[i] = static_cast<int8_t>((i & ~size_t{3}) + (order[i & 3] & 3));
+            }
+
+            return mask;
+        }
+
+        WOGL_TARGET("sse4.1")
+        static size_t _swizzleSSE4(const uint8_t* src, uint8_t* dst, size_t pixels, const array<uint8_t, 4>& order) noexcept
+        {
+            const auto m = _swizzleMask(order);
+            const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m.data()));
+            size_t i = 0;
+
+            for (; i + 4 <= pixels; i += 4) {
+                const __m128i texels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_shuffle_epi8(texels, mask));
+            }
+
+            return i;
+        }
+
+        WOGL_TARGET("avx2,fma")
+        static size_t _swizzleAVX2(const uint8_t* src, uint8_t* dst, size_t pixels, const array<uint8_t, 4>& order) noexcept
+        {
+            const auto m = _swizzleMask(order);
+            const __m256i mask = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(m.data())));
+            size_t i = 0;
+
+            for (; i + 8 <= pixels; i += 8) {
+                const __m256i texels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_shuffle_epi8(texels, mask));
+            }
+
+            return i;
+        }
+#endif
+    };
+}
@@ -0,0 +1,14 @@
+//
+//  TexelSampler.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef TexelSampler_hpp
+#define TexelSampler_hpp
+
+#include "TexelSampler.inl"
+
+#endif /* TexelSampler_hpp */
@@ -0,0 +1,455 @@
+//
+//  TexelSampler.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <glm/glm.hpp>
+
+#include "Texture.hpp"
+#include "Texture2D.hpp"
+#include "Texture3D.hpp"
+#include "../Core/ThreadPool.hpp"
+#include "../Render/Texture/TextureMappingSetting.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#   include <immintrin.h>
+#endif
+
+using namespace std;
+using namespace glm;
+
+namespace WOGL
+{
+    /**
+     * Описание выборки из текстуры на процессоре. Значения по умолчанию совпадают со значениями по умолчанию в OpenGL.
+     *
+     * @field filter способ фильтрации (LINEAR или NEAREST)
+     * @field wrappingS, wrappingT, wrappingR способы оптекания текстуры по осям S, T и R
+     * @field borderColor цвет границы (для CLAMP_TO_BORDER)
+    */
+    struct TexelSamplerDescription
+    {
+        TextureFilter filter = TextureFilter::LINEAR;
+        TextureWrapping wrappingS = TextureWrapping::REPEAT;
+        TextureWrapping wrappingT = TextureWrapping::REPEAT;
+        TextureWrapping wrappingR = TextureWrapping::REPEAT;
+        vec4 borderColor = vec4(0.0f);
+    };
+
+    /**
+     * Выборка из Texture2D (билинейная) и Texture3D (трилинейная) на процессоре по правилам OpenGL:
+     * центр текселя находится в (i + 0.5) / size, способы оптекания совпадают с TextureWrapping.
+     *
+     * Выборка выполняется пакетами: адреса и веса считаются сразу для четырёх координат на SSE2,
+     * тексели собираются по адресам и смешиваются по каналам тоже для четырёх координат.
+     * Без SSE2 используется скалярный код с тем же результатом.
+     *
+     * Результат - vec4 в единицах каналов текстуры (без нормализации, для uint8_t от 0 до 255).
+     * Отсутствующие каналы заполняются как в OpenGL: (r, 0, 0, 1), (r, g, 0, 1), (r, g, b, 1).
+     * Объект не изменяется после создания, поэтому его можно использовать из нескольких потоков.
+    */
+    class TexelSampler
+    {
+    public:
+        /**
+         * Конструктор.
+         *
+         * @param description описание выборки
+         * @throw invalid_argument в случае если задан фильтр с mipmap'ом
+        */
+        explicit TexelSampler(const TexelSamplerDescription& description = {}) :
+            _description{description}
+        {
+            if (description.filter != TextureFilter::LINEAR && description.filter != TextureFilter::NEAREST) {
+                throw invalid_argument("Only LINEAR and NEAREST filters are supported");
+            }
+        }
+
+        const TexelSamplerDescription& description() const noexcept
+        {
+            return _description;
+        }
+
+        /**
+         * Метод выполняющий выборку из текстуры по массиву координат.
+         *
+         * @param texture текстура
+         * @param uv текстурные координаты (u - по ширине, v - по строкам)
+         * @param out результаты (n элементов)
+         * @param n количество координат
+         * @throw invalid_argument в случае если текстура пустая
+        */
+        template<typename DataType, TexelType Tx>
+        void sample(const Texture2D<DataType, Tx>& texture, const vec2* uv, vec4* out, size_t n) const
+        {
+            _sample<2, numberOfChannels(Tx)>(texture._data.data(), {texture._width, texture._height, 1},
+                                             reinterpret_cast<const float*>(uv), out, n);
+        }
+
+        /**
+         * Метод выполняющий выборку из текстуры по массиву координат, распределяя координаты между потоками пула.
+        */
+        template<typename DataType, TexelType Tx>
+        void sample(const Texture2D<DataType, Tx>& texture, const vec2* uv, vec4* out, size_t n, ThreadPool& pool) const
+        {
+            pool.parallelFor(0, n, [this, &texture, uv, out] (size_t begin, size_t end) {
+                sample(texture, uv + begin, out + begin, end - begin);
+            }, GRAIN);
+        }
+
+        template<typename DataType, TexelType Tx>
+        vector<vec4> sample(const Texture2D<DataType, Tx>& texture, const vector<vec2>& uv) const
+        {
+            vector<vec4> out(uv.size());
+            sample(texture, uv.data(), out.data(), uv.size());
+
+            return out;
+        }
+
+        template<typename DataType, TexelType Tx>
+        vec4 sample(const Texture2D<DataType, Tx>& texture, vec2 uv) const
+        {
+            vec4 out;
+            sample(texture, &uv, &out, 1);
+
+            return out;
+        }
+
+        /**
+         * Метод выполняющий выборку из трёхмерной текстуры по массиву координат.
+         *
+         * @param texture текстура
+         * @param uvw текстурные координаты (u - по ширине, v - по высоте, w - по глубине)
+         * @param out результаты (n элементов)
+         * @param n количество координат
+         * @throw invalid_argument в случае если текстура пустая
+        */
+        template<typename DataType, TexelType Tx>
+        void sample(const Texture3D<DataType, Tx>& texture, const vec3* uvw, vec4* out, size_t n) const
+        {
+            _sample<3, numberOfChannels(Tx)>(texture._data.data(), {texture._width, texture._height, texture._depth},
+                                             reinterpret_cast<const float*>(uvw), out, n);
+        }
+
+        template<typename DataType, TexelType Tx>
+        void sample(const Texture3D<DataType, Tx>& texture, const vec3* uvw, vec4* out, size_t n, ThreadPool& pool) const
+        {
+            pool.parallelFor(0, n, [this, &texture, uvw, out] (size_t begin, size_t end) {
+                sample(texture, uvw + begin, out + begin, end - begin);
+            }, GRAIN);
+        }
+
+        template<typename DataType, TexelType Tx>
+        vector<vec4> sample(const Texture3D<DataType, Tx>& texture, const vector<vec3>& uvw) const
+        {
+            vector<vec4> out(uvw.size());
+            sample(texture, uvw.data(), out.data(), uvw.size());
+
+            return out;
+        }
+
+        template<typename DataType, TexelType Tx>
+        vec4 sample(const Texture3D<DataType, Tx>& texture, vec3 uvw) const
+        {
+            vec4 out;
+            sample(texture, &uvw, &out, 1);
+
+            return out;
+        }
+
+        /**
+         * Минимальное количество координат, передаваемое одному потоку пула.
+        */
+        static constexpr size_t GRAIN = 1024;
+
+    private:
+        static_assert(sizeof(vec2) == 2 * sizeof(float) && sizeof(vec3) == 3 * sizeof(float) && sizeof(vec4) == 4 * sizeof(float),
+                      "Texture coordinates must be tightly packed");
+
+        static constexpr float ONE_MINUS_EPSILON = 0.99999994f;
+
+        /**
+         * Адреса и веса выборки по одной оси для одной координаты.
+        */
+        struct _Axis
+        {
+            int32_t i0;
+            int32_t i1;
+            float t;
+            bool valid0;
+            bool valid1;
+        };
+
+        template<size_t Dimensions, size_t Channels, typename DataType>
+        void _sample(const DataType* data, const array<size_t, 3>& size, const float* coords, vec4* out, size_t n) const
+        {
+            static_assert(Channels >= 1 && Channels <= 4, "Unsupported texel type");
+
+            if (!size[0] || !size[1] || !size[2]) {
+                throw invalid_argument("Texture is empty");
+            }
+
+            constexpr size_t taps = size_t{1} << Dimensions;
+
+            const bool linear = _description.filter == TextureFilter::LINEAR;
+            const array<TextureWrapping, 3> wrapping {_description.wrappingS, _description.wrappingT, _description.wrappingR};
+            const array<int32_t, 3> dims {static_cast<int32_t>(size[0]), static_cast<int32_t>(size[1]), static_cast<int32_t>(size[2])};
+            const array<size_t, 3> strides {Channels, size[0] * Channels, size[0] * size[1] * Channels};
+
+            size_t k = 0;
+
+#if defined(__SSE2__) || defined(_M_X64)
+            for (; k + 4 <= n; k += 4) {
+                alignas(16) int32_t index[Dimensions][2][4];
+                __m128 t[Dimensions];
+                __m128 valid[Dimensions][2];
+
+                for (size_t d{0}; d < Dimensions; d++) {
+                    const __m128 u = _mm_setr_ps(coords[k * Dimensions + d], coords[(k + 1) * Dimensions + d],
+                                                 coords[(k + 2) * Dimensions + d], coords[(k + 3) * Dimensions + d]);
+                    __m128i i0, i1;
+
+                    _axis(u, dims[d], wrapping[d], linear, i0, i1, t[d], valid[d][0], valid[d][1]);
+
+                    _mm_store_si128(reinterpret_cast<__m128i*>(index[d][0]), i0);
+                    _mm_store_si128(reinterpret_cast<__m128i*>(index[d][1]), i1);
+                }
+
+                __m128 acc[Channels];
+
+                for (size_t c{0}; c < Channels; c++) {
+                    acc[c] = _mm_setzero_ps();
+                }
+
+                for (size_t tap{0}; tap < taps; tap++) {
+                    __m128 weight = _mm_set1_ps(1.0f);
+                    __m128 mask = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                    alignas(16) float texels[Channels][4];
+
+                    for (size_t d{0}; d < Dimensions; d++) {
+                        const size_t s = (tap >> d) & 1;
+
+                        weight = _mm_mul_ps(weight, s ? t[d] : _mm_sub_ps(_mm_set1_ps(1.0f), t[d]));
+                        mask = _mm_and_ps(mask, valid[d][s]);
+                    }
+
+                    for (size_t lane{0}; lane < 4; lane++) {
+                        size_t offset = 0;
+
+                        for (size_t d{0}; d < Dimensions; d++) {
+                            offset += static_cast<size_t>(index[d][(tap >> d) & 1][lane]) * strides[d];
+                        }
+
+                        for (size_t c{0}; c < Channels; c++) {
+                            texels[c][lane] = static_cast<float>(data[offset + c]);
+                        }
+                    }
+
+                    for (size_t c{0}; c < Channels; c++) {
+                        const __m128 texel = _mm_or_ps(_mm_and_ps(mask, _mm_load_ps(texels[c])),
+                                                       _mm_andnot_ps(mask, _mm_set1_ps(_description.borderColor[static_cast<int>(c)])));
+
+                        acc[c] = _mm_add_ps(acc[c], _mm_mul_ps(weight, texel));
+                    }
+                }
+
+                __m128 r = acc[0];
+                __m128 g = Channels > 1 ? acc[Channels > 1 ? 1 : 0] : _mm_setzero_ps();
+                __m128 b = Channels > 2 ? acc[Channels > 2 ? 2 : 0] : _mm_setzero_ps();
+                __m128 a = Channels > 3 ? acc[Channels > 3 ? 3 : 0] : _mm_set1_ps(1.0f);
+
+                _MM_TRANSPOSE4_PS(r, g, b, a);
+
+                float* dst = &out[k].x;
+
+                _mm_storeu_ps(dst, r);
+                _mm_storeu_ps(dst + 4, g);
+                _mm_storeu_ps(dst + 8, b);
+                _mm_storeu_ps(dst + 12, a);
+            }
+#endif
+
+            for (; k < n; k++) {
+                _Axis axis[Dimensions];
+
+                for (size_t d{0}; d < Dimensions; d++) {
+                    axis[d] = _axis(coords[k * Dimensions + d], dims[d], wrapping[d], linear);
+                }
+
+                vec4 result(0.0f, 0.0f, 0.0f, 1.0f);
+                float acc[Channels] = {};
+
+                for (size_t tap{0}; tap < taps; tap++) {
+                    float weight = 1.0f;
+                    bool valid = true;
+                    size_t offset = 0;
+
+                    for (size_t d{0}; d < Dimensions; d++) {
+                        const size_t s = (tap >> d) & 1;
+
+                        weight *= s ? axis[d].t : 1.0f - axis[d].t;
+                        valid = valid && (s ? axis[d].valid1 : axis[d].valid0);
+                        offset += static_cast<size_t>(s ? axis[d].i1 : axis[d].i0) * strides[d];
+                    }
+
+                    for (size_t c{0}; c < Channels; c++) {
+                        acc[c] += weight * (valid ? static_cast<float>(data[offset + c]) : _description.borderColor[static_cast<int>(c)]);
+                    }
+                }
+
+                for (size_t c{0}; c < Channels; c++) {
+                    result[static_cast<int>(c)] = acc[c];
+                }
+
+                out[k] = result;
+            }
+        }
+
+        /**
+         * Метод вычисляющий дробную часть. Результат меньше единицы и для малых отрицательных чисел
+         * (u - floor(u) округлилось бы до 1). Числа от 2^23 по модулю целые, их дробная часть равна нулю.
+        */
+        static float _fract(float u) noexcept
+        {
+            return fabs(u) < 8388608.0f ? min(u - floor(u), ONE_MINUS_EPSILON) : 0.0f;
+        }
+
+        /**
+         * Метод вычисляющий два соседних текселя по оси и вес второго из них.
+         * Для NEAREST оба адреса указывают на один тексель, а вес равен нулю.
+        */
+        static _Axis _axis(float u, int32_t size, TextureWrapping wrapping, bool linear) noexcept
+        {
+            const float n = static_cast<float>(size);
+
+            if (wrapping == TextureWrapping::REPEAT) {
+                u = _fract(u);
+            } else if (wrapping == TextureWrapping::MIRRORED_REPEAT) {
+                u = 2.0f * _fract(0.5f * u);
+                u = u > 1.0f ? 2.0f - u : u;
+            }
+
+            float x = u * n - (linear ? 0.5f : 0.0f);
+
+            // Сравнения записаны так, чтобы NaN превращался в -1.
+            x = x >= -1.0f ? x : -1.0f;
+            x = x <= n ? x : n;
+
+            const float f = floor(x);
+
+            _Axis axis {static_cast<int32_t>(f), static_cast<int32_t>(f) + 1, linear ? x - f : 0.0f, true, true};
+
+            switch (wrapping) {
+                case TextureWrapping::REPEAT:
+                    axis.i0 = axis.i0 < 0 ? axis.i0 + size : (axis.i0 >= size ? axis.i0 - size : axis.i0);
+                    axis.i1 = axis.i0 + 1 >= size ? axis.i0 + 1 - size : axis.i0 + 1;
+                    break;
+
+                case TextureWrapping::CLAMP_TO_BORDER:
+                    axis.valid0 = axis.i0 >= 0 && axis.i0 < size;
+                    axis.valid1 = axis.i1 >= 0 && axis.i1 < size;
+                    [[fallthrough]];
+
+                default:
+                    axis.i0 = min(max(axis.i0, 0), size - 1);
+                    axis.i1 = min(max(axis.i1, 0), size - 1);
+                    break;
+            }
+
+            return axis;
+        }
+
+#if defined(__SSE2__) || defined(_M_X64)
+        static __m128 _floor(__m128 x) noexcept
+        {
+            const __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+            return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, x), _mm_set1_ps(1.0f)));
+        }
+
+        static __m128 _fract(__m128 x) noexcept
+        {
+            const __m128 abs = _mm_andnot_ps(_mm_set1_ps(-0.0f), x);
+            const __m128 fract = _mm_min_ps(_mm_set1_ps(ONE_MINUS_EPSILON), _mm_sub_ps(x, _floor(x)));
+
+            return _mm_and_ps(_mm_cmplt_ps(abs, _mm_set1_ps(8388608.0f)), fract);
+        }
+
+        static __m128i _select(__m128i mask, __m128i a, __m128i b) noexcept
+        {
+            return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+        }
+
+        static __m128i _clamp(__m128i i, __m128i size) noexcept
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i last = _mm_sub_epi32(size, _mm_set1_epi32(1));
+
+            i = _select(_mm_cmplt_epi32(i, zero), zero, i);
+            return _select(_mm_cmpgt_epi32(i, last), last, i);
+        }
+
+        /**
+         * То же, что и скалярный _axis, для четырёх координат.
+        */
+        static void _axis(__m128 u, int32_t size, TextureWrapping wrapping, bool linear,
+                          __m128i& i0, __m128i& i1, __m128& t, __m128& valid0, __m128& valid1) noexcept
+        {
+            const __m128 n = _mm_set1_ps(static_cast<float>(size));
+            const __m128i sizes = _mm_set1_epi32(size);
+            const __m128i one = _mm_set1_epi32(1);
+
+            if (wrapping == TextureWrapping::REPEAT) {
+                u = _fract(u);
+            } else if (wrapping == TextureWrapping::MIRRORED_REPEAT) {
+                u = _mm_mul_ps(_mm_set1_ps(2.0f), _fract(_mm_mul_ps(_mm_set1_ps(0.5f), u)));
+                u = _mm_min_ps(u, _mm_sub_ps(_mm_set1_ps(2.0f), u));
+            }
+
+            __m128 x = _mm_sub_ps(_mm_mul_ps(u, n), _mm_set1_ps(linear ? 0.5f : 0.0f));
+
+            // При NaN _mm_max_ps возвращает второй операнд.
+            x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-1.0f)), n);
+
+            const __m128 f = _floor(x);
+
+            t = linear ? _mm_sub_ps(x, f) : _mm_setzero_ps();
+            i0 = _mm_cvttps_epi32(f);
+            i1 = _mm_add_epi32(i0, one);
+            valid0 = valid1 = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+            switch (wrapping) {
+                case TextureWrapping::REPEAT:
+                    i0 = _mm_add_epi32(i0, _mm_and_si128(_mm_cmplt_epi32(i0, _mm_setzero_si128()), sizes));
+                    i0 = _mm_sub_epi32(i0, _mm_and_si128(_mm_cmpgt_epi32(i0, _mm_sub_epi32(sizes, one)), sizes));
+                    i1 = _mm_add_epi32(i0, one);
+                    i1 = _mm_sub_epi32(i1, _mm_and_si128(_mm_cmpgt_epi32(i1, _mm_sub_epi32(sizes, one)), sizes));
+                    break;
+
+                case TextureWrapping::CLAMP_TO_BORDER:
+                    valid0 = _mm_castsi128_ps(_mm_andnot_si128(_mm_cmplt_epi32(i0, _mm_setzero_si128()), _mm_cmplt_epi32(i0, sizes)));
+                    valid1 = _mm_castsi128_ps(_mm_andnot_si128(_mm_cmplt_epi32(i1, _mm_setzero_si128()), _mm_cmplt_epi32(i1, sizes)));
+                    [[fallthrough]];
+
+                default:
+                    i0 = _clamp(i0, sizes);
+                    i1 = _clamp(i1, sizes);
+                    break;
+            }
+        }
+#endif
+
+        TexelSamplerDescription _description;
+    };
+}
@@ -11,6 +11,8 @@
 
 #include <GL/glew.h>
 
+#include <cstddef>
+
 namespace WOGL
 {
     enum class TexelType
@@ -28,6 +30,47 @@ namespace WOGL
         BLUE,
         ALPHA
     };
+
+    /**
+     * Функция возвращающая количество каналов в текселе.
+     *
+     * @param tx тип текселя
+     * @return количество каналов
+    */
+    constexpr size_t numberOfChannels(TexelType tx) noexcept
+    {
+        switch (tx) {
+            case TexelType::RED: return 1;
+            case TexelType::RG: return 2;
+            case TexelType::RGB: return 3;
+            case TexelType::RGBA: return 4;
+        }
+
+        return 0;
+    }
+
+    /**
+     * Функция возвращающая количество уровней полной mipmap-цепочки (до размера 1x1x1).
+     *
+     * @param width ширина
+     * @param height высота
+     * @param depth глубина
+     * @return количество уровней
+    */
+    constexpr size_t numberOfMipLevels(size_t width, size_t height = 1, size_t depth = 1) noexcept
+    {
+        size_t size = width > height ? width : height;
+        size = size > depth ? size : depth;
+
+        size_t levels = 1;
+
+        while (size > 1) {
+            size >>= 1;
+            levels++;
+        }
+
+        return levels;
+    }
 }
 
 #endif /* Texture_hpp */
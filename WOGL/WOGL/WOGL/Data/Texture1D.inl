@@ -8,6 +8,7 @@
 //
 
 #include "Texture.hpp"
+#include "Half.hpp"
 
 #include <vector>
 
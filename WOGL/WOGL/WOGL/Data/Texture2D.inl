@@ -9,12 +9,17 @@
 #include "../../../SOIL2/SOIL2.h"
 
 #include "Texture.hpp"
+#include "PixelConversion.hpp"
+#include "../Core/ThreadPool.hpp"
 
 #include "Conteiners/ArrayView.hpp"
-#include "Conteiners/MatrixView.hpp"
-#include "Conteiners/GearMatrixView.hpp"
+#include "Conteiners/StridedView.hpp"
 
 #include <vector>
+#include <array>
+#include <string>
+#include <future>
+#include <algorithm>
 
 using namespace std;
 
@@ -30,7 +35,25 @@ namespace WOGL
         using Data = vector<DataType>;
 
         friend class BaseTextureRenderer2D;
+        friend class BaseTextureRenderer2DArray;
         friend class InitializeCubeMapTextureRenderer;
+        friend class PixelReadback;
+        friend class BlockEncoder;
+        friend class WtexFile;
+        friend class HdrLoader;
+        friend class TexelSampler;
+
+        template<typename, TexelType>
+        friend class TextureAtlas;
+
+        template<typename, TexelType>
+        friend class MipChain2D;
+
+        template<typename, TexelType>
+        friend class Texture2D;
+
+        template<typename, TexelType>
+        friend class TextureCache;
 
     public:
         /**
@@ -89,7 +112,7 @@ namespace WOGL
         {
         }
 
-        Texture2D(Texture2D&& texture)  :
+        Texture2D(Texture2D&& texture) noexcept :
             _data{forward<Data>(texture._data)},
             _height{texture._height},
             _width{texture._width},
@@ -210,7 +233,7 @@ namespace WOGL
 
             for (size_t y{0}; y < subTexHeight; y++) {
                 ptr = &_data[(y + offY) * _width * _bpp + offX * _bpp];
-                copy(&subTex[y * subTexWidth * _bpp], &subTex[y * subTexWidth * _bpp + (subTexWidth - 1) * _bpp], ptr);
+                copy_n(&subTex[y * subTexWidth * _bpp], subTexWidth * _bpp, ptr);
             }
         }
 
@@ -233,14 +256,14 @@ namespace WOGL
 
             for (size_t y{0}; y < height; y++) {
                 ptr = &_data[(y + offY) * _width * _bpp + offX * _bpp];
-                copy(&data[y * width * _bpp], &data[y * width * _bpp + (width - 1) * _bpp], ptr);
+                copy_n(&data[y * width * _bpp], width * _bpp, ptr);
             }
         }
 
         template<Canal canal>
         DataType at(size_t i, size_t j) const
         {
-            auto* ptr = &_data._data.at((i * _width * _bpp) + (j * _bpp));
+            auto* ptr = &_data.at((i * _width * _bpp) + (j * _bpp));
 
             if (canal == Canal::GREEN && _bpp > 1) {
                 ptr++;
@@ -290,11 +313,11 @@ namespace WOGL
         {
             auto* ptr = &_data[(i * _width * _bpp) + (j * _bpp)];
 
-            if constexpr (canal == Canal::GREEN && _bpp > 1) {
+            if (canal == Canal::GREEN && _bpp > 1) {
                 ptr++;
-            } else if constexpr (canal == Canal::BLUE && _bpp > 2) {
+            } else if (canal == Canal::BLUE && _bpp > 2) {
                 ptr += 2;
-            } else if constexpr (canal == Canal::ALPHA && _bpp > 3) {
+            } else if (canal == Canal::ALPHA && _bpp > 3) {
                 ptr += 3;
             }
 
@@ -328,19 +351,77 @@ namespace WOGL
 
             Texture2D<DataType, Tx> tex (static_cast<size_t>(width), static_cast<size_t>(height));
             
-            if constexpr (is_same_v<DataType, float> || is_same_v<DataType, double>) {
-                for (size_t i{0}; i < tex._data.size(); i++) {
-                    tex._data[i] = static_cast<DataType>(imageData[i]) * 0.0039215;
-                }
-            } else {
-                copy(imageData, imageData + (width * height * tex._bpp), begin(tex._data));
-            }
+            PixelConversion::convert(imageData, &tex._data[0], tex._data.size(), tex._bpp);
 
-            delete [] imageData;
+            SOIL_free_image_data(imageData);
             
             return tex;
         }
 
+        /**
+         * Функция запускающая загрузку изображения в пуле потоков.
+         *
+         * @param path путь до изображения
+         * @param pool пул потоков, в котором декодируется изображение
+         * @return future<Texture2D> загруженная текстура (если не удалось загрузить изображение, то future хранит invalid_argument)
+        */
+        static auto loadTextureAsync(const string_view path, ThreadPool& pool = ThreadPool::global())
+        {
+            return pool.submit([path = string(path)] {
+                return loadTexture(path);
+            });
+        }
+
+        /**
+         * Метод возвращающий копию текстуры с другим типом каналов.
+         * Целочисленные значения нормализуются при переводе в вещественные и наоборот.
+         *
+         * @template NewDataType тип каналов новой текстуры
+         * @param sRGB true - если целочисленные данные хранятся в пространстве sRGB
+         * @return Texture2D<NewDataType, Tx> новая текстура
+        */
+        template<typename NewDataType>
+        auto convert(bool sRGB = false) const
+        {
+            Texture2D<NewDataType, Tx> tex (_width, _height);
+            PixelConversion::convert(_data.data(), tex._data.data(), _data.size(), _bpp, sRGB);
+
+            return tex;
+        }
+
+        /**
+         * Метод возвращающий копию RGB текстуры, дополненную альфа-каналом.
+         *
+         * @param alpha значение альфа-канала
+         * @return Texture2D<DataType, TexelType::RGBA> новая текстура
+        */
+        auto toRGBA(DataType alpha) const
+        {
+            static_assert(Tx == TexelType::RGB, "toRGBA is only available for RGB textures");
+
+            Texture2D<DataType, TexelType::RGBA> tex (_width, _height);
+            PixelConversion::expandRGBToRGBA(_data.data(), tex._data.data(), _width * _height, alpha);
+
+            return tex;
+        }
+
+        /**
+         * Метод переставляющий каналы текстуры.
+         * Например {Canal::BLUE, Canal::GREEN, Canal::RED, Canal::ALPHA} переводит BGRA в RGBA.
+         *
+         * @param order номера исходных каналов для каждого канала текстуры
+        */
+        void swizzle(const array<Canal, numberOfChannels(Tx)>& order) noexcept
+        {
+            array<uint8_t, 4> channels {0, 1, 2, 3};
+
+            for (size_t c{0}; c < order.size(); c++) {
+                channels[c] = static_cast<uint8_t>(order[c]);
+            }
+
+            PixelConversion::swizzle(_data.data(), _data.data(), _width * _height, _bpp, channels);
+        }
+
         /**
          * Метод возвращающий строку у текстуры.
          * 
@@ -373,53 +454,61 @@ namespace WOGL
         }
 
         /**
-         * Метод возвращающий значения текстуры в обёрте MatrixView,
+         * Метод возвращающий значения текстуры в обёрте StridedView2D,
          * которая позволяет работать с текстурой как с 2-мерным массивом.
          * 
-         * @return  MatrixView<DataType> обёртка над массивом данных текстуры
+         * @return StridedView2D<DataType> обёртка над массивом данных текстуры (ширина в каналах)
         */
         inline auto textureMatrix() 
         {
-            return MatrixView<DataType>{_data, _width * _bpp, _height};
+            return StridedView2D<DataType>{_data.data(), _width * _bpp, _height};
         }
 
         /**
-         * Метод возвращающий значения текстуры в обёрте MatrixView,
+         * Метод возвращающий значения текстуры в обёрте StridedView2D,
          * которая позволяет работать с текстурой как с 2-мерным массивом.
          * 
-         * @return const MatrixView<DataType> обёртка над массивом данных текстуры
+         * @return StridedView2D<const DataType> обёртка над массивом данных текстуры (ширина в каналах)
         */
-        inline const auto textureMatrix() const 
+        inline auto textureMatrix() const 
         {
-            return MatrixView<const DataType>{_data, _width * _bpp, _height};
+            return StridedView2D<const DataType>{_data.data(), _width * _bpp, _height};
         }
 
         /**
          * Метод позволяющий получить кусок текстуры от исходной текстуры.
+         * Обёртка хранит только указатель, размеры и шаг строки, поэтому её создание ничего не стоит.
+         * offsetX задаётся в текселях, как и width.
+         * Для смещения в каналах используйте textureMatrix().subView.
          *
          * @param offsetY смещение по строкам
-         * @param offsetX смещение по столбцам
-         * @param width ширина подтекстуры (так же ширина ещё зависит от Tx)
+         * @param offsetX смещение по столбцам в текселях
+         * @param width ширина подтекстуры в текселях
          * @param height высота подтекстуры 
-         * @return GearMatrixView<DataType> обёртка над подтекстурой
+         * @return StridedView2D<DataType> обёртка над подтекстурой (ширина в каналах)
+         * @throw out_of_range в случае если подтекстура выходит за пределы текстуры
         */
         inline auto subTexture(size_t offsetY, size_t offsetX, size_t width, size_t height)
         {
-            return GearMatrixView<DataType>{_data, _width * _bpp, _height, offsetY, offsetX, width * _bpp, height};
+            return textureMatrix().subView(offsetY, offsetX * _bpp, width * _bpp, height);
         }
 
         /**
          * Метод позволяющий получить кусок текстуры от исходной текстуры.
          *
+         * offsetX задаётся в текселях, как и width.
+         * Для смещения в каналах используйте textureMatrix().subView.
+         *
          * @param offsetY смещение по строкам
-         * @param offsetX смещение по столбцам
-         * @param width ширина подтекстуры (так же ширина ещё зависит от Tx)
+         * @param offsetX смещение по столбцам в текселях
+         * @param width ширина подтекстуры в текселях
          * @param height высота подтекстуры 
-         * @return const GearMatrixView<DataType> обёртка над подтекстурой
+         * @return StridedView2D<const DataType> обёртка над подтекстурой (ширина в каналах)
+         * @throw out_of_range в случае если подтекстура выходит за пределы текстуры
         */
-        inline const auto subTexture(size_t offsetY, size_t offsetX, size_t width, size_t height) const
+        inline auto subTexture(size_t offsetY, size_t offsetX, size_t width, size_t height) const
         {
-            return GearMatrixView<DataType>{_data, _width * _bpp, _height, offsetY, offsetX, width * _bpp, height};
+            return textureMatrix().subView(offsetY, offsetX * _bpp, width * _bpp, height);
         }
 
     private:
@@ -7,14 +7,14 @@
 //
 
 #include "Texture.hpp"
+#include "PixelConversion.hpp"
 
 #include <vector>
 
 #include <stdexcept>
 
 #include "Conteiners/ArrayView.hpp"
-#include "Conteiners/MatrixView.hpp"
-#include "Conteiners//GearMatrixView.hpp"
+#include "Conteiners/StridedView.hpp"
 
 using namespace std;
 
@@ -26,6 +26,13 @@ namespace WOGL
         using Data = vector<DataType>;
 
         friend class BaseTextureRenderer3D;
+        friend class TexelSampler;
+
+        template<typename, TexelType>
+        friend class MipChain3D;
+
+        template<typename, TexelType>
+        friend class Texture3D;
 
     public:
         /**
@@ -98,6 +105,21 @@ namespace WOGL
         {
         }
 
+        size_t width() const noexcept
+        {
+            return _width;
+        }
+
+        size_t height() const noexcept
+        {
+            return _height;
+        }
+
+        size_t depth() const noexcept
+        {
+            return _depth;
+        }
+
         /**
          * Метод предназначенный для обновления данных текстуры.
          * 
@@ -322,6 +344,23 @@ namespace WOGL
             return *ptr;
         }
 
+        /**
+         * Метод возвращающий копию текстуры с другим типом каналов.
+         * Целочисленные значения нормализуются при переводе в вещественные и наоборот.
+         *
+         * @template NewDataType тип каналов новой текстуры
+         * @param sRGB true - если целочисленные данные хранятся в пространстве sRGB
+         * @return Texture3D<NewDataType, Tx> новая текстура
+        */
+        template<typename NewDataType>
+        auto convert(bool sRGB = false) const
+        {
+            Texture3D<NewDataType, Tx> tex (_width, _height, _depth);
+            PixelConversion::convert(_data.data(), tex._data.data(), _data.size(), _bpp, sRGB);
+
+            return tex;
+        }
+
         /**
          * Метод возвращающий строку у текстуры.
          * 
@@ -331,7 +370,7 @@ namespace WOGL
         */
         inline auto line(size_t i, size_t j)
         {
-            if (i >= _depth || j >= _width) {
+            if (i >= _depth || j >= _height) {
                 throw out_of_range("Out of range");
             }
 
@@ -347,7 +386,7 @@ namespace WOGL
         */
         inline const auto line(size_t i, size_t j) const
         {
-            if (i >= _depth || j >= _width) {
+            if (i >= _depth || j >= _height) {
                 throw out_of_range("Out of range");
             }
 
@@ -355,57 +394,123 @@ namespace WOGL
         }
 
         /**
-         * Метод возвращающий значения двухмерной текстуры в обёрте MatrixView,
+         * Метод возвращающий значения текстуры в обёрте StridedView3D,
+         * которая позволяет работать с текстурой как с 3-мерным массивом.
+         *
+         * @return StridedView3D<DataType> обёртка над массивом данных текстуры (ширина в каналах)
+        */
+        inline auto textureVolume()
+        {
+            return StridedView3D<DataType>{_data.data(), _width * _bpp, _height, _depth};
+        }
+
+        /**
+         * Метод возвращающий значения текстуры в обёрте StridedView3D,
+         * которая позволяет работать с текстурой как с 3-мерным массивом.
+         *
+         * @return StridedView3D<const DataType> обёртка над массивом данных текстуры (ширина в каналах)
+        */
+        inline auto textureVolume() const
+        {
+            return StridedView3D<const DataType>{_data.data(), _width * _bpp, _height, _depth};
+        }
+
+        /**
+         * Метод возвращающий значения двухмерной текстуры в обёрте StridedView2D,
          * которая позволяет работать с текстурой как с 2-мерным массивом.
          * 
          * @param z глубина
-         * @return  MatrixView<DataType> обёртка над массивом данных двухмерной текстуры
+         * @return StridedView2D<DataType> обёртка над массивом данных двухмерной текстуры
+         * @throw out_of_range в случае если z больше глубины
         */
         inline auto texture2D(size_t z)
         {
-            return GearMatrixView<DataType>{&_data[z * _width * _height * _bpp], _width * _bpp, _height};
+            return textureVolume().slice(z);
         }
 
         /**
-         * Метод возвращающий значения двухмерной текстуры в обёрте MatrixView,
+         * Метод возвращающий значения двухмерной текстуры в обёрте StridedView2D,
          * которая позволяет работать с текстурой как с 2-мерным массивом.
          * 
          * @param z глубина
-         * @return  MatrixView<DataType> обёртка над массивом данных двухмерной текстуры
+         * @return StridedView2D<const DataType> обёртка над массивом данных двухмерной текстуры
+         * @throw out_of_range в случае если z больше глубины
         */
-        inline const auto texture2D(size_t z) const
+        inline auto texture2D(size_t z) const
         {
-            return GearMatrixView<DataType>{&_data[z * _width * _height * _bpp], _width * _bpp, _height};
+            return textureVolume().slice(z);
         }
 
         /**
          * Метод позволяющий получить кусок двухмерной текстуры от исходной текстуры.
          *
+         * offsetX задаётся в текселях, как и width.
+         * Для смещения в каналах используйте texture2D(z).subView.
+         *
          * @param z глубина
          * @param offsetY смещение по строкам
-         * @param offsetX смещение по столбцам
-         * @param width ширина подтекстуры (так же ширина ещё зависит от Tx)
+         * @param offsetX смещение по столбцам в текселях
+         * @param width ширина подтекстуры в текселях
          * @param height высота подтекстуры 
-         * @return GearMatrixView<DataType> обёртка над двухмерной подтекстурой
+         * @return StridedView2D<DataType> обёртка над двухмерной подтекстурой
+         * @throw out_of_range в случае если подтекстура выходит за пределы текстуры
         */
         inline auto subTexture2D(size_t z, size_t offsetY, size_t offsetX, size_t width, size_t height)
         {
-            return GearMatrixView<DataType>{&_data[z * _width * _height * _bpp], _width * _bpp, _height, offsetY, offsetX, width * _bpp, height};
+            return texture2D(z).subView(offsetY, offsetX * _bpp, width * _bpp, height);
         }
 
         /**
          * Метод позволяющий получить кусок двухмерной текстуры от исходной текстуры.
          *
+         * offsetX задаётся в текселях, как и width.
+         * Для смещения в каналах используйте texture2D(z).subView.
+         *
          * @param z глубина
          * @param offsetY смещение по строкам
-         * @param offsetX смещение по столбцам
-         * @param width ширина подтекстуры (так же ширина ещё зависит от Tx)
+         * @param offsetX смещение по столбцам в текселях
+         * @param width ширина подтекстуры в текселях
          * @param height высота подтекстуры 
-         * @return const GearMatrixView<DataType> обёртка над двухмерной подтекстурой
+         * @return StridedView2D<const DataType> обёртка над двухмерной подтекстурой
+         * @throw out_of_range в случае если подтекстура выходит за пределы текстуры
+        */
+        inline auto subTexture2D(size_t z, size_t offsetY, size_t offsetX, size_t width, size_t height) const
+        {
+            return texture2D(z).subView(offsetY, offsetX * _bpp, width * _bpp, height);
+        }
+
+        /**
+         * Метод позволяющий получить кусок текстуры от исходной текстуры.
+         *
+         * @param offsetZ смещение по глубине
+         * @param offsetY смещение по строкам
+         * @param offsetX смещение по столбцам в текселях
+         * @param width ширина подтекстуры в текселях
+         * @param height высота подтекстуры
+         * @param depth глубина подтекстуры
+         * @return StridedView3D<DataType> обёртка над подтекстурой
+         * @throw out_of_range в случае если подтекстура выходит за пределы текстуры
+        */
+        inline auto subTexture3D(size_t offsetZ, size_t offsetY, size_t offsetX, size_t width, size_t height, size_t depth)
+        {
+            return textureVolume().subView(offsetZ, offsetY, offsetX * _bpp, width * _bpp, height, depth);
+        }
+
+        /**
+         * Метод позволяющий получить кусок текстуры от исходной текстуры.
+         *
+         * @param offsetZ смещение по глубине
+         * @param offsetY смещение по строкам
+         * @param offsetX смещение по столбцам в текселях
+         * @param width ширина подтекстуры в текселях
+         * @param height высота подтекстуры
+         * @param depth глубина подтекстуры
+         * @return StridedView3D<const DataType> обёртка над подтекстурой
+         * @throw out_of_range в случае если подтекстура выходит за пределы текстуры
         */
-        inline const auto subTexture2D(size_t z, size_t offsetY, size_t offsetX, size_t width, size_t height) const
+        inline auto subTexture3D(size_t offsetZ, size_t offsetY, size_t offsetX, size_t width, size_t height, size_t depth) const
         {
-            return GearMatrixView<DataType>{&_data[z * _width * _height * _bpp], _width * _bpp, _height, offsetY, offsetX, width * _bpp, height};
+            return textureVolume().subView(offsetZ, offsetY, offsetX * _bpp, width * _bpp, height, depth);
         }
 
     private:
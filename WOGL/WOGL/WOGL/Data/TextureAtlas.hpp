@@ -0,0 +1,14 @@
+//
+//  TextureAtlas.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef TextureAtlas_hpp
+#define TextureAtlas_hpp
+
+#include "TextureAtlas.inl"
+
+#endif /* TextureAtlas_hpp */
@@ -0,0 +1,409 @@
+//
+//  TextureAtlas.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <glm/glm.hpp>
+
+#include "Texture2D.hpp"
+#include "Mesh.hpp"
+
+#include <vector>
+#include <optional>
+#include <numeric>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+
+#include <stdexcept>
+
+using namespace std;
+using namespace glm;
+
+namespace WOGL
+{
+    /**
+     * Область текстуры в атласе (без полей).
+     *
+     * @field x, y положение левого верхнего текселя в атласе
+     * @field width, height размер области
+     * @field uvOffset, uvScale преобразование текстурных координат исходной текстуры в координаты атласа
+    */
+    struct AtlasRegion
+    {
+        size_t x;
+        size_t y;
+        size_t width;
+        size_t height;
+        vec2 uvOffset;
+        vec2 uvScale;
+
+        /**
+         * Функция вычисляющая область в атласе по положению текстуры с полями.
+         *
+         * @param x, y положение текстуры вместе с полями
+         * @param width, height размер текстуры
+         * @param gutter ширина полей
+         * @param atlasWidth, atlasHeight размер атласа
+        */
+        static AtlasRegion make(size_t x, size_t y, size_t width, size_t height, size_t gutter, size_t atlasWidth, size_t atlasHeight) noexcept
+        {
+            const vec2 size (atlasWidth, atlasHeight);
+
+            return AtlasRegion{x + gutter, y + gutter, width, height, vec2(x + gutter, y + gutter) / size, vec2(width, height) / size};
+        }
+
+        /**
+         * Метод переводящий текстурные координаты исходной текстуры (из [0, 1]) в координаты атласа.
+        */
+        vec2 remap(const vec2& uv) const noexcept
+        {
+            return uvOffset + uv * uvScale;
+        }
+
+        /**
+         * Метод переписывающий текстурные координаты меша в координаты атласа.
+         * Повторение текстуры (uv вне [0, 1]) в атласе невозможно, такие координаты будут указывать на соседние области.
+        */
+        void remap(Mesh& mesh) const noexcept
+        {
+            for (auto& vertex: mesh.vertices()) {
+                vertex.uv = remap(vertex.uv);
+            }
+        }
+    };
+
+    /**
+     * Упаковщик прямоугольников методом skyline (bottom-left).
+     * Хранит "линию горизонта" - верхнюю границу уже занятой области, и ставит каждый прямоугольник как можно ниже.
+    */
+    class SkylinePacker
+    {
+        struct Node
+        {
+            size_t x;
+            size_t y;
+            size_t width;
+        };
+
+    public:
+        /**
+         * Конструктор.
+         *
+         * @param width ширина области
+         * @param height высота области
+        */
+        explicit SkylinePacker(size_t width, size_t height) :
+            _width{width},
+            _height{height}
+        {
+            clear();
+        }
+
+        /**
+         * Метод размещающий прямоугольник.
+         *
+         * @param width ширина прямоугольника
+         * @param height высота прямоугольника
+         * @return положение (x, y) левого верхнего угла или nullopt, если прямоугольник не поместился
+        */
+        optional<pair<size_t, size_t>> insert(size_t width, size_t height)
+        {
+            if (!width || !height) {
+                return nullopt;
+            }
+
+            size_t bestIndex = _skyline.size();
+            size_t bestTop = numeric_limits<size_t>::max();
+            size_t bestWidth = numeric_limits<size_t>::max();
+            size_t bestY = 0;
+
+            for (size_t i{0}; i < _skyline.size(); i++) {
+                if (const auto y = _fit(i, width, height)) {
+                    const size_t top = *y + height;
+
+                    if (top < bestTop || (top == bestTop && _skyline[i].width < bestWidth)) {
+                        bestIndex = i;
+                        bestTop = top;
+                        bestWidth = _skyline[i].width;
+                        bestY = *y;
+                    }
+                }
+            }
+
+            if (bestIndex == _skyline.size()) {
+                return nullopt;
+            }
+
+            const size_t x = _skyline[bestIndex].x;
+            _add(bestIndex, x, bestY, width, height);
+            _usedArea += width * height;
+
+            return make_pair(x, bestY);
+        }
+
+        /**
+         * Метод освобождающий всю область.
+        */
+        void clear()
+        {
+            _skyline.assign(1, Node{0, 0, _width});
+            _usedArea = 0;
+        }
+
+        size_t width() const noexcept
+        {
+            return _width;
+        }
+
+        size_t height() const noexcept
+        {
+            return _height;
+        }
+
+        /**
+         * @return доля занятой площади
+        */
+        float occupancy() const noexcept
+        {
+            return static_cast<float>(_usedArea) / static_cast<float>(_width * _height);
+        }
+
+    private:
+        optional<size_t> _fit(size_t index, size_t width, size_t height) const noexcept
+        {
+            if (_skyline[index].x + width > _width) {
+                return nullopt;
+            }
+
+            size_t y = 0;
+
+            for (size_t i{index}, covered{0}; covered < width; i++) {
+                y = max(y, _skyline[i].y);
+
+                if (y + height > _height) {
+                    return nullopt;
+                }
+
+                covered += _skyline[i].width;
+            }
+
+            return y;
+        }
+
+        void _add(size_t index, size_t x, size_t y, size_t width, size_t height)
+        {
+            _skyline.insert(_skyline.begin() + index, Node{x, y + height, width});
+
+            for (size_t i{index + 1}; i < _skyline.size(); ) {
+                const auto& previous = _skyline[i - 1];
+                const size_t previousEnd = previous.x + previous.width;
+
+                if (_skyline[i].x >= previousEnd) {
+                    break;
+                }
+
+                const size_t shrink = previousEnd - _skyline[i].x;
+
+                if (_skyline[i].width <= shrink) {
+                    _skyline.erase(_skyline.begin() + i);
+                } else {
+                    _skyline[i].x += shrink;
+                    _skyline[i].width -= shrink;
+                    break;
+                }
+            }
+
+            for (size_t i{1}; i < _skyline.size(); ) {
+                if (_skyline[i - 1].y == _skyline[i].y) {
+                    _skyline[i - 1].width += _skyline[i].width;
+                    _skyline.erase(_skyline.begin() + i);
+                } else {
+                    i++;
+                }
+            }
+        }
+
+        size_t _width;
+        size_t _height;
+        size_t _usedArea = 0;
+        vector<Node> _skyline;
+    };
+
+    /**
+     * Атлас текстур - одна текстура, в которую упакованы много маленьких текстур,
+     * чтобы вместо сотен привязок текстур при отрисовке выполнялась одна.
+     *
+     * Каждая текстура окружается полями шириной gutter, в которые повторяются её крайние тексели,
+     * поэтому соседние текстуры не "протекают" друг в друга при билинейной фильтрации и на первых log2(gutter) уровнях mipmap'а.
+     *
+     * @template DataType тип каналов
+     * @template Tx тип текселя
+    */
+    template<typename DataType, TexelType Tx>
+    class TextureAtlas
+    {
+    public:
+        using TextureType = Texture2D<DataType, Tx>;
+
+        /**
+         * Конструктор.
+         *
+         * @param width ширина атласа
+         * @param height высота атласа
+         * @param gutter ширина полей вокруг каждой текстуры
+        */
+        explicit TextureAtlas(size_t width, size_t height, size_t gutter = 4) :
+            _texture(width, height),
+            _packer(width, height),
+            _gutter{gutter}
+        {
+        }
+
+        /**
+         * Метод добавляющий текстуру в атлас.
+         *
+         * @param texture текстура
+         * @return область текстуры в атласе или nullopt, если в атласе не осталось места
+        */
+        optional<AtlasRegion> insert(const TextureType& texture)
+        {
+            const auto position = _packer.insert(texture._width + 2 * _gutter, texture._height + 2 * _gutter);
+
+            if (!position) {
+                return nullopt;
+            }
+
+            return _place(texture, position->first, position->second);
+        }
+
+        /**
+         * Метод добавляющий в атлас набор текстур. Текстуры упаковываются по убыванию высоты, что заметно плотнее,
+         * чем добавление по одной в произвольном порядке.
+         *
+         * @param textures контейнер текстур (или указателей на текстуры)
+         * @return области текстур в том же порядке, что и в textures
+         * @throw out_of_range в случае если текстуры не поместились в атлас (атлас при этом не изменяется)
+        */
+        template<typename Conteiner>
+        vector<AtlasRegion> insert(const Conteiner& textures)
+        {
+            vector<const TextureType*> pointers;
+
+            for (const auto& texture: textures) {
+                if constexpr (is_same_v<decay_t<decltype(texture)>, TextureType>) {
+                    pointers.push_back(&texture);
+                } else {
+                    pointers.push_back(&*texture);
+                }
+            }
+
+            vector<size_t> order (pointers.size());
+            iota(order.begin(), order.end(), 0);
+
+            stable_sort(order.begin(), order.end(), [&pointers] (size_t a, size_t b) {
+                return pointers[a]->_height != pointers[b]->_height ? pointers[a]->_height > pointers[b]->_height :
+                                                                       pointers[a]->_width > pointers[b]->_width;
+            });
+
+            auto packer = _packer;
+            vector<pair<size_t, size_t>> positions (pointers.size());
+
+            for (const auto i: order) {
+                const auto position = packer.insert(pointers[i]->_width + 2 * _gutter, pointers[i]->_height + 2 * _gutter);
+
+                if (!position) {
+                    throw out_of_range("Textures do not fit in the atlas");
+                }
+
+                positions[i] = *position;
+            }
+
+            _packer = packer;
+
+            vector<AtlasRegion> regions;
+
+            for (size_t i{0}; i < pointers.size(); i++) {
+                regions.push_back(_place(*pointers[i], positions[i].first, positions[i].second));
+            }
+
+            return regions;
+        }
+
+        /**
+         * Функция возвращающая копию текстуры с полями шириной gutter, заполненными крайними текселями.
+        */
+        static TextureType pad(const TextureType& texture, size_t gutter)
+        {
+            TextureType padded (texture._width + 2 * gutter, texture._height + 2 * gutter);
+            padded.subSet(texture, gutter, gutter);
+            _fillGutter(padded, 0, 0, texture._width, texture._height, gutter);
+
+            return padded;
+        }
+
+        const TextureType& texture() const noexcept
+        {
+            return _texture;
+        }
+
+        const vector<AtlasRegion>& regions() const noexcept
+        {
+            return _regions;
+        }
+
+        const SkylinePacker& packer() const noexcept
+        {
+            return _packer;
+        }
+
+        size_t gutter() const noexcept
+        {
+            return _gutter;
+        }
+
+    private:
+        AtlasRegion _place(const TextureType& texture, size_t x, size_t y)
+        {
+            _texture.subSet(texture, y + _gutter, x + _gutter);
+            _fillGutter(_texture, x, y, texture._width, texture._height, _gutter);
+            _regions.push_back(AtlasRegion::make(x, y, texture._width, texture._height, _gutter, _texture._width, _texture._height));
+
+            return _regions.back();
+        }
+
+        /**
+         * Метод заполняющий поля вокруг области (x + gutter, y + gutter, width, height) крайними текселями.
+        */
+        static void _fillGutter(TextureType& texture, size_t x, size_t y, size_t width, size_t height, size_t gutter) noexcept
+        {
+            const size_t bpp = texture._bpp;
+            const size_t stride = texture._width * bpp;
+            auto* data = &texture._data[0];
+
+            for (size_t row{y + gutter}; row < y + gutter + height; row++) {
+                auto* line = data + row * stride;
+
+                for (size_t i{0}; i < gutter; i++) {
+                    copy_n(line + (x + gutter) * bpp, bpp, line + (x + i) * bpp);
+                    copy_n(line + (x + gutter + width - 1) * bpp, bpp, line + (x + gutter + width + i) * bpp);
+                }
+            }
+
+            const size_t rowSize = (width + 2 * gutter) * bpp;
+
+            for (size_t i{0}; i < gutter; i++) {
+                copy_n(data + (y + gutter) * stride + x * bpp, rowSize, data + (y + i) * stride + x * bpp);
+                copy_n(data + (y + gutter + height - 1) * stride + x * bpp, rowSize, data + (y + gutter + height + i) * stride + x * bpp);
+            }
+        }
+
+        TextureType _texture;
+        SkylinePacker _packer;
+        size_t _gutter;
+        vector<AtlasRegion> _regions;
+    };
+}
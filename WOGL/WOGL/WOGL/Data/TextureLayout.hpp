@@ -0,0 +1,14 @@
+//
+//  TextureLayout.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef TextureLayout_hpp
+#define TextureLayout_hpp
+
+#include "TextureLayout.inl"
+
+#endif /* TextureLayout_hpp */
@@ -0,0 +1,197 @@
+//
+//  TextureLayout.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <cstdint>
+#include <cstddef>
+
+#include <algorithm>
+
+using namespace std;
+
+namespace WOGL
+{
+    /**
+     * Политики расположения текселей в памяти.
+     * Объект политики создаётся по размеру текстуры и переводит координаты текселя (x, y, z) в его номер.
+     *
+     * Каждая политика предоставляет:
+     *  size() - количество текселей в памяти (с учётом выравнивания до целых тайлов),
+     *  operator()(x, y, z) - номер текселя,
+     *  forEachSpan(y, z, func) - вызывает func(x, index, length) для каждого отрезка строки (y, z),
+     *  тексели которого лежат в памяти подряд (используется для быстрого копирования в построчный формат и обратно).
+    */
+
+    /**
+     * Построчное расположение (как в Texture2D и Texture3D).
+    */
+    class RowMajorLayout
+    {
+    public:
+        RowMajorLayout(size_t width, size_t height, size_t depth = 1) noexcept :
+            _width{width},
+            _height{height},
+            _depth{depth}
+        {
+        }
+
+        size_t size() const noexcept
+        {
+            return _width * _height * _depth;
+        }
+
+        size_t operator()(size_t x, size_t y, size_t z = 0) const noexcept
+        {
+            return (z * _height + y) * _width + x;
+        }
+
+        template<typename Func>
+        void forEachSpan(size_t y, size_t z, Func&& func) const
+        {
+            func(size_t{0}, (*this)(0, y, z), _width);
+        }
+
+    private:
+        size_t _width;
+        size_t _height;
+        size_t _depth;
+    };
+
+    /**
+     * Расположение тайлами: текстура делится на тайлы TileWidth x TileHeight x TileDepth,
+     * тайлы идут построчно, а внутри тайла тексели тоже идут построчно.
+     * Соседние по любой оси тексели почти всегда оказываются в одной или соседних кэш-линиях.
+     *
+     * @template TileWidth, TileHeight, TileDepth размер тайла (для 2d текстур TileDepth = 1)
+    */
+    template<size_t TileWidth = 8, size_t TileHeight = 8, size_t TileDepth = 1>
+    class TiledLayout
+    {
+        static_assert(TileWidth > 0 && TileHeight > 0 && TileDepth > 0, "Tile size must not be zero");
+
+    public:
+        static constexpr size_t TILE_SIZE = TileWidth * TileHeight * TileDepth;
+
+        TiledLayout(size_t width, size_t height, size_t depth = 1) noexcept :
+            _width{width},
+            _tilesX{(width + TileWidth - 1) / TileWidth},
+            _tilesY{(height + TileHeight - 1) / TileHeight},
+            _tilesZ{(depth + TileDepth - 1) / TileDepth}
+        {
+        }
+
+        size_t size() const noexcept
+        {
+            return _tilesX * _tilesY * _tilesZ * TILE_SIZE;
+        }
+
+        size_t operator()(size_t x, size_t y, size_t z = 0) const noexcept
+        {
+            const size_t tile = ((z / TileDepth) * _tilesY + y / TileHeight) * _tilesX + x / TileWidth;
+            return tile * TILE_SIZE + ((z % TileDepth) * TileHeight + y % TileHeight) * TileWidth + x % TileWidth;
+        }
+
+        template<typename Func>
+        void forEachSpan(size_t y, size_t z, Func&& func) const
+        {
+            for (size_t x{0}; x < _width; x += TileWidth) {
+                func(x, (*this)(x, y, z), min(TileWidth, _width - x));
+            }
+        }
+
+    private:
+        size_t _width;
+        size_t _tilesX;
+        size_t _tilesY;
+        size_t _tilesZ;
+    };
+
+    /**
+     * Расположение в порядке Мортона (Z-порядок) внутри тайлов размером 2^TileLog2 по каждой оси,
+     * тайлы идут построчно. Номер текселя внутри тайла получается чередованием битов координат,
+     * поэтому тексели, близкие по всем осям сразу, близки и в памяти (удобно для 3d трафаретов).
+     * Тайлы ограничивают выравнивание размера (в отличие от единой кривой Мортона по всей текстуре).
+     *
+     * @template TileLog2 логарифм размера тайла по каждой оси
+    */
+    template<size_t TileLog2 = 4>
+    class MortonLayout
+    {
+        static_assert(TileLog2 > 0 && TileLog2 <= 10, "Incorrect Morton tile size");
+
+        static constexpr size_t _TILE = size_t{1} << TileLog2;
+        static constexpr size_t _MASK = _TILE - 1;
+
+    public:
+        MortonLayout(size_t width, size_t height, size_t depth = 1) noexcept :
+            _width{width},
+            _volume{depth > 1},
+            _tilesX{(width + _MASK) >> TileLog2},
+            _tilesY{(height + _MASK) >> TileLog2},
+            _tilesZ{_volume ? (depth + _MASK) >> TileLog2 : 1},
+            _tileSize{_volume ? _TILE * _TILE * _TILE : _TILE * _TILE}
+        {
+        }
+
+        size_t size() const noexcept
+        {
+            return _tilesX * _tilesY * _tilesZ * _tileSize;
+        }
+
+        size_t operator()(size_t x, size_t y, size_t z = 0) const noexcept
+        {
+            if (_volume) {
+                const size_t tile = ((z >> TileLog2) * _tilesY + (y >> TileLog2)) * _tilesX + (x >> TileLog2);
+                return tile * _tileSize + (_part1By2(x & _MASK) | (_part1By2(y & _MASK) << 1) | (_part1By2(z & _MASK) << 2));
+            }
+
+            const size_t tile = (y >> TileLog2) * _tilesX + (x >> TileLog2);
+            return tile * _tileSize + (_part1By1(x & _MASK) | (_part1By1(y & _MASK) << 1));
+        }
+
+        /**
+         * Младший бит x является младшим битом номера, поэтому подряд лежат только пары текселей.
+        */
+        template<typename Func>
+        void forEachSpan(size_t y, size_t z, Func&& func) const
+        {
+            for (size_t x{0}; x < _width; x += 2) {
+                func(x, (*this)(x, y, z), min<size_t>(2, _width - x));
+            }
+        }
+
+    private:
+        static inline size_t _part1By1(size_t v) noexcept
+        {
+            v &= 0x0000FFFF;
+            v = (v | (v << 8)) & 0x00FF00FF;
+            v = (v | (v << 4)) & 0x0F0F0F0F;
+            v = (v | (v << 2)) & 0x33333333;
+            v = (v | (v << 1)) & 0x55555555;
+
+            return v;
+        }
+
+        static inline size_t _part1By2(size_t v) noexcept
+        {
+            v &= 0x000003FF;
+            v = (v | (v << 16)) & 0xFF0000FF;
+            v = (v | (v << 8)) & 0x0300F00F;
+            v = (v | (v << 4)) & 0x030C30C3;
+            v = (v | (v << 2)) & 0x09249249;
+
+            return v;
+        }
+
+        size_t _width;
+        bool _volume;
+        size_t _tilesX;
+        size_t _tilesY;
+        size_t _tilesZ;
+        size_t _tileSize;
+    };
+}
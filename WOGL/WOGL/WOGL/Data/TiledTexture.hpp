@@ -0,0 +1,14 @@
+//
+//  TiledTexture.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef TiledTexture_hpp
+#define TiledTexture_hpp
+
+#include "TiledTexture.inl"
+
+#endif /* TiledTexture_hpp */
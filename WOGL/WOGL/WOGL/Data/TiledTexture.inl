@@ -0,0 +1,370 @@
+//
+//  TiledTexture.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include "Texture2D.hpp"
+#include "Texture3D.hpp"
+#include "TextureLayout.hpp"
+#include "../Core/ThreadPool.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace WOGL
+{
+    /**
+     * Базовый класс текстур с произвольным расположением текселей (см. TextureLayout).
+     * Хранит данные и выполняет копирование в построчный формат и обратно отрезками, лежащими в памяти подряд.
+     *
+     * @template DataType тип каналов
+     * @template Tx тип текселя
+     * @template Layout политика расположения текселей
+    */
+    template<typename DataType, TexelType Tx, typename Layout>
+    class BaseTiledTexture
+    {
+    public:
+        /**
+         * @return количество каналов в текселе
+        */
+        static constexpr size_t bpp() noexcept
+        {
+            return numberOfChannels(Tx);
+        }
+
+        size_t width() const noexcept
+        {
+            return _width;
+        }
+
+        size_t height() const noexcept
+        {
+            return _height;
+        }
+
+        const Layout& layout() const noexcept
+        {
+            return _layout;
+        }
+
+        /**
+         * @return данные в порядке политики расположения (с выравниванием до целых тайлов)
+        */
+        const vector<DataType>& data() const noexcept
+        {
+            return _data;
+        }
+
+    protected:
+        BaseTiledTexture(size_t width, size_t height, size_t depth) :
+            _width{width},
+            _height{height},
+            _depth{depth},
+            _layout(width, height, depth),
+            _data(_layout.size() * bpp())
+        {
+        }
+
+        inline DataType* _texel(size_t x, size_t y, size_t z) noexcept
+        {
+            return &_data[_layout(x, y, z) * bpp()];
+        }
+
+        inline const DataType* _texel(size_t x, size_t y, size_t z) const noexcept
+        {
+            return &_data[_layout(x, y, z) * bpp()];
+        }
+
+        /**
+         * Метод копирующий данные из построчного массива.
+        */
+        void _fromLinear(const DataType* src, ThreadPool& pool)
+        {
+            pool.parallelFor(0, _height * _depth, [this, src] (size_t begin, size_t end) {
+                for (size_t row{begin}; row < end; row++) {
+                    const DataType* line = src + row * _width * bpp();
+
+                    _layout.forEachSpan(row % _height, row / _height, [this, line] (size_t x, size_t index, size_t length) {
+                        copy_n(line + x * bpp(), length * bpp(), &_data[index * bpp()]);
+                    });
+                }
+            }, _grain());
+        }
+
+        /**
+         * Метод копирующий данные в построчный массив.
+        */
+        void _toLinear(DataType* dst, ThreadPool& pool) const
+        {
+            pool.parallelFor(0, _height * _depth, [this, dst] (size_t begin, size_t end) {
+                for (size_t row{begin}; row < end; row++) {
+                    DataType* line = dst + row * _width * bpp();
+
+                    _layout.forEachSpan(row % _height, row / _height, [this, line] (size_t x, size_t index, size_t length) {
+                        copy_n(&_data[index * bpp()], length * bpp(), line + x * bpp());
+                    });
+                }
+            }, _grain());
+        }
+
+        size_t _grain() const noexcept
+        {
+            return max<size_t>(16384 / max<size_t>(_width * bpp(), 1), 1);
+        }
+
+        size_t _width;
+        size_t _height;
+        size_t _depth;
+        Layout _layout;
+        vector<DataType> _data;
+    };
+
+    /**
+     * Двумерная текстура в памяти CPU, тексели которой расположены тайлами или в порядке Мортона.
+     * Предназначена для фильтров, читающих окрестности текселей: такие окрестности занимают меньше кэш-линий,
+     * чем в построчной Texture2D. Для загрузки в GPU текстура переводится в Texture2D методом linear.
+     *
+     * @template DataType тип каналов
+     * @template Tx тип текселя
+     * @template Layout политика расположения текселей (TiledLayout, MortonLayout или RowMajorLayout)
+    */
+    template<typename DataType, TexelType Tx, typename Layout = TiledLayout<>>
+    class TiledTexture2D :
+        public BaseTiledTexture<DataType, Tx, Layout>
+    {
+        using Base = BaseTiledTexture<DataType, Tx, Layout>;
+
+    public:
+        using TextureType = Texture2D<DataType, Tx>;
+
+        /**
+         * Конструктор.
+         *
+         * @param width ширина
+         * @param height высота
+        */
+        explicit TiledTexture2D(size_t width, size_t height) :
+            Base(width, height, 1)
+        {
+        }
+
+        /**
+         * Конструктор переводящий построчную текстуру в расположение Layout.
+         *
+         * @param texture текстура
+         * @param pool пул потоков
+        */
+        explicit TiledTexture2D(const TextureType& texture, ThreadPool& pool = ThreadPool::global()) :
+            Base(texture.width(), texture.height(), 1)
+        {
+            this->_fromLinear(texture.textureMatrix().data(), pool);
+        }
+
+        /**
+         * Метод возвращающий указатель на каналы текселя.
+        */
+        inline DataType* texel(size_t x, size_t y) noexcept
+        {
+            return this->_texel(x, y, 0);
+        }
+
+        inline const DataType* texel(size_t x, size_t y) const noexcept
+        {
+            return this->_texel(x, y, 0);
+        }
+
+        /**
+         * @throw out_of_range в случае если тексель или канал не существуют
+        */
+        DataType& at(size_t x, size_t y, size_t channel = 0)
+        {
+            _check(x, y, channel);
+            return texel(x, y)[channel];
+        }
+
+        /**
+         * @throw out_of_range в случае если тексель или канал не существуют
+        */
+        const DataType& at(size_t x, size_t y, size_t channel = 0) const
+        {
+            _check(x, y, channel);
+            return texel(x, y)[channel];
+        }
+
+        /**
+         * Метод переводящий текстуру в построчный формат (например для загрузки в GPU).
+         *
+         * @param pool пул потоков
+         * @return построчная текстура
+        */
+        TextureType linear(ThreadPool& pool = ThreadPool::global()) const
+        {
+            TextureType texture (this->_width, this->_height);
+            this->_toLinear(texture.textureMatrix().data(), pool);
+
+            return texture;
+        }
+
+        /**
+         * Метод переводящий текстуру в построчный формат в уже выделенную текстуру того же размера
+         * (чтобы не выделять память при каждой загрузке).
+         *
+         * @throw invalid_argument в случае если размеры текстур не совпадают
+        */
+        void linear(TextureType& texture, ThreadPool& pool = ThreadPool::global()) const
+        {
+            if (texture.width() != this->_width || texture.height() != this->_height) {
+                throw invalid_argument("Texture sizes do not match");
+            }
+
+            this->_toLinear(texture.textureMatrix().data(), pool);
+        }
+
+        /**
+         * Метод копирующий данные из построчной текстуры того же размера.
+         *
+         * @throw invalid_argument в случае если размеры текстур не совпадают
+        */
+        void assign(const TextureType& texture, ThreadPool& pool = ThreadPool::global())
+        {
+            if (texture.width() != this->_width || texture.height() != this->_height) {
+                throw invalid_argument("Texture sizes do not match");
+            }
+
+            this->_fromLinear(texture.textureMatrix().data(), pool);
+        }
+
+    private:
+        void _check(size_t x, size_t y, size_t channel) const
+        {
+            if (x >= this->_width || y >= this->_height || channel >= Base::bpp()) {
+                throw out_of_range("Out of range");
+            }
+        }
+    };
+
+    /**
+     * Трёхмерная текстура в памяти CPU, тексели которой расположены тайлами или в порядке Мортона.
+     * Для загрузки в GPU текстура переводится в Texture3D методом linear.
+     *
+     * @template DataType тип каналов
+     * @template Tx тип текселя
+     * @template Layout политика расположения текселей (TiledLayout, MortonLayout или RowMajorLayout)
+    */
+    template<typename DataType, TexelType Tx, typename Layout = TiledLayout<8, 8, 8>>
+    class TiledTexture3D :
+        public BaseTiledTexture<DataType, Tx, Layout>
+    {
+        using Base = BaseTiledTexture<DataType, Tx, Layout>;
+
+    public:
+        using TextureType = Texture3D<DataType, Tx>;
+
+        /**
+         * Конструктор.
+         *
+         * @param width ширина
+         * @param height высота
+         * @param depth глубина
+        */
+        explicit TiledTexture3D(size_t width, size_t height, size_t depth) :
+            Base(width, height, depth)
+        {
+        }
+
+        /**
+         * Конструктор переводящий построчную текстуру в расположение Layout.
+         *
+         * @param texture текстура
+         * @param pool пул потоков
+        */
+        explicit TiledTexture3D(const TextureType& texture, ThreadPool& pool = ThreadPool::global()) :
+            Base(texture.width(), texture.height(), texture.depth())
+        {
+            this->_fromLinear(texture.textureVolume().data(), pool);
+        }
+
+        size_t depth() const noexcept
+        {
+            return this->_depth;
+        }
+
+        inline DataType* texel(size_t x, size_t y, size_t z) noexcept
+        {
+            return this->_texel(x, y, z);
+        }
+
+        inline const DataType* texel(size_t x, size_t y, size_t z) const noexcept
+        {
+            return this->_texel(x, y, z);
+        }
+
+        /**
+         * @throw out_of_range в случае если тексель или канал не существуют
+        */
+        DataType& at(size_t x, size_t y, size_t z, size_t channel = 0)
+        {
+            _check(x, y, z, channel);
+            return texel(x, y, z)[channel];
+        }
+
+        /**
+         * @throw out_of_range в случае если тексель или канал не существуют
+        */
+        const DataType& at(size_t x, size_t y, size_t z, size_t channel = 0) const
+        {
+            _check(x, y, z, channel);
+            return texel(x, y, z)[channel];
+        }
+
+        /**
+         * Метод переводящий текстуру в построчный формат (например для загрузки в GPU).
+        */
+        TextureType linear(ThreadPool& pool = ThreadPool::global()) const
+        {
+            TextureType texture (this->_width, this->_height, this->_depth);
+            this->_toLinear(texture.textureVolume().data(), pool);
+
+            return texture;
+        }
+
+        /**
+         * @throw invalid_argument в случае если размеры текстур не совпадают
+        */
+        void linear(TextureType& texture, ThreadPool& pool = ThreadPool::global()) const
+        {
+            if (texture.width() != this->_width || texture.height() != this->_height || texture.depth() != this->_depth) {
+                throw invalid_argument("Texture sizes do not match");
+            }
+
+            this->_toLinear(texture.textureVolume().data(), pool);
+        }
+
+        /**
+         * @throw invalid_argument в случае если размеры текстур не совпадают
+        */
+        void assign(const TextureType& texture, ThreadPool& pool = ThreadPool::global())
+        {
+            if (texture.width() != this->_width || texture.height() != this->_height || texture.depth() != this->_depth) {
+                throw invalid_argument("Texture sizes do not match");
+            }
+
+            this->_fromLinear(texture.textureVolume().data(), pool);
+        }
+
+    private:
+        void _check(size_t x, size_t y, size_t z, size_t channel) const
+        {
+            if (x >= this->_width || y >= this->_height || z >= this->_depth || channel >= Base::bpp()) {
+                throw out_of_range("Out of range");
+            }
+        }
+    };
+}
@@ -0,0 +1,14 @@
+//
+//  BindingTracker.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef BindingTracker_hpp
+#define BindingTracker_hpp
+
+#include "BindingTracker.inl"
+
+#endif /* BindingTracker_hpp */
@@ -0,0 +1,155 @@
+//
+//  BindingTracker.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <GL/glew.h>
+
+#include "ShaderProgram.hpp"
+#include "VertexArray.hpp"
+#include "Buffers/IndexBuffer.hpp"
+#include "Texture/TextureRenderer.hpp"
+#include "Texture/Sampler.hpp"
+
+#include <array>
+
+namespace WOGL
+{
+    /**
+     * Класс запоминающий последние привязанные объекты (шейдерную программу, VAO, EBO, текстуры
+     * и сэмплеры в текстурных слотах) и пропускающий повторные привязки тех же объектов.
+     *
+     * Если между вызовами состояние OpenGL изменялось в обход трекера, то перед
+     * дальнейшим использованием необходимо вызвать reset().
+    */
+    class BindingTracker
+    {
+    public:
+        /**
+         * Количество текстурных слотов, привязки к которым отслеживаются.
+         * Привязки к слотам с большим номером выполняются всегда.
+        */
+        static constexpr int32_t NUMBER_TRACKED_SLOTS = 32;
+
+        BindingTracker() noexcept
+        {
+            reset();
+        }
+
+        BindingTracker(const BindingTracker&) = delete;
+        BindingTracker& operator=(const BindingTracker&) = delete;
+
+        /**
+         * Метод забывающий все запомненные привязки.
+        */
+        void reset() noexcept
+        {
+            _program = nullptr;
+            _vertexArray = nullptr;
+            _indexBuffer = nullptr;
+            _textures.fill(nullptr);
+            _samplers.fill(nullptr);
+        }
+
+        /**
+         * Метод делающий шейдерную программу текущей, если она ещё не текущая.
+         *
+         * @param program шейдерная программа
+        */
+        inline void useProgram(const ShaderProgram& program) noexcept
+        {
+            if (_program != &program) {
+                program.use();
+                _program = &program;
+            }
+        }
+
+        /**
+         * Метод привязывающий текстуру и её сэмплер к текстурному слоту, если они ещё не привязаны к нему.
+         *
+         * @param slot текстурный слот
+         * @param texture текстура
+        */
+        inline void bindTexture(int32_t slot, const ITextureRenderer& texture) noexcept
+        {
+            if (slot < 0 || slot >= NUMBER_TRACKED_SLOTS) {
+                texture.bind(slot);
+                Sampler::bind(slot, texture.sampler());
+            } else {
+                if (_textures[slot] != &texture) {
+                    texture.bind(slot);
+                    _textures[slot] = &texture;
+                }
+
+                bindSampler(slot, texture.sampler());
+            }
+        }
+
+        /**
+         * Метод привязывающий сэмплер к текстурному слоту, если он ещё не привязан к нему.
+         * Если sampler равен nullptr, то от слота отвязывается сэмплер и используются параметры самой текстуры.
+         * Изначально считается, что ко всем слотам сэмплеры не привязаны.
+         *
+         * @param slot текстурный слот
+         * @param sampler сэмплер
+        */
+        inline void bindSampler(int32_t slot, const Sampler* sampler) noexcept
+        {
+            if (slot < 0 || slot >= NUMBER_TRACKED_SLOTS) {
+                Sampler::bind(slot, sampler);
+            } else if (_samplers[slot] != sampler) {
+                Sampler::bind(slot, sampler);
+                _samplers[slot] = sampler;
+            }
+        }
+
+        /**
+         * Метод делающий VAO текущим, если он ещё не текущий.
+         * Так как привязка EBO является частью состояния VAO, то при смене VAO
+         * запомненный EBO забывается.
+         *
+         * @param vertexArray VAO
+        */
+        inline void bindVertexArray(const VertexArray& vertexArray) noexcept
+        {
+            if (_vertexArray != &vertexArray) {
+                vertexArray.bind();
+                _vertexArray = &vertexArray;
+                _indexBuffer = nullptr;
+            }
+        }
+
+        /**
+         * Метод делающий индексный буфер текущим, если он ещё не текущий.
+         *
+         * @param indexBuffer индексный буфер
+        */
+        inline void bindIndexBuffer(const IndexBuffer& indexBuffer) noexcept
+        {
+            if (_indexBuffer != &indexBuffer) {
+                indexBuffer.bind();
+                _indexBuffer = &indexBuffer;
+            }
+        }
+
+        /**
+         * Метод делающий текущим нулевой VAO.
+        */
+        inline void unbindVertexArray() noexcept
+        {
+            VertexArray::unbind();
+            _vertexArray = nullptr;
+            _indexBuffer = nullptr;
+        }
+
+    private:
+        const ShaderProgram* _program;
+        const VertexArray* _vertexArray;
+        const IndexBuffer* _indexBuffer;
+        array<const ITextureRenderer*, NUMBER_TRACKED_SLOTS> _textures;
+        array<const Sampler*, NUMBER_TRACKED_SLOTS> _samplers;
+    };
+}
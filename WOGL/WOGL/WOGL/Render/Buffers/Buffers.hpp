@@ -12,5 +12,7 @@
 #include "VertexBuffer.hpp"
 #include "IndexBuffer.hpp"
 #include "Framebuffer.hpp"
+#include "PixelReadback.hpp"
+#include "StagingBuffer.hpp"
 
 #endif /* Buffers_hpp */
@@ -9,9 +9,14 @@
 #include <vector>
 
 #include "../Texture/TextureRenderer2D.hpp"
+#include "../../Data/Conteiners/ArrayView.hpp"
 
 #include <memory>
 
+#include <stdexcept>
+
+#include <type_traits>
+
 namespace WOGL
 {
 	class IFramebuffer
@@ -30,6 +35,7 @@ namespace WOGL
 		using TextureRenderers = vector<TextureRenderer2D<Tf>>;
 
 		friend class Context;
+		friend class PixelReadback;
 	public: 
 		/**
 		 * Конструктор.
@@ -48,7 +54,7 @@ namespace WOGL
 			}
 
 			for (int32_t i{0}; i < numColorBuffers; i++) {
-				_colorBuffer.push_back(TextureRenderer2D<Tf>{width, height});
+				_colorBuffer.push_back(TextureRenderer2D<Tf>{width, height, 1});
 			}
 
 			_colorBuffer.shrink_to_fit();
@@ -82,7 +88,7 @@ namespace WOGL
 			auto[windowWidth, windowHeight] = window.size();
 
 			for (int32_t i{0}; i < numColorBuffers; i++) {
-				_colorBuffer.push_back(TextureRenderer2D<Tf>{windowWidth, windowHeight});
+				_colorBuffer.push_back(TextureRenderer2D<Tf>{windowWidth, windowHeight, 1});
 			}
 
 			_colorBuffer.shrink_to_fit();
@@ -163,6 +169,83 @@ namespace WOGL
 			return data;
 		}
 
+		/**
+		 * Метод необходимый для считывания значений пикселя из кадрового буфера в уже существующий вектор.
+		 * Память вектора переиспользуется, если её ёмкости достаточно.
+		 * Для чтения без остановки конвейера используйте PixelReadback.
+		 *
+		 * @param data вектор пикселей (его размер будет приведён к width * height * 3)
+		 * @param width ширна
+		 * @param height высота
+		 * @param x координата по оси X (необходима для выявления того, откуда нужно начинать считывать по оси X)
+		 * @param y координата по оси Y (необходима для выявления того, откуда нужно начинать считывать по оси Y)
+		*/
+		void readPixels(vector<float>& data, int32_t width, int32_t height, int32_t x, int32_t y) const
+		{
+			data.resize(width * height * 3);
+			glReadPixels(x, y, width, height, GL_RGB, GL_FLOAT, &data[0]);
+		}
+
+		/**
+		 * Метод необходимый для считывания значений пикселей из заданного буфера цвета.
+		 * Формат пикселя берётся из Tf, поэтому по умолчанию данные передаются без преобразований
+		 * (например для RGBA8_U читается 4 байта на пиксель).
+		 *
+		 * @param data массив куда будут записаны значения пикселей (его размер должен быть не меньше width * height * количество каналов Tf)
+		 * @param width ширна
+		 * @param height высота
+		 * @param x координата по оси X (необходима для выявления того, откуда нужно начинать считывать по оси X)
+		 * @param y координата по оси Y (необходима для выявления того, откуда нужно начинать считывать по оси Y)
+		 * @param attachment номер буфера цвета
+		 * @template DataType тип каждого из каналов считываемых пикселей
+		 * @throw out_of_range в случае если буфера цвета с номером attachment нет
+		 * @throw invalid_argument в случае если размер data недостаточен
+		*/
+		template<typename DataType = typename TexelFormatTraits<Tf>::DataType>
+		void readPixels(ArrayView<DataType> data, int32_t width, int32_t height, int32_t x, int32_t y, uint32_t attachment = 0) const
+		{
+			static_assert(!isIntegerFormat(Tf) || is_integral_v<DataType>, "Integer texel format can be read only into integer data");
+
+			if (attachment >= _colorBuffer.size()) {
+				throw out_of_range("Color attachment is out of range");
+			}
+
+			_read(data.begin(), data.size(), static_cast<size_t>(width) * height * TexelFormatTraits<Tf>::channels,
+				  GL_COLOR_ATTACHMENT0 + attachment, width, height, x, y, TexelFormatTraits<Tf>::format, BaseTextureRenderer::_type<DataType>());
+		}
+
+		/**
+		 * Метод необходимый для считывания значений из буфера глубины.
+		 * Кадровый буфер должен иметь буфер глубины.
+		 *
+		 * @param data массив куда будут записаны значения глубины (его размер должен быть не меньше width * height)
+		 * @param width ширна
+		 * @param height высота
+		 * @param x координата по оси X
+		 * @param y координата по оси Y
+		 * @throw invalid_argument в случае если размер data недостаточен
+		*/
+		void readDepth(ArrayView<float> data, int32_t width, int32_t height, int32_t x, int32_t y) const
+		{
+			_read(data.begin(), data.size(), static_cast<size_t>(width) * height, GL_NONE, width, height, x, y, GL_DEPTH_COMPONENT, GL_FLOAT);
+		}
+
+		/**
+		 * Метод необходимый для считывания значений из буфера трафарета.
+		 * Кадровый буфер должен иметь буфер трафарета.
+		 *
+		 * @param data массив куда будут записаны значения трафарета (его размер должен быть не меньше width * height)
+		 * @param width ширна
+		 * @param height высота
+		 * @param x координата по оси X
+		 * @param y координата по оси Y
+		 * @throw invalid_argument в случае если размер data недостаточен
+		*/
+		void readStencil(ArrayView<uint8_t> data, int32_t width, int32_t height, int32_t x, int32_t y) const
+		{
+			_read(data.begin(), data.size(), static_cast<size_t>(width) * height, GL_NONE, width, height, x, y, GL_STENCIL_INDEX, GL_UNSIGNED_BYTE);
+		}
+
 		TextureRenderer2D<Tf>& colorBuffer(size_t i)
 		{
 			return _colorBuffer.at(i);
@@ -195,6 +278,23 @@ namespace WOGL
 			return GL_INT;
 		}
 
+		void _read(void* data, size_t size, size_t requiredSize, GLenum readBuffer, int32_t width, int32_t height, int32_t x, int32_t y, GLenum format, GLenum type) const
+		{
+			if (width <= 0 || height <= 0 || size < requiredSize) {
+				throw invalid_argument("Data size is not enough for reading pixels");
+			}
+
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, _framebufferHandle);
+
+			if (readBuffer != GL_NONE) {
+				glReadBuffer(readBuffer);
+			}
+
+			glPixelStorei(GL_PACK_ALIGNMENT, 1);
+			glReadPixels(x, y, width, height, format, type, data);
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+		}
+
 		TextureRenderers _colorBuffer;
 		uint32_t _framebufferHandle;
 	};
@@ -248,6 +348,8 @@ namespace WOGL
 	 class Framebuffer<Tf, WritePixels::Texture, WritePixels::NoWrite> :
 	 	public BaseFramebuffer<Tf>
 	 {
+		friend class SinglePassDownsampler;
+
 	 public:
 	 	/**
 		 * Конструктор.
@@ -446,6 +548,8 @@ namespace WOGL
 	class Framebuffer<Tf, WritePixels::Texture, WritePixels::Texture> :
 		public BaseFramebuffer<Tf>
 	{
+		friend class SinglePassDownsampler;
+
 	public:
 		/**
 		 * Конструктор.
@@ -744,6 +848,8 @@ namespace WOGL
 	class ShadowMapRenderer :
 		public IFramebuffer
 	{
+		friend class SinglePassDownsampler;
+
 	public:
 		explicit ShadowMapRenderer()
 		{
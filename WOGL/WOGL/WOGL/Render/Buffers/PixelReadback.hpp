@@ -0,0 +1,44 @@
+//
+//  PixelReadback.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef PixelReadback_hpp
+#define PixelReadback_hpp
+
+#include <cstdint>
+
+namespace WOGL
+{
+    /**
+     * Прямоугольная область кадрового буфера.
+     *
+     * @field x координата левого нижнего угла по оси X
+     * @field y координата левого нижнего угла по оси Y
+     * @field width ширина
+     * @field height высота
+    */
+    struct PixelRect
+    {
+        int32_t x;
+        int32_t y;
+        int32_t width;
+        int32_t height;
+    };
+
+    /**
+     * Квитанция асинхронного чтения пикселей. Выдаётся при запросе чтения
+     * и используется для проверки его готовности и получения данных.
+    */
+    struct ReadbackTicket
+    {
+        uint64_t id;
+    };
+}
+
+#include "PixelReadback.inl"
+
+#endif /* PixelReadback_hpp */
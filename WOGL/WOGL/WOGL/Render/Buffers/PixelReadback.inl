@@ -0,0 +1,349 @@
+//
+//  PixelReadback.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <GL/glew.h>
+
+#include "Framebuffer.hpp"
+#include "../Texture/TextureRenderer2D.hpp"
+#include "../../Data/Texture2D.hpp"
+
+#include <cstring>
+
+#include <vector>
+
+#include <stdexcept>
+
+#include <type_traits>
+
+namespace WOGL
+{
+    /**
+     * Асинхронное чтение пикселей из кадровых буферов и текстур через кольцо
+     * буферов упаковки пикселей (GL_PIXEL_PACK_BUFFER).
+     *
+     * Запрос чтения только ставит копирование в очередь GPU и сразу возвращает квитанцию.
+     * Готовность данных проверяется через объект синхронизации, поэтому конвейер не останавливается.
+     * Если запросов больше, чем буферов в кольце, то самый старый не прочитанный запрос
+     * перезаписывается, а его квитанция становится недействительной.
+    */
+    class PixelReadback
+    {
+        struct Slot
+        {
+            uint32_t buffer;
+            size_t capacity;
+            size_t size;
+            GLsync fence;
+            uint64_t id;
+            GLenum texelType;
+            GLenum format;
+            GLenum type;
+            int32_t width;
+            int32_t height;
+        };
+
+    public:
+        /**
+         * Конструктор.
+         *
+         * @param ringSize количество буферов в кольце
+         * @throw invalid_argument в случае если ringSize равен нулю
+         * @throw runtime_error в случае если не удалось создать дескрипторы буферов
+        */
+        explicit PixelReadback(size_t ringSize = 3) :
+            _slots(ringSize),
+            _nextId{1}
+        {
+            if (!ringSize) {
+                throw invalid_argument("Ring size must be greater than zero");
+            }
+
+            for (auto& slot: _slots) {
+                slot = Slot{0, 0, 0, nullptr, 0, GL_NONE, GL_NONE, GL_NONE, 0, 0};
+                glGenBuffers(1, &slot.buffer);
+
+                if (!slot.buffer) {
+                    throw runtime_error("Error create pixel pack buffer handle");
+                }
+            }
+        }
+
+        PixelReadback(PixelReadback&& readback) :
+            _slots{move(readback._slots)},
+            _nextId{readback._nextId}
+        {
+        }
+
+        PixelReadback(const PixelReadback&) = delete;
+        PixelReadback& operator=(const PixelReadback&) = delete;
+        PixelReadback& operator=(PixelReadback&&) = delete;
+
+        virtual ~PixelReadback()
+        {
+            for (auto& slot: _slots) {
+                if (slot.fence) {
+                    glDeleteSync(slot.fence);
+                }
+
+                if (slot.buffer) {
+                    glDeleteBuffers(1, &slot.buffer);
+                }
+            }
+        }
+
+        /**
+         * Метод запрашивающий чтение прямоугольника из цветового буфера кадрового буфера.
+         * Для целочисленных форматов используется соответствующий формат пикселя *_INTEGER.
+         *
+         * @param framebuffer кадровый буфер
+         * @param rect прямоугольник
+         * @param attachment номер цветового буфера
+         * @template DataType тип каждого из каналов считываемых пикселей (например float)
+         * @template Tx тип текселя считываемых пикселей
+         * @return квитанция запроса
+        */
+        template<typename DataType = float, TexelType Tx = TexelType::RGB, TexelFormat Tf>
+        ReadbackTicket requestReadback(const BaseFramebuffer<Tf>& framebuffer, const PixelRect& rect, uint32_t attachment = 0)
+        {
+            static_assert(!isIntegerFormat(Tf) || is_integral_v<DataType>, "Integer texel format can be read only into integer data");
+
+            if (attachment >= framebuffer.numberOfColorBuffers()) {
+                throw out_of_range("Color attachment is out of range");
+            }
+
+            auto& slot = _acquire(rect.width, rect.height, static_cast<GLenum>(Tx), _pixelFormat(Tx, isIntegerFormat(Tf)),
+                                  BaseTextureRenderer::_type<DataType>(), sizeof(DataType) * numberOfChannels(Tx));
+
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer._framebufferHandle);
+            glReadBuffer(GL_COLOR_ATTACHMENT0 + attachment);
+            glReadPixels(rect.x, rect.y, rect.width, rect.height, slot.format, slot.type, nullptr);
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+            return _release(slot);
+        }
+
+        /**
+         * Метод запрашивающий чтение содержимого текстуры.
+         *
+         * @param texture текстура
+         * @template DataType тип каждого из каналов считываемых пикселей (например float)
+         * @template Tx тип текселя считываемых пикселей
+         * @return квитанция запроса
+        */
+        template<typename DataType, TexelType Tx, TexelFormat Tf>
+        ReadbackTicket requestReadback(const TextureRenderer2D<Tf>& texture)
+        {
+            static_assert(!isIntegerFormat(Tf) || is_integral_v<DataType>, "Integer texel format can be read only into integer data");
+
+            auto& slot = _acquire(texture.width(), texture.height(), static_cast<GLenum>(Tx), _pixelFormat(Tx, isIntegerFormat(Tf)),
+                                  BaseTextureRenderer::_type<DataType>(), sizeof(DataType) * numberOfChannels(Tx));
+
+            glBindTexture(GL_TEXTURE_2D, texture._textureRendererHandle);
+            glGetTexImage(GL_TEXTURE_2D, 0, slot.format, slot.type, nullptr);
+            glBindTexture(GL_TEXTURE_2D, 0);
+
+            return _release(slot);
+        }
+
+        /**
+         * Метод запрашивающий чтение прямоугольника из буфера глубины кадрового буфера.
+         * Данные читаются как float, по одному значению на пиксель.
+         *
+         * @param framebuffer кадровый буфер (должен иметь буфер глубины)
+         * @param rect прямоугольник
+         * @return квитанция запроса
+        */
+        template<TexelFormat Tf>
+        ReadbackTicket requestDepthReadback(const BaseFramebuffer<Tf>& framebuffer, const PixelRect& rect)
+        {
+            auto& slot = _acquire(rect.width, rect.height, GL_DEPTH_COMPONENT, GL_DEPTH_COMPONENT, GL_FLOAT, sizeof(float));
+
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer._framebufferHandle);
+            glReadPixels(rect.x, rect.y, rect.width, rect.height, slot.format, slot.type, nullptr);
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+            return _release(slot);
+        }
+
+        /**
+         * Метод проверяющий, готовы ли данные запроса. Не блокирует.
+         *
+         * @param ticket квитанция запроса
+         * @return true - если данные готовы, иначе false
+         * @throw out_of_range в случае если квитанция недействительна
+        */
+        bool ready(ReadbackTicket ticket) const
+        {
+            const auto& slot = _slot(ticket);
+            return glClientWaitSync(slot.fence, 0, 0) != GL_TIMEOUT_EXPIRED;
+        }
+
+        /**
+         * Метод копирующий данные запроса в data. Если данные не готовы, то метод ждёт их готовности.
+         * После чтения квитанция становится недействительной.
+         *
+         * @param ticket квитанция запроса
+         * @param data массив размером не меньше width * height * количество каналов
+         * @throw out_of_range в случае если квитанция недействительна
+         * @throw runtime_error в случае если не удалось отобразить буфер в память
+        */
+        template<typename DataType>
+        void read(ReadbackTicket ticket, DataType* data)
+        {
+            auto& slot = _slot(ticket);
+
+            if (BaseTextureRenderer::_type<DataType>() != slot.type) {
+                throw invalid_argument("Data type does not match the requested type");
+            }
+
+            _read(slot, data);
+        }
+
+        /**
+         * Метод копирующий данные запроса в текстуру. Если данные не готовы, то метод ждёт их готовности.
+         * После чтения квитанция становится недействительной.
+         *
+         * @param ticket квитанция запроса
+         * @param texture текстура, размер которой будет приведён к размеру прочитанной области
+         * @throw out_of_range в случае если квитанция недействительна
+         * @throw invalid_argument в случае если тип текстуры не совпадает с запрошенным
+         * @throw runtime_error в случае если не удалось отобразить буфер в память
+        */
+        template<typename DataType, TexelType Tx>
+        void read(ReadbackTicket ticket, Texture2D<DataType, Tx>& texture)
+        {
+            auto& slot = _slot(ticket);
+
+            if (BaseTextureRenderer::_type<DataType>() != slot.type || static_cast<GLenum>(Tx) != slot.texelType) {
+                throw invalid_argument("Texture type does not match the requested type");
+            }
+
+            texture._width = static_cast<size_t>(slot.width);
+            texture._height = static_cast<size_t>(slot.height);
+            texture._data.resize(texture._width * texture._height * texture._bpp);
+
+            _read(slot, &texture._data[0]);
+        }
+
+        size_t ringSize() const noexcept
+        {
+            return _slots.size();
+        }
+
+    private:
+        static GLenum _pixelFormat(TexelType tx, bool integer) noexcept
+        {
+            if (!integer) {
+                return static_cast<GLenum>(tx);
+            }
+
+            switch (tx) {
+                case TexelType::RED:
+                    return GL_RED_INTEGER;
+                case TexelType::RG:
+                    return GL_RG_INTEGER;
+                case TexelType::RGB:
+                    return GL_RGB_INTEGER;
+                default:
+                    return GL_RGBA_INTEGER;
+            }
+        }
+
+        Slot& _acquire(int32_t width, int32_t height, GLenum texelType, GLenum format, GLenum type, size_t bytesPerPixel)
+        {
+            if (width <= 0 || height <= 0) {
+                throw invalid_argument("Readback area is empty");
+            }
+
+            auto& slot = _slots[_nextId % _slots.size()];
+
+            if (slot.fence) {
+                glDeleteSync(slot.fence);
+                slot.fence = nullptr;
+            }
+
+            slot.id = _nextId++;
+            slot.texelType = texelType;
+            slot.format = format;
+            slot.type = type;
+            slot.width = width;
+            slot.height = height;
+            slot.size = static_cast<size_t>(width) * static_cast<size_t>(height) * bytesPerPixel;
+
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+
+            if (slot.capacity < slot.size) {
+                glBufferData(GL_PIXEL_PACK_BUFFER, slot.size, nullptr, GL_STREAM_READ);
+                slot.capacity = slot.size;
+            }
+
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+            return slot;
+        }
+
+        ReadbackTicket _release(Slot& slot)
+        {
+            slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+            return ReadbackTicket{slot.id};
+        }
+
+        Slot& _slot(ReadbackTicket ticket)
+        {
+            auto& slot = _slots[ticket.id % _slots.size()];
+
+            if (!ticket.id || slot.id != ticket.id) {
+                throw out_of_range("Readback ticket is expired");
+            }
+
+            return slot;
+        }
+
+        const Slot& _slot(ReadbackTicket ticket) const
+        {
+            const auto& slot = _slots[ticket.id % _slots.size()];
+
+            if (!ticket.id || slot.id != ticket.id) {
+                throw out_of_range("Readback ticket is expired");
+            }
+
+            return slot;
+        }
+
+        void _read(Slot& slot, void* data)
+        {
+            GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+
+            while (glClientWaitSync(slot.fence, flags, 1000000) == GL_TIMEOUT_EXPIRED) {
+                flags = 0;
+            }
+
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+            const void* ptr = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, slot.size, GL_MAP_READ_BIT);
+
+            if (!ptr) {
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                throw runtime_error("Error map pixel pack buffer");
+            }
+
+            memcpy(data, ptr, slot.size);
+
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+            slot.id = 0;
+        }
+
+        vector<Slot> _slots;
+        uint64_t _nextId;
+    };
+}
@@ -0,0 +1,14 @@
+//
+//  StagingBuffer.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef StagingBuffer_hpp
+#define StagingBuffer_hpp
+
+#include "StagingBuffer.inl"
+
+#endif /* StagingBuffer_hpp */
@@ -0,0 +1,256 @@
+//
+//  StagingBuffer.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include <deque>
+
+#include <algorithm>
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace WOGL
+{
+    /**
+     * Кольцевой буфер (GL_PIXEL_UNPACK_BUFFER) для асинхронной загрузки данных текстур.
+     *
+     * Данные копируются в отображённую память буфера, а загрузка в текстуру выполняется
+     * со смещения в буфере, поэтому драйверу не нужно синхронно копировать клиентскую память.
+     * Каждая загрузка защищается объектом синхронизации; область буфера переиспользуется
+     * только после того, как GPU закончит чтение из неё.
+     *
+     * При наличии GL_ARB_buffer_storage буфер отображается в память один раз (persistent mapping),
+     * иначе каждая область отображается с GL_MAP_UNSYNCHRONIZED_BIT.
+    */
+    class StagingBuffer
+    {
+        struct Region
+        {
+            size_t begin;
+            size_t end;
+            GLsync fence;
+        };
+
+    public:
+        /**
+         * Конструктор.
+         *
+         * @param capacity размер буфера в байтах
+         * @throw invalid_argument в случае если capacity равен нулю
+         * @throw runtime_error в случае если не удалось создать дескриптор буфера или отобразить его в память
+        */
+        explicit StagingBuffer(size_t capacity = 32 * 1024 * 1024) :
+            _capacity{capacity},
+            _head{0},
+            _ptr{nullptr},
+            _persistent{GLEW_ARB_buffer_storage != 0}
+        {
+            if (!capacity) {
+                throw invalid_argument("Staging buffer capacity must be greater than zero");
+            }
+
+            glGenBuffers(1, &_stagingBufferHandle);
+
+            if (!_stagingBufferHandle) {
+                throw runtime_error("Error create staging buffer handle");
+            }
+
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _stagingBufferHandle);
+
+            if (_persistent) {
+                constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+                glBufferStorage(GL_PIXEL_UNPACK_BUFFER, _capacity, nullptr, flags);
+                _ptr = static_cast<uint8_t*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, _capacity, flags));
+
+                if (!_ptr) {
+                    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                    glDeleteBuffers(1, &_stagingBufferHandle);
+                    throw runtime_error("Error map staging buffer");
+                }
+            } else {
+                glBufferData(GL_PIXEL_UNPACK_BUFFER, _capacity, nullptr, GL_STREAM_DRAW);
+            }
+
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+
+        StagingBuffer(StagingBuffer&& staging) :
+            _regions{move(staging._regions)},
+            _capacity{staging._capacity},
+            _head{staging._head},
+            _ptr{staging._ptr},
+            _persistent{staging._persistent},
+            _stagingBufferHandle{0}
+        {
+            swap(_stagingBufferHandle, staging._stagingBufferHandle);
+            staging._ptr = nullptr;
+        }
+
+        StagingBuffer(const StagingBuffer&) = delete;
+        StagingBuffer& operator=(const StagingBuffer&) = delete;
+        StagingBuffer& operator=(StagingBuffer&&) = delete;
+
+        virtual ~StagingBuffer()
+        {
+            for (auto& region: _regions) {
+                glDeleteSync(region.fence);
+            }
+
+            if (_stagingBufferHandle) {
+                if (_ptr) {
+                    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _stagingBufferHandle);
+                    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                }
+
+                glDeleteBuffers(1, &_stagingBufferHandle);
+            }
+        }
+
+        /**
+         * Метод копирующий данные в буфер и вызывающий функцию загрузки.
+         * Во время вызова upload буфер привязан к GL_PIXEL_UNPACK_BUFFER, а GL_UNPACK_ALIGNMENT равен 1.
+         * upload получает смещение данных в буфере в виде указателя,
+         * которое передаётся в glTexSubImage* вместо указателя на данные.
+         *
+         * @param data указатель на данные
+         * @param size размер данных в байтах
+         * @param upload функция загрузки (например вызывающая glTexSubImage2D)
+         * @throw invalid_argument в случае если size больше размера буфера
+         * @throw runtime_error в случае если не удалось отобразить область буфера в память
+        */
+        template<typename Upload>
+        void upload(const void* data, size_t size, Upload&& upload)
+        {
+            if (size > _capacity) {
+                throw invalid_argument("Data size exceeds staging buffer capacity");
+            }
+
+            size_t offset = _allocate(size);
+
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _stagingBufferHandle);
+
+            if (_persistent) {
+                memcpy(_ptr + offset, data, size);
+            } else {
+                constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+                void* ptr = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, offset, size, flags);
+
+                if (!ptr) {
+                    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                    throw runtime_error("Error map staging buffer");
+                }
+
+                memcpy(ptr, data, size);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            }
+
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            upload(reinterpret_cast<const void*>(offset));
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+            _regions.push_back(Region{offset, offset + size, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)});
+            _head = offset + size;
+        }
+
+        /**
+         * Метод ожидающий завершения всех загрузок.
+        */
+        void waitIdle()
+        {
+            while (!_regions.empty()) {
+                _waitFront();
+            }
+        }
+
+        size_t capacity() const noexcept
+        {
+            return _capacity;
+        }
+
+        /**
+         * Метод сообщающий, отображён ли буфер в память постоянно.
+         *
+         * @return true - если используется GL_ARB_buffer_storage, иначе false
+        */
+        bool persistent() const noexcept
+        {
+            return _persistent;
+        }
+
+        /**
+         * Метод возвращающий дескриптор буфера.
+         * Данный метод не сделан константным так как пользователь сможет повлиять на буфер с помощью функций OpenGL.
+         *
+         * @return дескриптор буфера
+        */
+        uint32_t id() noexcept
+        {
+            return _stagingBufferHandle;
+        }
+
+    private:
+        /**
+         * Метод выделяющий область размером size. Области выравниваются по 256 байт.
+         * Если область занята загрузкой, которую GPU ещё не выполнил, то метод ждёт её завершения.
+        */
+        size_t _allocate(size_t size)
+        {
+            constexpr size_t alignment = 256;
+
+            size_t begin = (_head + alignment - 1) & ~(alignment - 1);
+
+            if (begin + size > _capacity) {
+                begin = 0;
+
+                // При переходе в начало кольца все области после _head старше новых и должны освободиться первыми.
+                while (!_regions.empty() && _regions.front().begin >= _head) {
+                    _waitFront();
+                }
+            }
+
+            size_t end = begin + size;
+
+            auto overlaps = [begin, end] (const Region& region) {
+                return region.begin < end && begin < region.end;
+            };
+
+            while (any_of(_regions.begin(), _regions.end(), overlaps)) {
+                _waitFront();
+            }
+
+            return begin;
+        }
+
+        void _waitFront()
+        {
+            GLsync fence = _regions.front().fence;
+            GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+
+            while (glClientWaitSync(fence, flags, 1000000) == GL_TIMEOUT_EXPIRED) {
+                flags = 0;
+            }
+
+            glDeleteSync(fence);
+            _regions.pop_front();
+        }
+
+        deque<Region> _regions;
+        size_t _capacity;
+        size_t _head;
+        uint8_t* _ptr;
+        bool _persistent;
+        uint32_t _stagingBufferHandle;
+    };
+}
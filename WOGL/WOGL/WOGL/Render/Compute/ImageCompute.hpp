@@ -0,0 +1,97 @@
+//
+//  ImageCompute.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef ImageCompute_hpp
+#define ImageCompute_hpp
+
+#include "../Texture/TextureRenderer.hpp"
+
+namespace WOGL
+{
+    /**
+     * Операция уменьшения изображения.
+     *
+     * @field AVERAGE среднее по блоку 2x2 (2x2x2) для каждого канала
+     * @field MIN минимум по блоку для каждого канала
+     * @field MAX максимум по блоку для каждого канала
+     * @field MIN_MAX минимум записывается в красный канал, максимум - в зелёный (например для иерархического буфера глубины)
+     * @field LUMINANCE средняя яркость (Rec. 709) записывается во все каналы (например для автоматической экспозиции)
+    */
+    enum class ReduceOp
+    {
+        AVERAGE,
+        MIN,
+        MAX,
+        MIN_MAX,
+        LUMINANCE
+    };
+
+    /**
+     * Функция возвращающая спецификатор формата изображения в GLSL (layout(rgba16f) image2D).
+     *
+     * @param tf формат текселя
+     * @return спецификатор или nullptr, если формат нельзя использовать для записи из шейдера (RGB, sRGB и сжатые форматы)
+    */
+    constexpr const char* imageFormatQualifier(TexelFormat tf) noexcept
+    {
+        switch (tf) {
+            case TexelFormat::RGBA32_F: return "rgba32f";
+            case TexelFormat::RGBA16_F: return "rgba16f";
+            case TexelFormat::RGBA32_U: return "rgba32ui";
+            case TexelFormat::RGBA16_U: return "rgba16ui";
+            case TexelFormat::RGBA8_U: return "rgba8ui";
+            case TexelFormat::RGBA32_S: return "rgba32i";
+            case TexelFormat::RGBA16_S: return "rgba16i";
+            case TexelFormat::RGBA8_S: return "rgba8i";
+
+            case TexelFormat::RG32_F: return "rg32f";
+            case TexelFormat::RG16_F: return "rg16f";
+            case TexelFormat::RG32_U: return "rg32ui";
+            case TexelFormat::RG16_U: return "rg16ui";
+            case TexelFormat::RG8_U: return "rg8ui";
+            case TexelFormat::RG32_S: return "rg32i";
+            case TexelFormat::RG16_S: return "rg16i";
+            case TexelFormat::RG8_S: return "rg8i";
+
+            case TexelFormat::RED32_F: return "r32f";
+            case TexelFormat::RED16_F: return "r16f";
+            case TexelFormat::RED32_U: return "r32ui";
+            case TexelFormat::RED16_U: return "r16ui";
+            case TexelFormat::RED8_U: return "r8ui";
+            case TexelFormat::RED32_S: return "r32i";
+            case TexelFormat::RED16_S: return "r16i";
+            case TexelFormat::RED8_S: return "r8i";
+
+            case TexelFormat::RGBA8_UNORM: return "rgba8";
+            case TexelFormat::RG8_UNORM: return "rg8";
+            case TexelFormat::RED8_UNORM: return "r8";
+
+            default: return nullptr;
+        }
+    }
+    /**
+     * Функция возвращающая префикс типов сэмплера и изображения в GLSL для формата.
+     *
+     * @param tf формат текселя
+     * @return "u" - для беззнаковых целочисленных форматов, "i" - для знаковых, иначе пустая строка
+    */
+    constexpr const char* glslTypePrefix(TexelFormat tf) noexcept
+    {
+        if (!isIntegerFormat(tf)) {
+            return "";
+        }
+
+        const GLenum type = texelFormatType(tf);
+
+        return type == GL_UNSIGNED_INT || type == GL_UNSIGNED_SHORT || type == GL_UNSIGNED_BYTE ? "u" : "i";
+    }
+}
+
+#include "ImageCompute.inl"
+
+#endif /* ImageCompute_hpp */
@@ -0,0 +1,646 @@
+//
+//  ImageCompute.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <GL/glew.h>
+
+#include "../Shader.hpp"
+#include "../ShaderProgram.hpp"
+#include "../Texture/TextureRenderer2D.hpp"
+#include "../Texture/TextureRenderer3D.hpp"
+#include "../Texture/RenderTexturePool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace std;
+using namespace glm;
+
+namespace WOGL
+{
+    /**
+     * Обработка изображений вычислительными шейдерами: сепарабельное размытие Гаусса, билатеральное размытие
+     * с учётом глубины (например для SSAO), уменьшение в два раза (ReduceOp) и преобразование формата.
+     *
+     * В отличие от проходов с полноэкранным прямоугольником, не используются растеризация, фреймбуферы
+     * и фрагментный этап: источник читается через texelFetch, результат записывается через imageStore.
+     * Проходы размытия загружают строку (столбец) текселей с полями в разделяемую память рабочей группы,
+     * поэтому каждый тексель источника читается из текстуры один раз на группу.
+     *
+     * Источником может быть текстура любого формата, результатом - только текстура с форматом,
+     * для которого есть imageFormatQualifier (RGB, sRGB и сжатые форматы не поддерживаются).
+     * Промежуточные текстуры берутся из пула (pool()), шейдерные программы компилируются при первом использовании
+     * каждой комбинации форматов.
+     *
+     * Методы меняют текущую шейдерную программу и привязки к текстурным слотам 0 и 1 и к слоту изображения 0,
+     * поэтому BindingTracker после них нужно сбросить (reset).
+     * Требуется OpenGL 4.3: шейдеры используют #version 430 (layout(binding), imageSize), поэтому
+     * расширений GL_ARB_compute_shader и GL_ARB_shader_image_load_store в контексте более ранней версии недостаточно.
+    */
+    class ImageCompute
+    {
+    public:
+        /**
+         * Максимальный радиус ядра размытия (в текселях).
+        */
+        static constexpr int32_t MAX_BLUR_RADIUS = 32;
+
+        /**
+         * Конструктор.
+         *
+         * @throw runtime_error в случае если OpenGL 4.3 не поддерживается
+        */
+        ImageCompute()
+        {
+            if (!supported()) {
+                throw runtime_error("Compute shaders require OpenGL 4.3");
+            }
+        }
+
+        ImageCompute(const ImageCompute&) = delete;
+        ImageCompute& operator=(const ImageCompute&) = delete;
+        ImageCompute& operator=(ImageCompute&&) = delete;
+
+        /**
+         * @return true - если контекст поддерживает OpenGL 4.3 (вычислительные шейдеры и запись в изображения)
+        */
+        static bool supported() noexcept
+        {
+            return GLEW_VERSION_4_3 != 0;
+        }
+
+        /**
+         * Метод размывающий текстуру фильтром Гаусса (два прохода: по строкам и по столбцам).
+         * Источник и результат могут быть одной текстурой.
+         *
+         * @param source источник
+         * @param destination результат (того же размера)
+         * @param sigma среднеквадратичное отклонение в текселях (радиус ядра - ceil(3 * sigma))
+         * @throw invalid_argument в случае если размеры не совпадают или радиус больше MAX_BLUR_RADIUS
+        */
+        template<TexelFormat SrcTf, TexelFormat DstTf>
+        void gaussianBlur(const TextureRenderer2D<SrcTf>& source, TextureRenderer2D<DstTf>& destination, float sigma)
+        {
+            static_assert(imageFormatQualifier(DstTf), "Destination format cannot be used as an image");
+
+            _blur(source, nullptr, destination, sigma, 0.0f);
+        }
+
+        /**
+         * Метод размывающий текстуру с учётом глубины: вес соседнего текселя уменьшается с разницей глубин,
+         * поэтому размытие не переходит через границы объектов (например при размытии SSAO).
+         *
+         * @param source источник
+         * @param depth глубина (читается красный канал, того же размера, что и источник)
+         * @param destination результат (того же размера)
+         * @param sigma среднеквадратичное отклонение в текселях
+         * @param depthSigma среднеквадратичное отклонение по глубине
+         * @throw invalid_argument в случае если размеры не совпадают или радиус больше MAX_BLUR_RADIUS
+        */
+        template<TexelFormat SrcTf, TexelFormat DepthTf, TexelFormat DstTf>
+        void bilateralBlur(const TextureRenderer2D<SrcTf>& source, const TextureRenderer2D<DepthTf>& depth,
+                           TextureRenderer2D<DstTf>& destination, float sigma, float depthSigma)
+        {
+            static_assert(imageFormatQualifier(DstTf), "Destination format cannot be used as an image");
+            static_assert(!isIntegerFormat(DepthTf), "Depth texture must have a float or normalized format");
+
+            if (depth.width() != source.width() || depth.height() != source.height()) {
+                throw invalid_argument("Depth size does not match source size");
+            }
+
+            if (!(depthSigma > 0.0f)) {
+                throw invalid_argument("Depth sigma must be positive");
+            }
+
+            _blur(source, &depth, destination, sigma, 1.0f / (2.0f * depthSigma * depthSigma));
+        }
+
+        /**
+         * Метод уменьшающий текстуру в два раза по каждой оси (среднее, минимум или максимум по блоку 2x2).
+         * Если размер источника нечётный, последний тексель результата захватывает три текселя источника.
+         *
+         * Источник и результат могут быть одной текстурой (разными уровнями), так строится иерархический буфер глубины.
+         * Если sourceLevel больше нуля, то у источника открываются все уровни mipmap'а (GL_TEXTURE_MAX_LEVEL).
+         *
+         * @param source источник
+         * @param destination результат
+         * @param op операция (для MIN_MAX у многоканального источника максимум берётся из зелёного канала)
+         * @param sourceLevel уровень источника
+         * @param destinationLevel уровень результата
+         * @throw invalid_argument в случае если размер результата не равен половине размера источника
+        */
+        template<TexelFormat SrcTf, TexelFormat DstTf>
+        void downsample(const TextureRenderer2D<SrcTf>& source, TextureRenderer2D<DstTf>& destination, ReduceOp op,
+                        int32_t sourceLevel = 0, int32_t destinationLevel = 0)
+        {
+            static_assert(imageFormatQualifier(DstTf), "Destination format cannot be used as an image");
+
+            _checkLevel(sourceLevel, source.levels());
+            _checkLevel(destinationLevel, destination.levels());
+
+            const int32_t width = _levelSize(destination.width(), destinationLevel);
+            const int32_t height = _levelSize(destination.height(), destinationLevel);
+
+            if (width != _levelSize(source.width(), sourceLevel + 1) || height != _levelSize(source.height(), sourceLevel + 1)) {
+                throw invalid_argument("Destination size must be half of source size");
+            }
+
+            _downsample(GL_TEXTURE_2D, _handle(source), source.levels(), SrcTf, _handle(destination), DstTf,
+                        op, sourceLevel, destinationLevel, width, height, 1);
+        }
+
+        /**
+         * Метод уменьшающий трёхмерную текстуру в два раза по каждой оси (среднее, минимум или максимум по блоку 2x2x2).
+         *
+         * @param source источник
+         * @param destination результат
+         * @param op операция
+         * @param sourceLevel уровень источника
+         * @param destinationLevel уровень результата
+         * @throw invalid_argument в случае если размер результата не равен половине размера источника
+        */
+        template<TexelFormat SrcTf, TexelFormat DstTf>
+        void downsample(const TextureRenderer3D<SrcTf>& source, TextureRenderer3D<DstTf>& destination, ReduceOp op,
+                        int32_t sourceLevel = 0, int32_t destinationLevel = 0)
+        {
+            static_assert(imageFormatQualifier(DstTf), "Destination format cannot be used as an image");
+
+            _checkLevel(sourceLevel, source.levels());
+            _checkLevel(destinationLevel, destination.levels());
+
+            const int32_t width = _levelSize(destination.width(), destinationLevel);
+            const int32_t height = _levelSize(destination.height(), destinationLevel);
+            const int32_t depth = _levelSize(destination.depth(), destinationLevel);
+
+            if (width != _levelSize(source.width(), sourceLevel + 1) || height != _levelSize(source.height(), sourceLevel + 1) ||
+                depth != _levelSize(source.depth(), sourceLevel + 1)) {
+                throw invalid_argument("Destination size must be half of source size");
+            }
+
+            _downsample(GL_TEXTURE_3D, _handle(source), source.levels(), SrcTf, _handle(destination), DstTf,
+                        op, sourceLevel, destinationLevel, width, height, depth);
+        }
+
+        /**
+         * Метод преобразующий формат текстуры: result = source * scale + bias.
+         * Целочисленные каналы читаются и записываются без нормализации.
+         *
+         * @param source источник
+         * @param destination результат (того же размера)
+         * @param scale множитель
+         * @param bias смещение
+         * @param level уровень mipmap'а источника и результата
+         * @throw invalid_argument в случае если размеры не совпадают
+        */
+        template<TexelFormat SrcTf, TexelFormat DstTf>
+        void convert(const TextureRenderer2D<SrcTf>& source, TextureRenderer2D<DstTf>& destination,
+                     vec4 scale = vec4(1.0f), vec4 bias = vec4(0.0f), int32_t level = 0)
+        {
+            static_assert(imageFormatQualifier(DstTf), "Destination format cannot be used as an image");
+
+            _checkLevel(level, min(source.levels(), destination.levels()));
+
+            if (source.width() != destination.width() || source.height() != destination.height()) {
+                throw invalid_argument("Destination size does not match source size");
+            }
+
+            _convert(GL_TEXTURE_2D, _handle(source), source.levels(), SrcTf, _handle(destination), DstTf, scale, bias, level,
+                     _levelSize(source.width(), level), _levelSize(source.height(), level), 1);
+        }
+
+        /**
+         * Метод преобразующий формат трёхмерной текстуры: result = source * scale + bias.
+         *
+         * @param source источник
+         * @param destination результат (того же размера)
+         * @param scale множитель
+         * @param bias смещение
+         * @param level уровень mipmap'а источника и результата
+         * @throw invalid_argument в случае если размеры не совпадают
+        */
+        template<TexelFormat SrcTf, TexelFormat DstTf>
+        void convert(const TextureRenderer3D<SrcTf>& source, TextureRenderer3D<DstTf>& destination,
+                     vec4 scale = vec4(1.0f), vec4 bias = vec4(0.0f), int32_t level = 0)
+        {
+            static_assert(imageFormatQualifier(DstTf), "Destination format cannot be used as an image");
+
+            _checkLevel(level, min(source.levels(), destination.levels()));
+
+            if (source.width() != destination.width() || source.height() != destination.height() || source.depth() != destination.depth()) {
+                throw invalid_argument("Destination size does not match source size");
+            }
+
+            _convert(GL_TEXTURE_3D, _handle(source), source.levels(), SrcTf, _handle(destination), DstTf, scale, bias, level,
+                     _levelSize(source.width(), level), _levelSize(source.height(), level), _levelSize(source.depth(), level));
+        }
+
+        /**
+         * @return пул промежуточных текстур
+        */
+        RenderTexturePool& pool() noexcept
+        {
+            return _pool;
+        }
+
+        /**
+         * @return количество скомпилированных шейдерных программ
+        */
+        size_t numberOfPrograms() const noexcept
+        {
+            return _programs.size();
+        }
+
+    private:
+        template<TexelFormat SrcTf, TexelFormat DstTf>
+        void _blur(const TextureRenderer2D<SrcTf>& source, const BaseTextureRenderer2D* depth,
+                   TextureRenderer2D<DstTf>& destination, float sigma, float depthFactor)
+        {
+            if (source.width() != destination.width() || source.height() != destination.height()) {
+                throw invalid_argument("Destination size does not match source size");
+            }
+
+            if (!(sigma > 0.0f)) {
+                throw invalid_argument("Sigma must be positive");
+            }
+
+            const auto radius = static_cast<int32_t>(ceil(3.0f * sigma));
+
+            if (radius > MAX_BLUR_RADIUS) {
+                throw invalid_argument("Blur radius is too large");
+            }
+
+            vector<float> weights (radius + 1);
+
+            for (int32_t i{0}; i <= radius; i++) {
+                weights[i] = exp(-0.5f * static_cast<float>(i * i) / (sigma * sigma));
+            }
+
+            // Промежуточный результат хранится в формате результата, поэтому второй проход не зависит от формата источника.
+            auto intermediate = _pool.get<DstTf>(source.width(), source.height());
+            const uint32_t depthHandle = depth ? _handle(*depth) : 0;
+            const TexelFormat depthFormat = depth ? depth->texelFormat() : TexelFormat::RED32_F;
+
+            _blurPass(true, _handle(source), SrcTf, depthHandle, depthFormat, _handle(*intermediate), DstTf,
+                      weights, depthFactor, source.width(), source.height());
+            _blurPass(false, _handle(*intermediate), DstTf, depthHandle, depthFormat, _handle(destination), DstTf,
+                      weights, depthFactor, source.width(), source.height());
+        }
+
+        void _blurPass(bool horizontal, uint32_t source, TexelFormat sourceFormat, uint32_t depth, TexelFormat depthFormat,
+                       uint32_t destination, TexelFormat destinationFormat, const vector<float>& weights, float depthFactor,
+                       int32_t width, int32_t height)
+        {
+            string defines = _defines(sourceFormat, destinationFormat, false);
+            defines += horizontal ? "#define TILE_X 128\n#define TILE_Y 1\n" : "#define TILE_X 1\n#define TILE_Y 128\n";
+            defines += "#define MAX_RADIUS " + to_string(MAX_BLUR_RADIUS) + "\n";
+
+            if (depth) {
+                defines += "#define BILATERAL\n#define DEPTH_TYPE " + _samplerType(depthFormat, false) + "\n";
+            }
+
+            const ShaderProgram& program = _program("blur", _BLUR_SHADER, defines);
+
+            program.use();
+            program.setUniform("uWeights", weights);
+            program.setUniform("uRadius", static_cast<int32_t>(weights.size()) - 1);
+
+            _bindSource(0, GL_TEXTURE_2D, source);
+
+            if (depth) {
+                program.setUniform("uDepthFactor", depthFactor);
+                _bindSource(1, GL_TEXTURE_2D, depth);
+            }
+
+            glBindImageTexture(0, destination, 0, GL_FALSE, 0, GL_WRITE_ONLY, static_cast<GLenum>(destinationFormat));
+
+            if (horizontal) {
+                _dispatch(_groups(width, 128), height, 1);
+            } else {
+                _dispatch(width, _groups(height, 128), 1);
+            }
+        }
+
+        void _downsample(GLenum target, uint32_t source, int32_t sourceLevels, TexelFormat sourceFormat,
+                         uint32_t destination, TexelFormat destinationFormat, ReduceOp op, int32_t sourceLevel, int32_t destinationLevel,
+                         int32_t width, int32_t height, int32_t depth)
+        {
+            const bool volume = target == GL_TEXTURE_3D;
+            string defines = _defines(sourceFormat, destinationFormat, volume);
+
+            defines += _reduceDefine(op);
+
+            const ShaderProgram& program = _program("downsample", _DOWNSAMPLE_SHADER, defines);
+
+            program.use();
+            program.setUniform("uSourceLevel", sourceLevel);
+            program.setUniform("uMaxChannel", numberOfChannels(sourceFormat) > 1 ? 1 : 0);
+
+            _bindSource(0, target, source);
+
+            if (sourceLevel > 0) {
+                glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, sourceLevels - 1);
+            }
+
+            glBindImageTexture(0, destination, destinationLevel, volume ? GL_TRUE : GL_FALSE, 0, GL_WRITE_ONLY, static_cast<GLenum>(destinationFormat));
+
+            _dispatch(_groups(width, volume ? 4 : 8), _groups(height, volume ? 4 : 8), volume ? _groups(depth, 4) : 1);
+        }
+
+        void _convert(GLenum target, uint32_t source, int32_t sourceLevels, TexelFormat sourceFormat,
+                      uint32_t destination, TexelFormat destinationFormat, vec4 scale, vec4 bias, int32_t level,
+                      int32_t width, int32_t height, int32_t depth)
+        {
+            const bool volume = target == GL_TEXTURE_3D;
+            const ShaderProgram& program = _program("convert", _CONVERT_SHADER, _defines(sourceFormat, destinationFormat, volume));
+
+            program.use();
+            program.setUniform("uSourceLevel", level);
+            program.setUniform("uScale", scale);
+            program.setUniform("uBias", bias);
+
+            _bindSource(0, target, source);
+
+            if (level > 0) {
+                glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, sourceLevels - 1);
+            }
+
+            glBindImageTexture(0, destination, level, volume ? GL_TRUE : GL_FALSE, 0, GL_WRITE_ONLY, static_cast<GLenum>(destinationFormat));
+
+            _dispatch(_groups(width, volume ? 4 : 8), _groups(height, volume ? 4 : 8), volume ? _groups(depth, 4) : 1);
+        }
+
+        /**
+         * Метод возвращающий программу, скомпилированную из тела шейдера и определений (при первом вызове программа компилируется).
+        */
+        const ShaderProgram& _program(const string& name, const char* body, const string& defines)
+        {
+            const string key = name + "\n" + defines;
+
+            if (auto it = _programs.find(key); it != _programs.end()) {
+                return *it->second;
+            }
+
+            auto shader = Shader<ShaderTypes::COMPUTE>::fromSource("#version 430 core\n" + defines + _COMMON_SHADER + body);
+            auto program = make_unique<ShaderProgram>();
+
+            program->add(shader);
+            program->link();
+
+            return *_programs.emplace(key, move(program)).first->second;
+        }
+
+        /**
+         * Метод формирующий определения типов источника и результата для шейдера.
+        */
+        static string _defines(TexelFormat source, TexelFormat destination, bool volume)
+        {
+            string defines = volume ? "#define DIM3\n" : "";
+
+            defines += "#define SOURCE_TYPE " + _samplerType(source, volume) + "\n";
+            defines += "#define IMAGE_FORMAT " + string(imageFormatQualifier(destination)) + "\n";
+            defines += "#define IMAGE_TYPE " + string(glslTypePrefix(destination)) + (volume ? "image3D\n" : "image2D\n");
+
+            if (!isIntegerFormat(destination)) {
+                defines += "#define STORE(v) (v)\n";
+            } else if (glslTypePrefix(destination)[0] == 'u') {
+                defines += "#define STORE(v) uvec4(max(round(v), 0.0))\n";
+            } else {
+                defines += "#define STORE(v) ivec4(round(v))\n";
+            }
+
+            return defines;
+        }
+
+        static const char* _reduceDefine(ReduceOp op) noexcept
+        {
+            switch (op) {
+                case ReduceOp::AVERAGE: return "#define REDUCE_AVERAGE\n";
+                case ReduceOp::MIN: return "#define REDUCE_MIN\n";
+                case ReduceOp::MAX: return "#define REDUCE_MAX\n";
+                case ReduceOp::MIN_MAX: return "#define REDUCE_MIN_MAX\n";
+                case ReduceOp::LUMINANCE: return "#define REDUCE_LUMINANCE\n";
+            }
+
+            return "";
+        }
+
+        static string _samplerType(TexelFormat tf, bool volume)
+        {
+            return string(glslTypePrefix(tf)) + (volume ? "sampler3D" : "sampler2D");
+        }
+
+        static void _bindSource(int32_t slot, GLenum target, uint32_t handle) noexcept
+        {
+            glActiveTexture(GL_TEXTURE0 + slot);
+            glBindTexture(target, handle);
+            glBindSampler(slot, 0);
+        }
+
+        /**
+         * Метод запускающий вычисления и делающий их результат видимым для последующих выборок, записей и копирований.
+        */
+        static void _dispatch(uint32_t x, uint32_t y, uint32_t z) noexcept
+        {
+            glDispatchCompute(x, y, z);
+            glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT |
+                            GL_TEXTURE_UPDATE_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT | GL_PIXEL_BUFFER_BARRIER_BIT);
+        }
+
+        static uint32_t _groups(int32_t size, int32_t groupSize) noexcept
+        {
+            return static_cast<uint32_t>((size + groupSize - 1) / groupSize);
+        }
+
+        static int32_t _levelSize(int32_t size, int32_t level) noexcept
+        {
+            return max(size >> level, 1);
+        }
+
+        static void _checkLevel(int32_t level, int32_t levels)
+        {
+            if (level < 0 || level >= levels) {
+                throw invalid_argument("Invalid mip level");
+            }
+        }
+
+        static uint32_t _handle(const BaseTextureRenderer& texture) noexcept
+        {
+            return texture._textureRendererHandle;
+        }
+
+        static constexpr const char* _COMMON_SHADER = R"(
+#ifdef DIM3
+    #define IVEC ivec3
+    #define POSITION ivec3(gl_GlobalInvocationID)
+    #define TEXEL(x, y, z) ivec3(x, y, z)
+    #define Z(v) (v).z
+#else
+    #define IVEC ivec2
+    #define POSITION ivec2(gl_GlobalInvocationID.xy)
+    #define TEXEL(x, y, z) ivec2(x, y)
+    #define Z(v) 0
+#endif
+
+layout(binding = 0) uniform SOURCE_TYPE uSource;
+layout(IMAGE_FORMAT, binding = 0) writeonly uniform IMAGE_TYPE uDestination;
+)";
+
+        static constexpr const char* _BLUR_SHADER = R"(
+#define TILE (TILE_X * TILE_Y)
+
+layout(local_size_x = TILE_X, local_size_y = TILE_Y) in;
+
+const ivec2 DIRECTION = ivec2(TILE_X > 1 ? 1 : 0, TILE_Y > 1 ? 1 : 0);
+
+uniform float uWeights[MAX_RADIUS + 1];
+uniform int uRadius;
+
+shared vec4 tile[TILE + 2 * MAX_RADIUS];
+
+#ifdef BILATERAL
+layout(binding = 1) uniform DEPTH_TYPE uDepth;
+uniform float uDepthFactor;
+
+shared float depthTile[TILE + 2 * MAX_RADIUS];
+#endif
+
+void main()
+{
+    ivec2 size = textureSize(uSource, 0);
+    ivec2 position = ivec2(gl_GlobalInvocationID.xy);
+    int index = int(gl_LocalInvocationIndex);
+    ivec2 origin = ivec2(gl_WorkGroupID.xy * gl_WorkGroupSize.xy) - DIRECTION * uRadius;
+
+    for (int i = index; i < TILE + 2 * uRadius; i += TILE) {
+        ivec2 p = clamp(origin + DIRECTION * i, ivec2(0), size - 1);
+        tile[i] = vec4(texelFetch(uSource, p, 0));
+#ifdef BILATERAL
+        depthTile[i] = texelFetch(uDepth, p, 0).r;
+#endif
+    }
+
+    barrier();
+
+    if (any(greaterThanEqual(position, size))) {
+        return;
+    }
+
+    int center = index + uRadius;
+    vec4 sum = tile[center] * uWeights[0];
+    float total = uWeights[0];
+
+    for (int i = 1; i <= uRadius; i++) {
+        float left = uWeights[i];
+        float right = uWeights[i];
+#ifdef BILATERAL
+        float dl = depthTile[center - i] - depthTile[center];
+        float dr = depthTile[center + i] - depthTile[center];
+        left *= exp(-dl * dl * uDepthFactor);
+        right *= exp(-dr * dr * uDepthFactor);
+#endif
+        sum += tile[center - i] * left + tile[center + i] * right;
+        total += left + right;
+    }
+
+    imageStore(uDestination, position, STORE(sum / total));
+}
+)";
+
+        static constexpr const char* _DOWNSAMPLE_SHADER = R"(
+#ifdef DIM3
+layout(local_size_x = 4, local_size_y = 4, local_size_z = 4) in;
+#else
+layout(local_size_x = 8, local_size_y = 8) in;
+#endif
+
+uniform int uSourceLevel;
+uniform int uMaxChannel;
+
+void main()
+{
+    IVEC size = imageSize(uDestination);
+    IVEC position = POSITION;
+
+    if (any(greaterThanEqual(position, size))) {
+        return;
+    }
+
+    IVEC sourceSize = textureSize(uSource, uSourceLevel);
+    IVEC first = min(position * 2, sourceSize - 1);
+    IVEC last = min(position * 2 + 1 + IVEC(equal(position, size - 1)) * (sourceSize & 1), sourceSize - 1);
+
+    vec4 minimum = vec4(3.402823e38);
+    vec4 maximum = vec4(-3.402823e38);
+    vec4 sum = vec4(0.0);
+    float count = 0.0;
+
+    for (int z = Z(first); z <= Z(last); z++) {
+        for (int y = first.y; y <= last.y; y++) {
+            for (int x = first.x; x <= last.x; x++) {
+                vec4 value = vec4(texelFetch(uSource, TEXEL(x, y, z), uSourceLevel));
+                minimum = min(minimum, value);
+                maximum = max(maximum, value);
+                sum += value;
+                count += 1.0;
+            }
+        }
+    }
+
+#if defined(REDUCE_AVERAGE)
+    vec4 result = sum / count;
+#elif defined(REDUCE_MIN)
+    vec4 result = minimum;
+#elif defined(REDUCE_MAX)
+    vec4 result = maximum;
+#elif defined(REDUCE_LUMINANCE)
+    vec4 result = vec4(dot(sum.rgb / count, vec3(0.2126, 0.7152, 0.0722)));
+#else
+    vec4 result = vec4(minimum.r, maximum[uMaxChannel], 0.0, 1.0);
+#endif
+
+    imageStore(uDestination, position, STORE(result));
+}
+)";
+
+        static constexpr const char* _CONVERT_SHADER = R"(
+#ifdef DIM3
+layout(local_size_x = 4, local_size_y = 4, local_size_z = 4) in;
+#else
+layout(local_size_x = 8, local_size_y = 8) in;
+#endif
+
+uniform int uSourceLevel;
+uniform vec4 uScale;
+uniform vec4 uBias;
+
+void main()
+{
+    IVEC position = POSITION;
+
+    if (any(greaterThanEqual(position, imageSize(uDestination)))) {
+        return;
+    }
+
+    vec4 value = vec4(texelFetch(uSource, position, uSourceLevel));
+    imageStore(uDestination, position, STORE(value * uScale + uBias));
+}
+)";
+
+        RenderTexturePool _pool;
+        unordered_map<string, unique_ptr<ShaderProgram>> _programs;
+    };
+}
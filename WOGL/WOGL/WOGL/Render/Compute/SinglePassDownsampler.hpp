@@ -0,0 +1,14 @@
+//
+//  SinglePassDownsampler.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef SinglePassDownsampler_hpp
+#define SinglePassDownsampler_hpp
+
+#include "SinglePassDownsampler.inl"
+
+#endif /* SinglePassDownsampler_hpp */
@@ -0,0 +1,610 @@
+//
+//  SinglePassDownsampler.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <GL/glew.h>
+
+#include "ImageCompute.hpp"
+#include "../Shader.hpp"
+#include "../ShaderProgram.hpp"
+#include "../Texture/TextureRenderer2D.hpp"
+#include "../Texture/Sampler.hpp"
+#include "../Buffers/Framebuffer.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+#include <string>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace std;
+
+namespace WOGL
+{
+    /**
+     * Построение всей mipmap-цепочки одним запуском вычислительного шейдера (по схеме single pass downsampler).
+     *
+     * В отличие от genMipmap (glGenerateMipmap), операция уменьшения задаётся (ReduceOp): среднее,
+     * минимум и максимум (иерархический буфер глубины), яркость (автоматическая экспозиция).
+     *
+     * Каждая рабочая группа уменьшает свой блок 64x64 текселя до уровня 6 (1x1), храня промежуточные уровни
+     * в разделяемой памяти. Последняя завершившаяся группа (её определяет глобальный атомарный счётчик)
+     * строит из уровня 6 оставшиеся уровни, поэтому между уровнями не нужны отдельные запуски и барьеры.
+     * Размеры уровней считаются как у OpenGL (floor), и при нечётном размере последний тексель уровня
+     * захватывает остаток предыдущего, поэтому минимум и максимум остаются консервативными.
+     *
+     * Один запуск строит до 12 уровней, но каждому уровню нужен свой слот изображения.
+     * Если слотов меньше (GL_MAX_COMPUTE_IMAGE_UNIFORMS, обычно от 8), цепочка строится несколькими запусками,
+     * каждый из которых продолжает с последнего построенного уровня.
+     *
+     * Методы меняют текущую шейдерную программу, привязку к текстурному слоту 0 и к слотам изображений,
+     * поэтому BindingTracker после них нужно сбросить (reset).
+     * Требуется OpenGL 4.3: кроме вычислительных шейдеров и записи в изображения, счётчик групп хранится
+     * в буфере хранения (GL_SHADER_STORAGE_BUFFER), а шейдер использует #version 430.
+    */
+    class SinglePassDownsampler
+    {
+    public:
+        /**
+         * Максимальное количество уровней, строящихся за один запуск.
+        */
+        static constexpr int32_t MAX_LEVELS_PER_DISPATCH = 12;
+
+        /**
+         * Конструктор.
+         *
+         * @throw runtime_error в случае если OpenGL 4.3 не поддерживается или не удалось создать буфер счётчика
+        */
+        SinglePassDownsampler() :
+            _sampler{_samplerDescription()}
+        {
+            if (!supported()) {
+                throw runtime_error("Single pass downsampler requires OpenGL 4.3");
+            }
+
+            glGenBuffers(1, &_counterHandle);
+
+            if (!_counterHandle) {
+                throw runtime_error("Error create counter buffer");
+            }
+
+            const uint32_t zero = 0;
+
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, _counterHandle);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(zero), &zero, GL_DYNAMIC_DRAW);
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+            int32_t computeImages = 0;
+            int32_t imageUnits = 0;
+
+            glGetIntegerv(GL_MAX_COMPUTE_IMAGE_UNIFORMS, &computeImages);
+            glGetIntegerv(GL_MAX_IMAGE_UNITS, &imageUnits);
+
+            _maxImages = max(min(computeImages, imageUnits), 2);
+        }
+
+        SinglePassDownsampler(const SinglePassDownsampler&) = delete;
+        SinglePassDownsampler& operator=(const SinglePassDownsampler&) = delete;
+        SinglePassDownsampler& operator=(SinglePassDownsampler&&) = delete;
+
+        ~SinglePassDownsampler()
+        {
+            if (_counterHandle) {
+                glDeleteBuffers(1, &_counterHandle);
+            }
+        }
+
+        /**
+         * @return true - если контекст поддерживает OpenGL 4.3 (вычислительные шейдеры, запись в изображения и буферы хранения)
+        */
+        static bool supported() noexcept
+        {
+            return GLEW_VERSION_4_3 != 0;
+        }
+
+        /**
+         * Метод строящий уровни mipmap'а текстуры из нулевого уровня.
+         *
+         * @param texture текстура
+         * @param op операция уменьшения
+         * @param levels количество уровней цепочки вместе с нулевым (0 - все выделенные уровни)
+         * @throw invalid_argument в случае если levels больше количества выделенных уровней
+        */
+        template<TexelFormat Tf>
+        void generate(TextureRenderer2D<Tf>& texture, ReduceOp op = ReduceOp::AVERAGE, int32_t levels = 0)
+        {
+            static_assert(imageFormatQualifier(Tf), "Texture format cannot be used as an image");
+
+            _run(_handle(texture), Tf, texture.width(), texture.height(), true, _handle(texture), Tf, texture.levels(), op, levels);
+        }
+
+        /**
+         * Метод строящий цепочку в другой текстуре: в нулевой уровень записывается источник (после операции,
+         * например яркость или пара минимум/максимум), в остальные - уменьшенные уровни.
+         *
+         * @param source источник (любого формата, читается нулевой уровень)
+         * @param destination результат того же размера
+         * @param op операция уменьшения
+         * @param levels количество уровней цепочки (0 - все выделенные уровни результата)
+         * @throw invalid_argument в случае если размеры не совпадают или levels больше количества выделенных уровней
+        */
+        template<TexelFormat SrcTf, TexelFormat DstTf>
+        void generate(const TextureRenderer2D<SrcTf>& source, TextureRenderer2D<DstTf>& destination, ReduceOp op, int32_t levels = 0)
+        {
+            static_assert(imageFormatQualifier(DstTf), "Destination format cannot be used as an image");
+
+            _checkSize(source.width(), source.height(), destination);
+            _run(_handle(source), SrcTf, source.width(), source.height(), false, _handle(destination), DstTf, destination.levels(), op, levels);
+        }
+
+        /**
+         * Метод строящий цепочку по текстуре глубины кадрового буфера (например иерархический буфер глубины
+         * с операцией MIN_MAX и форматом результата RG32_F).
+         *
+         * @param framebuffer кадровый буфер
+         * @param destination результат того же размера
+         * @param op операция уменьшения
+         * @param levels количество уровней цепочки (0 - все выделенные уровни результата)
+         * @throw invalid_argument в случае если размеры не совпадают или levels больше количества выделенных уровней
+        */
+        template<TexelFormat Tf, TexelFormat DstTf>
+        void generate(const Framebuffer<Tf, WritePixels::Texture, WritePixels::NoWrite>& framebuffer, TextureRenderer2D<DstTf>& destination,
+                      ReduceOp op, int32_t levels = 0)
+        {
+            _generateFromDepth(framebuffer._depthTextureHandle, destination, op, levels);
+        }
+
+        template<TexelFormat Tf, TexelFormat DstTf>
+        void generate(const Framebuffer<Tf, WritePixels::Texture, WritePixels::Texture>& framebuffer, TextureRenderer2D<DstTf>& destination,
+                      ReduceOp op, int32_t levels = 0)
+        {
+            _generateFromDepth(framebuffer._depthAndStencilTextureHandle, destination, op, levels);
+        }
+
+        template<uint8_t NumberOfBitsPerFragment, int32_t Width, int32_t Height, TexelFormat DstTf>
+        void generate(const ShadowMapRenderer<NumberOfBitsPerFragment, Width, Height>& shadowMap, TextureRenderer2D<DstTf>& destination,
+                      ReduceOp op, int32_t levels = 0)
+        {
+            _generateFromDepth(shadowMap._depthTextureHandle, destination, op, levels);
+        }
+
+        /**
+         * @return количество запусков, выполненных при последнем построении цепочки
+        */
+        int32_t numberOfDispatches() const noexcept
+        {
+            return _numberOfDispatches;
+        }
+
+        /**
+         * @return количество скомпилированных шейдерных программ
+        */
+        size_t numberOfPrograms() const noexcept
+        {
+            return _programs.size();
+        }
+
+    private:
+        static SamplerDescription _samplerDescription() noexcept
+        {
+            SamplerDescription description;
+            description.minFilter = TextureFilter::NEAREST;
+            description.magFilter = TextureFilter::NEAREST;
+            description.wrappingS = TextureWrapping::CLAMP_TO_EDGE;
+            description.wrappingT = TextureWrapping::CLAMP_TO_EDGE;
+
+            return description;
+        }
+
+        template<TexelFormat DstTf>
+        void _generateFromDepth(uint32_t depth, TextureRenderer2D<DstTf>& destination, ReduceOp op, int32_t levels)
+        {
+            static_assert(imageFormatQualifier(DstTf), "Destination format cannot be used as an image");
+
+            int32_t width = 0;
+            int32_t height = 0;
+
+            glBindTexture(GL_TEXTURE_2D, depth);
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+            glBindTexture(GL_TEXTURE_2D, 0);
+
+            _checkSize(width, height, destination);
+
+            // Текстура глубины читается как обычная текстура с плавающей точкой (сэмплер отключает сравнение).
+            _run(depth, TexelFormat::RED32_F, width, height, false, _handle(destination), DstTf, destination.levels(), op, levels);
+        }
+
+        void _run(uint32_t source, TexelFormat sourceFormat, int32_t width, int32_t height, bool inPlace,
+                  uint32_t destination, TexelFormat destinationFormat, int32_t destinationLevels, ReduceOp op, int32_t levels)
+        {
+            if (levels <= 0) {
+                levels = destinationLevels;
+            }
+
+            if (levels > destinationLevels) {
+                throw invalid_argument("Number of levels exceeds allocated levels");
+            }
+
+            glBindTexture(GL_TEXTURE_2D, destination);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+            glBindTexture(GL_TEXTURE_2D, 0);
+
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, _counterHandle);
+
+            _numberOfDispatches = 0;
+
+            bool writeInput = !inPlace;
+            bool prepare = true;
+
+            for (int32_t level{0}; level < levels - 1 || writeInput;) {
+                const int32_t inputWidth = max(width >> level, 1);
+                const int32_t inputHeight = max(height >> level, 1);
+
+                // Оставшиеся уровни строит одна рабочая группа, которая обрабатывает уровень 6 целиком (до 127x127).
+                const int32_t maxCount = max(inputWidth, inputHeight) < 8192 ? MAX_LEVELS_PER_DISPATCH : 6;
+
+                // Уровень base + r привязывается к слоту r (слот 0 - запись входного уровня), поэтому слотов нужно count + 1.
+                const int32_t count = min({levels - 1 - level, maxCount, _maxImages - 1});
+
+                const ShaderProgram& program = _program(sourceFormat, destinationFormat, op, count, writeInput);
+
+                program.use();
+                program.setUniform("uInputLevel", level);
+                program.setUniform("uInputSize", ivec2(inputWidth, inputHeight));
+                program.setUniform("uMaxChannel", numberOfChannels(sourceFormat) > 1 ? 1 : 0);
+                program.setUniform("uPrepare", prepare ? 1 : 0);
+
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_2D, source);
+                _sampler.bind(0);
+
+                for (int32_t r{writeInput ? 0 : 1}; r <= count; r++) {
+                    glBindImageTexture(r, destination, level + r, GL_FALSE, 0, r == 6 && count > 6 ? GL_READ_WRITE : GL_WRITE_ONLY,
+                                       static_cast<GLenum>(destinationFormat));
+                }
+
+                glDispatchCompute(static_cast<uint32_t>(max(inputWidth >> 6, 1)), static_cast<uint32_t>(max(inputHeight >> 6, 1)), 1);
+                glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT |
+                                GL_TEXTURE_UPDATE_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT | GL_PIXEL_BUFFER_BARRIER_BIT);
+
+                _numberOfDispatches++;
+
+                // Следующий запуск продолжает с последнего построенного уровня результата.
+                level += count;
+                source = destination;
+                sourceFormat = destinationFormat;
+                writeInput = false;
+                prepare = false;
+            }
+
+            Sampler::unbind(0);
+        }
+
+        const ShaderProgram& _program(TexelFormat source, TexelFormat destination, ReduceOp op, int32_t count, bool writeInput)
+        {
+            const string prefix = glslTypePrefix(destination);
+
+            string defines = "#define SOURCE_TYPE " + string(glslTypePrefix(source)) + "sampler2D\n";
+            defines += "#define COUNT " + to_string(count) + "\n";
+
+            switch (op) {
+                case ReduceOp::AVERAGE: defines += "#define REDUCE_AVERAGE\n"; break;
+                case ReduceOp::MIN: defines += "#define REDUCE_MIN\n"; break;
+                case ReduceOp::MAX: defines += "#define REDUCE_MAX\n"; break;
+                case ReduceOp::MIN_MAX: defines += "#define REDUCE_MIN_MAX\n"; break;
+                case ReduceOp::LUMINANCE: defines += "#define REDUCE_LUMINANCE\n"; break;
+            }
+
+            if (writeInput) {
+                defines += "#define WRITE_INPUT\n";
+            }
+
+            if (count > 6) {
+                defines += "#define TAIL\n";
+            }
+
+            if (!isIntegerFormat(destination)) {
+                defines += "#define STORE(v) (v)\n";
+            } else if (prefix == "u") {
+                defines += "#define STORE(v) uvec4(max(round(v), 0.0))\n";
+            } else {
+                defines += "#define STORE(v) ivec4(round(v))\n";
+            }
+
+            // Каждый уровень объявляется отдельным изображением (индексировать массив изображений можно только
+            // динамически однородным выражением), выбор изображения по номеру уровня выполняется через switch.
+            string images;
+            string store = "void storeLevel(int level, ivec2 p, vec4 v)\n{\n    switch (level) {\n";
+
+            for (int32_t r{writeInput ? 0 : 1}; r <= count; r++) {
+                const string name = "uLevel" + to_string(r);
+                const char* access = r == 6 && count > 6 ? "coherent" : "writeonly";
+
+                images += "layout(" + string(imageFormatQualifier(destination)) + ", binding = " + to_string(r) + ") " + access +
+                          " uniform " + prefix + "image2D " + name + ";\n";
+                store += "        case " + to_string(r) + ": imageStore(" + name + ", p, STORE(v)); break;\n";
+            }
+
+            store += "    }\n}\n";
+
+            const string key = defines + prefix + imageFormatQualifier(destination);
+
+            if (auto it = _programs.find(key); it != _programs.end()) {
+                return *it->second;
+            }
+
+            auto shader = Shader<ShaderTypes::COMPUTE>::fromSource("#version 430 core\n" + defines + images + store + _SHADER);
+            auto program = make_unique<ShaderProgram>();
+
+            program->add(shader);
+            program->link();
+
+            return *_programs.emplace(key, move(program)).first->second;
+        }
+
+        template<TexelFormat DstTf>
+        static void _checkSize(int32_t width, int32_t height, const TextureRenderer2D<DstTf>& destination)
+        {
+            if (destination.width() != width || destination.height() != height) {
+                throw invalid_argument("Destination size does not match source size");
+            }
+        }
+
+        static uint32_t _handle(const BaseTextureRenderer& texture) noexcept
+        {
+            return texture._textureRendererHandle;
+        }
+
+        static constexpr const char* _SHADER = R"(
+layout(local_size_x = 16, local_size_y = 16) in;
+
+layout(binding = 0) uniform SOURCE_TYPE uSource;
+
+layout(std430, binding = 0) coherent buffer Counter
+{
+    uint uCounter;
+};
+
+uniform int uInputLevel;
+uniform ivec2 uInputSize;
+uniform int uMaxChannel;
+uniform bool uPrepare;
+
+// Уровни 2, 4, 6 хранятся в sharedA, уровни 3, 5 - в sharedB.
+shared vec4 sharedA[32 * 32];
+shared vec4 sharedB[16 * 16];
+shared uint sharedTicket;
+
+struct Accumulator
+{
+    vec4 value;
+    float count;
+};
+
+Accumulator begin()
+{
+#if defined(REDUCE_MIN)
+    return Accumulator(vec4(3.402823e38), 0.0);
+#elif defined(REDUCE_MAX)
+    return Accumulator(vec4(-3.402823e38), 0.0);
+#elif defined(REDUCE_MIN_MAX)
+    return Accumulator(vec4(3.402823e38, -3.402823e38, 0.0, 1.0), 0.0);
+#else
+    return Accumulator(vec4(0.0), 0.0);
+#endif
+}
+
+void add(inout Accumulator a, vec4 x)
+{
+#if defined(REDUCE_MIN)
+    a.value = min(a.value, x);
+#elif defined(REDUCE_MAX)
+    a.value = max(a.value, x);
+#elif defined(REDUCE_MIN_MAX)
+    a.value = vec4(min(a.value.r, x.r), max(a.value.g, x.g), 0.0, 1.0);
+#else
+    a.value += x;
+#endif
+    a.count += 1.0;
+}
+
+vec4 result(Accumulator a)
+{
+#if defined(REDUCE_AVERAGE) || defined(REDUCE_LUMINANCE)
+    return a.value / a.count;
+#else
+    return a.value;
+#endif
+}
+
+vec4 prepare(vec4 x)
+{
+#if defined(REDUCE_MIN_MAX)
+    return vec4(x.r, x[uMaxChannel], 0.0, 1.0);
+#elif defined(REDUCE_LUMINANCE)
+    return vec4(dot(x.rgb, vec3(0.2126, 0.7152, 0.0722)));
+#else
+    return x;
+#endif
+}
+
+vec4 fetch(bool tail, ivec2 p)
+{
+#ifdef TAIL
+    if (tail) {
+        return vec4(imageLoad(uLevel6, p));
+    }
+#endif
+    vec4 x = vec4(texelFetch(uSource, p, uInputLevel));
+    return uPrepare ? prepare(x) : x;
+}
+
+ivec2 levelSize(int level)
+{
+    return max(uInputSize >> level, ivec2(1));
+}
+
+// Последний тексель уровня захватывает остаток предыдущего уровня (при нечётном размере - три текселя).
+ivec2 childLast(ivec2 p, ivec2 size, ivec2 childSize)
+{
+    return ivec2(p.x == size.x - 1 ? childSize.x - 1 : 2 * p.x + 1,
+                 p.y == size.y - 1 ? childSize.y - 1 : 2 * p.y + 1);
+}
+
+// Последний блок в строке (столбце) рабочих групп доходит до края уровня.
+ivec2 tileEnd(ivec2 tile, ivec2 tiles, ivec2 size, int cells)
+{
+    return ivec2(tile.x == tiles.x - 1 ? size.x : (tile.x + 1) * cells,
+                 tile.y == tiles.y - 1 ? size.y : (tile.y + 1) * cells);
+}
+
+vec4 readShared(int level, ivec2 p)
+{
+    return (level & 1) == 0 ? sharedA[p.y * 32 + p.x] : sharedB[p.y * 16 + p.x];
+}
+
+void writeShared(int level, ivec2 p, vec4 v)
+{
+    if ((level & 1) == 0) {
+        sharedA[p.y * 32 + p.x] = v;
+    } else {
+        sharedB[p.y * 16 + p.x] = v;
+    }
+}
+
+void reduceTile(bool tail, ivec2 tile, ivec2 tiles)
+{
+    int base = tail ? 6 : 0;
+    int levels = min(COUNT - base, 6);
+    ivec2 local = ivec2(gl_LocalInvocationID.xy);
+
+    // Уровни 1 и 2: каждый поток сам читает нужные тексели входного уровня.
+    ivec2 size0 = levelSize(base);
+    ivec2 size1 = levelSize(base + 1);
+    ivec2 size2 = levelSize(base + 2);
+    ivec2 start2 = tile * 16;
+    ivec2 end2 = tileEnd(tile, tiles, size2, 16);
+
+    for (int y2 = start2.y + local.y; y2 < end2.y; y2 += 16) {
+        for (int x2 = start2.x + local.x; x2 < end2.x; x2 += 16) {
+            ivec2 p2 = ivec2(x2, y2);
+            ivec2 last1 = childLast(p2, size2, size1);
+            Accumulator a2 = begin();
+
+            for (int y1 = 2 * y2; y1 <= last1.y; y1++) {
+                for (int x1 = 2 * x2; x1 <= last1.x; x1++) {
+                    ivec2 p1 = ivec2(x1, y1);
+                    ivec2 last0 = childLast(p1, size1, size0);
+                    Accumulator a1 = begin();
+
+                    for (int y0 = 2 * y1; y0 <= last0.y; y0++) {
+                        for (int x0 = 2 * x1; x0 <= last0.x; x0++) {
+                            vec4 x = fetch(tail, ivec2(x0, y0));
+#ifdef WRITE_INPUT
+                            if (!tail) {
+                                storeLevel(0, ivec2(x0, y0), x);
+                            }
+#endif
+                            add(a1, x);
+                        }
+                    }
+
+                    vec4 v1 = result(a1);
+
+                    if (levels >= 1) {
+                        storeLevel(base + 1, p1, v1);
+                    }
+
+                    add(a2, v1);
+                }
+            }
+
+            vec4 v2 = result(a2);
+            writeShared(2, p2 - start2, v2);
+
+            if (levels >= 2) {
+                storeLevel(base + 2, p2, v2);
+            }
+        }
+    }
+
+    // Уровни 3 - 6 строятся из разделяемой памяти.
+    for (int level = 3; level <= levels; level++) {
+        memoryBarrierShared();
+        barrier();
+
+        int cells = 64 >> level;
+        ivec2 size = levelSize(base + level);
+        ivec2 childSize = levelSize(base + level - 1);
+        ivec2 start = tile * cells;
+        ivec2 end = tileEnd(tile, tiles, size, cells);
+        ivec2 childStart = tile * (cells * 2);
+
+        for (int y = start.y + local.y; y < end.y; y += 16) {
+            for (int x = start.x + local.x; x < end.x; x += 16) {
+                ivec2 p = ivec2(x, y);
+                ivec2 last = childLast(p, size, childSize);
+                Accumulator a = begin();
+
+                for (int cy = 2 * y; cy <= last.y; cy++) {
+                    for (int cx = 2 * x; cx <= last.x; cx++) {
+                        add(a, readShared(level - 1, ivec2(cx, cy) - childStart));
+                    }
+                }
+
+                vec4 v = result(a);
+                writeShared(level, p - start, v);
+                storeLevel(base + level, p, v);
+            }
+        }
+    }
+}
+
+void main()
+{
+    ivec2 tile = ivec2(gl_WorkGroupID.xy);
+    ivec2 tiles = ivec2(gl_NumWorkGroups.xy);
+
+    reduceTile(false, tile, tiles);
+
+#ifdef TAIL
+    // Уровень 6 должен быть виден группе, которая завершится последней.
+    memoryBarrierImage();
+    barrier();
+
+    if (gl_LocalInvocationIndex == 0u) {
+        sharedTicket = atomicAdd(uCounter, 1u);
+    }
+
+    memoryBarrierShared();
+    barrier();
+
+    if (sharedTicket != uint(tiles.x * tiles.y) - 1u) {
+        return;
+    }
+
+    // Счётчик сбрасывается для следующего запуска.
+    if (gl_LocalInvocationIndex == 0u) {
+        uCounter = 0u;
+    }
+
+    reduceTile(true, ivec2(0), ivec2(1));
+#endif
+}
+)";
+
+        Sampler _sampler;
+        uint32_t _counterHandle = 0;
+        int32_t _maxImages = 8;
+        int32_t _numberOfDispatches = 0;
+        unordered_map<string, unique_ptr<ShaderProgram>> _programs;
+    };
+}
@@ -0,0 +1,14 @@
+//
+//  DrawBundle.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef DrawBundle_hpp
+#define DrawBundle_hpp
+
+#include "DrawBundle.inl"
+
+#endif /* DrawBundle_hpp */
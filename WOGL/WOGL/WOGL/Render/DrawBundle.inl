@@ -0,0 +1,257 @@
+//
+//  DrawBundle.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <GL/glew.h>
+
+#include "RenderQueue.hpp"
+
+#include <array>
+#include <vector>
+
+#include <stdexcept>
+
+namespace WOGL
+{
+    /**
+     * Записанный один раз набор команд отрисовки.
+     *
+     * При записи очередь отрисовки сортируется, повторные привязки выбрасываются, а параметры
+     * отрисовок помещаются в буфер косвенных команд (GL_DRAW_INDIRECT_BUFFER). Воспроизведение
+     * сводится к проходу по плоскому списку смен состояния и вызовам glDrawElementsIndirect
+     * (или glMultiDrawElementsIndirect, если он поддерживается), без сортировки и без сравнения состояний.
+     *
+     * Набор хранит указатели на шейдерные программы, текстуры и меши очереди, поэтому после их изменения
+     * или удаления набор необходимо сделать недействительным (invalidate) и записать заново.
+    */
+    class DrawBundle
+    {
+        struct DrawElementsIndirectCommand
+        {
+            uint32_t count;
+            uint32_t instanceCount;
+            uint32_t firstIndex;
+            int32_t baseVertex;
+            uint32_t baseInstance;
+        };
+
+        struct Batch
+        {
+            const ShaderProgram* program;
+            const MeshRenderer* mesh;
+            size_t bindingsOffset;
+            size_t bindingsSize;
+            size_t commandsOffset;
+            int32_t commandsSize;
+        };
+
+        using TextureBinding = pair<const ITextureRenderer*, int32_t>;
+
+    public:
+        /**
+         * Конструктор.
+         *
+         * @throw runtime_error в случае если не удалось создать дескриптор буфера косвенных команд
+        */
+        DrawBundle() :
+            _valid{false}
+        {
+            glGenBuffers(1, &_indirectBufferHandle);
+
+            if (!_indirectBufferHandle) {
+                throw runtime_error("Error create indirect buffer handle");
+            }
+        }
+
+        DrawBundle(DrawBundle&& bundle) :
+            _batches{move(bundle._batches)},
+            _bindings{move(bundle._bindings)},
+            _indirectBufferHandle{0},
+            _valid{bundle._valid}
+        {
+            swap(_indirectBufferHandle, bundle._indirectBufferHandle);
+            bundle._valid = false;
+        }
+
+        DrawBundle(const DrawBundle&) = delete;
+        DrawBundle& operator=(const DrawBundle&) = delete;
+        DrawBundle& operator=(DrawBundle&&) = delete;
+
+        virtual ~DrawBundle()
+        {
+            if (_indirectBufferHandle) {
+                glDeleteBuffers(1, &_indirectBufferHandle);
+            }
+        }
+
+        /**
+         * Метод записывающий команды очереди отрисовки в набор.
+         * Если очередь не отсортирована, то она будет отсортирована.
+         *
+         * @param queue очередь отрисовки
+        */
+        void record(RenderQueue& queue)
+        {
+            queue.sort();
+
+            vector<DrawElementsIndirectCommand> commands;
+            array<const ITextureRenderer*, BindingTracker::NUMBER_TRACKED_SLOTS> textures;
+            const ShaderProgram* program = nullptr;
+            const MeshRenderer* mesh = nullptr;
+            uint32_t material = UINT32_MAX;
+
+            textures.fill(nullptr);
+            commands.reserve(queue._order.size());
+            _batches.clear();
+            _bindings.clear();
+
+            for (size_t i{0}; i < queue._order.size(); i++) {
+                const auto& command = queue._commands[queue._order[i]];
+                size_t bindingsOffset = _bindings.size();
+
+                if (command.material != material) {
+                    material = command.material;
+
+                    const auto& m = queue._materials[material];
+
+                    for (size_t j{0}; j < m.size; j++) {
+                        const auto& binding = queue._bindings[m.offset + j];
+                        int32_t slot = binding.second;
+
+                        if (slot < 0 || slot >= BindingTracker::NUMBER_TRACKED_SLOTS) {
+                            _bindings.push_back(binding);
+                        } else if (textures[slot] != binding.first) {
+                            textures[slot] = binding.first;
+                            _bindings.push_back(binding);
+                        }
+                    }
+                }
+
+                bool sameState = !_batches.empty() && command.program == program && command.mesh == mesh && bindingsOffset == _bindings.size();
+
+                commands.push_back(DrawElementsIndirectCommand {
+                    static_cast<uint32_t>(command.mesh->indices().size()),
+                    static_cast<uint32_t>(command.numberRepetitions),
+                    0, 0, 0
+                });
+
+                if (sameState) {
+                    _batches.back().commandsSize++;
+                    continue;
+                }
+
+                _batches.push_back(Batch {
+                    command.program != program ? command.program : nullptr,
+                    command.mesh != mesh ? command.mesh : nullptr,
+                    bindingsOffset,
+                    _bindings.size() - bindingsOffset,
+                    (commands.size() - 1) * sizeof(DrawElementsIndirectCommand),
+                    1
+                });
+
+                program = command.program;
+                mesh = command.mesh;
+            }
+
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _indirectBufferHandle);
+            glBufferData(GL_DRAW_INDIRECT_BUFFER, commands.size() * sizeof(DrawElementsIndirectCommand), commands.empty() ? nullptr : &commands[0], GL_STATIC_DRAW);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+            _batches.shrink_to_fit();
+            _bindings.shrink_to_fit();
+            _valid = true;
+        }
+
+        /**
+         * Метод воспроизводящий записанные команды.
+         *
+         * @throw logic_error в случае если набор недействителен
+        */
+        void replay() const
+        {
+            if (!_valid) {
+                throw logic_error("Draw bundle is not recorded or was invalidated");
+            }
+
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _indirectBufferHandle);
+
+            for (const auto& batch: _batches) {
+                if (batch.program) {
+                    batch.program->use();
+                }
+
+                for (size_t i{0}; i < batch.bindingsSize; i++) {
+                    const auto& binding = _bindings[batch.bindingsOffset + i];
+                    binding.first->bind(binding.second);
+                    Sampler::bind(binding.second, binding.first->sampler());
+                }
+
+                if (batch.mesh) {
+                    batch.mesh->vertexArray().bind();
+                    batch.mesh->indices().bind();
+                }
+
+                const auto* offset = reinterpret_cast<const void*>(batch.commandsOffset);
+
+                if (batch.commandsSize > 1 && GLEW_ARB_multi_draw_indirect) {
+                    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, offset, batch.commandsSize, 0);
+                } else {
+                    for (int32_t i{0}; i < batch.commandsSize; i++) {
+                        glDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, reinterpret_cast<const void*>(batch.commandsOffset + i * sizeof(DrawElementsIndirectCommand)));
+                    }
+                }
+            }
+
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+            VertexArray::unbind();
+        }
+
+        /**
+         * Метод делающий набор недействительным. Необходимо вызывать после изменения
+         * или удаления объектов, на которые ссылаются записанные команды.
+        */
+        void invalidate() noexcept
+        {
+            _valid = false;
+            _batches.clear();
+            _bindings.clear();
+        }
+
+        /**
+         * @return true - если набор записан и не был сделан недействительным, иначе false
+        */
+        bool valid() const noexcept
+        {
+            return _valid;
+        }
+
+        /**
+         * @return количество смен состояния в наборе
+        */
+        size_t numberOfBatches() const noexcept
+        {
+            return _batches.size();
+        }
+
+        /**
+         * Метод возвращающий дескриптор буфера косвенных команд.
+         * Данный метод не сделан константным так как пользователь сможет повлиять на буфер с помощью функций OpenGL.
+         *
+         * @return дескриптор буфера косвенных команд
+        */
+        uint32_t id() noexcept
+        {
+            return _indirectBufferHandle;
+        }
+
+    private:
+        vector<Batch> _batches;
+        vector<TextureBinding> _bindings;
+        uint32_t _indirectBufferHandle;
+        bool _valid;
+    };
+}
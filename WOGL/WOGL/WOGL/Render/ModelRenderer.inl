@@ -8,8 +8,13 @@
 
 #include "MeshRenderer.hpp"
 #include "Texture/TextureRenderer2D.hpp"
+#include "Texture/TextureRenderer2DArray.hpp"
+#include "Texture/TextureCache.hpp"
+#include "ShaderProgram.hpp"
 
 #include <optional>
+#include <memory>
+#include <stdexcept>
 
 namespace WOGL
 {
@@ -45,10 +50,12 @@ namespace WOGL
     class ModelRenderer :
         public InitializeModelRenderer
     {
-        using PtrTexRenderer = unique_ptr<TextureRenderer2D<TextureTexelFormat>>;
-        using TextureRendererAndSlot = pair<TextureRenderer2D<TextureTexelFormat>, int32_t>;
+        using PtrTexRenderer = shared_ptr<TextureRenderer2D<TextureTexelFormat>>;
+        using PtrTexRendererArray = shared_ptr<TextureRenderer2DArray<TextureTexelFormat>>;
+        using TextureRendererAndSlot = pair<PtrTexRenderer, int32_t>;
 
         friend class Context;
+        friend class RenderQueue;
 
     public:
         /**
@@ -70,10 +77,112 @@ namespace WOGL
             _texturersRenderer.reserve(size);
 
             for (size_t i{0}; i < size; i++) {
-                _texturersRenderer.push_back(TextureRendererAndSlot(TextureRenderer2D<TextureTexelFormat>(textures[i].first), textures[i].second));
+                _texturersRenderer.push_back(TextureRendererAndSlot(make_shared<TextureRenderer2D<TextureTexelFormat>>(*textures[i].first), textures[i].second));
             }   
         }
 
+        /**
+         * Конструктор, получающий текстуры из кэша.
+         * Текстура, которая уже загружена в GPU другой моделью, не загружается повторно.
+         * 
+         * @param model модель
+         * @param cache кэш текстур (текстуры модели должны быть получены из него)
+         * @param posAttibIndx индекс атрибута позиции
+         * @param normalAttribIndx индекс атрибута нормали
+         * @param texCoordAttribIndx индекс атрибута текстурной координаты
+         * @param tangAttribIndx индекс атрибута касательной
+        */
+        template<typename Model, typename DataType, TexelType Tx>
+        explicit ModelRenderer(const Model& model, TextureCache<DataType, Tx>& cache, uint32_t posAttibIndx = 0, uint32_t normalAttribIndx = 1, uint32_t texCoordAttribIndx = 2, uint32_t tangAttribIndx = 3) :
+           InitializeModelRenderer(model, posAttibIndx, normalAttribIndx, texCoordAttribIndx, tangAttribIndx)
+        {
+            const auto& textures = model.texturesAndTexturesSlot();
+            size_t size = textures.size();
+
+            _texturersRenderer.reserve(size);
+
+            for (size_t i{0}; i < size; i++) {
+                _texturersRenderer.push_back(TextureRendererAndSlot(cache.template renderer<TextureTexelFormat>(textures[i].first), textures[i].second));
+            }
+        }
+
+        /**
+         * Конструктор, загружающий текстуры модели в слои общего массива текстур.
+         * Модели, текстуры которых лежат в одном массиве, рисуются без перепривязки текстур между ними:
+         * при отрисовке привязывается только массив, а номера слоёв передаются в шейдер
+         * (через setTextureLayers для каждой отрисовки или через атрибут экземпляра, см. textureLayers).
+         *
+         * @param model модель
+         * @param textureArray массив текстур (размер слоя должен совпадать с размером текстур модели)
+         * @param textureArraySlot текстурный слот, к которому привязывается массив
+         * @param posAttibIndx индекс атрибута позиции
+         * @param normalAttribIndx индекс атрибута нормали
+         * @param texCoordAttribIndx индекс атрибута текстурной координаты
+         * @param tangAttribIndx индекс атрибута касательной
+         * @throw out_of_range в случае если в массиве не хватило свободных слоёв
+         * @throw invalid_argument в случае если размер текстуры не совпадает с размером слоя
+        */
+        template<typename Model>
+        explicit ModelRenderer(const Model& model, const PtrTexRendererArray& textureArray, int32_t textureArraySlot, uint32_t posAttibIndx = 0, uint32_t normalAttribIndx = 1, uint32_t texCoordAttribIndx = 2, uint32_t tangAttribIndx = 3) :
+           InitializeModelRenderer(model, posAttibIndx, normalAttribIndx, texCoordAttribIndx, tangAttribIndx),
+           _textureArray{textureArray},
+           _textureArraySlot{textureArraySlot}
+        {
+            const auto& textures = model.texturesAndTexturesSlot();
+
+            try {
+                for (size_t i{0}; i < textures.size(); i++) {
+                    const auto layer = _textureArray->insert(*textures[i].first);
+
+                    if (!layer) {
+                        throw out_of_range("Texture array is full");
+                    }
+
+                    _textureLayers.push_back(TextureLayerAndSlot(*layer, textures[i].second));
+                }
+            } catch (...) {
+                for (const auto& [layer, slot]: _textureLayers) {
+                    _textureArray->release(layer);
+                }
+
+                throw;
+            }
+        }
+
+        ModelRenderer(ModelRenderer&& modelRenderer) :
+            InitializeModelRenderer(static_cast<InitializeModelRenderer&&>(modelRenderer)),
+            _texturersRenderer{move(modelRenderer._texturersRenderer)},
+            _textureArray{move(modelRenderer._textureArray)},
+            _textureArraySlot{modelRenderer._textureArraySlot},
+            _textureLayers{move(modelRenderer._textureLayers)}
+        {
+            // Слои массива освобождает только объект, которому они переданы.
+            modelRenderer._textureArray = nullptr;
+            modelRenderer._textureLayers.clear();
+        }
+
+        ModelRenderer(const ModelRenderer&) = delete;
+        ModelRenderer& operator=(const ModelRenderer&) = delete;
+        ModelRenderer& operator=(ModelRenderer&&) = delete;
+
+        /**
+         * Деструктор, освобождающий слои массива текстур, в которые загружены текстуры модели.
+        */
+        ~ModelRenderer()
+        {
+            if (!_textureArray) {
+                return;
+            }
+
+            for (const auto& [layer, slot]: _textureLayers) {
+                try {
+                    _textureArray->release(layer);
+                } catch (const out_of_range&) {
+                    // Слой уже освобождён вручную через массив.
+                }
+            }
+        }
+
         const MeshRenderer& at(size_t i) const 
         {
             return _meshRenderers.at(i);
@@ -96,12 +205,12 @@ namespace WOGL
 
         auto& textureRenderer(size_t i) noexcept
         {
-            return _texturersRenderer.at(i).first;
+            return *_texturersRenderer.at(i).first;
         }
 
         const auto& textureRenderer(size_t i) const noexcept 
         {
-            return _texturersRenderer.at(i).first;
+            return *_texturersRenderer.at(i).first;
         }
 
         int32_t textureRendererSlot(size_t i)  noexcept
@@ -109,6 +218,48 @@ namespace WOGL
             return _texturersRenderer.at(i).second;
         }
 
+        /**
+         * Метод возвращающий слои массива текстур, в которые загружены текстуры модели.
+         *
+         * @return пары (номер слоя, слот текстуры модели) в порядке текстур модели
+        */
+        const auto& textureLayers() const noexcept
+        {
+            return _textureLayers;
+        }
+
+        /**
+         * Метод записывающий номера слоёв в uniform-массив (например uniform int layers[4]),
+         * элемент с индексом слота текстуры модели получает номер её слоя.
+         * Программа должна быть текущей.
+         *
+         * @param program шейдерная программа
+         * @param location расположение uniform-массива
+        */
+        void setTextureLayers(const ShaderProgram& program, int32_t location) const
+        {
+            vector<int32_t> layers;
+
+            for (const auto& [layer, slot]: _textureLayers) {
+                if (slot >= 0) {
+                    layers.resize(max(layers.size(), static_cast<size_t>(slot) + 1), 0);
+                    layers[slot] = layer;
+                }
+            }
+
+            if (!layers.empty()) {
+                program.setUniform(location, layers);
+            }
+        }
+
+        /**
+         * @return массив текстур модели (nullptr, если текстуры модели загружены отдельно)
+        */
+        const auto& textureArray() const noexcept
+        {
+            return _textureArray;
+        }
+
         /**
          * Этот статический метод используется в случае, если на вход подаётся несколько моделей.
          *
@@ -132,7 +283,79 @@ namespace WOGL
             return modelsRenderer;
         }
 
+        /**
+         * Этот статический метод используется в случае, если на вход подаётся несколько моделей, текстуры которых получены из кэша.
+         * Текстура, общая для нескольких моделей, загружается в GPU один раз.
+         *
+         * @param models некоторый контейнер с моделями
+         * @param cache кэш текстур
+         * @param posAttibIndx индекс атрибута позиции
+         * @param normalAttribIndx индекс атрибута нормали
+         * @param texCoordAttribIndx индекс атрибута текстурной координаты
+         * @param tangAttribIndx индекс атрибута касательной
+         * @return вектор с объектами типа ModelRenderer
+        */
+        template<typename Models, typename DataType, TexelType Tx>
+        static auto makeModelsRenderer(const Models& models, TextureCache<DataType, Tx>& cache, uint32_t posAttibIndx = 0, uint32_t normalAttribIndx = 1, uint32_t texCoordAttribIndx = 2, uint32_t tangAttribIndx = 3)
+        {
+            vector<ModelRenderer<TextureTexelFormat>> modelsRenderer;
+            modelsRenderer.reserve(models.size());
+
+            for (size_t i{0}; i < models.size(); i++) {
+                modelsRenderer.push_back(ModelRenderer{models[i], cache, posAttibIndx, normalAttribIndx, texCoordAttribIndx, tangAttribIndx});
+            }
+
+            return modelsRenderer;
+        }
+
+        /**
+         * Этот статический метод используется в случае, если на вход подаётся несколько моделей, текстуры которых
+         * загружаются в один массив текстур. Такие модели рисуются без перепривязки текстур между ними.
+         *
+         * @param models некоторый контейнер с моделями
+         * @param textureArray массив текстур
+         * @param textureArraySlot текстурный слот, к которому привязывается массив
+         * @param posAttibIndx индекс атрибута позиции
+         * @param normalAttribIndx индекс атрибута нормали
+         * @param texCoordAttribIndx индекс атрибута текстурной координаты
+         * @param tangAttribIndx индекс атрибута касательной
+         * @return вектор с объектами типа ModelRenderer
+         * @throw out_of_range в случае если в массиве не хватило свободных слоёв
+        */
+        template<typename Models>
+        static auto makeModelsRenderer(const Models& models, const PtrTexRendererArray& textureArray, int32_t textureArraySlot, uint32_t posAttibIndx = 0, uint32_t normalAttribIndx = 1, uint32_t texCoordAttribIndx = 2, uint32_t tangAttribIndx = 3)
+        {
+            vector<ModelRenderer<TextureTexelFormat>> modelsRenderer;
+            modelsRenderer.reserve(models.size());
+
+            for (size_t i{0}; i < models.size(); i++) {
+                modelsRenderer.push_back(ModelRenderer{models[i], textureArray, textureArraySlot, posAttibIndx, normalAttribIndx, texCoordAttribIndx, tangAttribIndx});
+            }
+
+            return modelsRenderer;
+        }
+
     private:
+        using TextureLayerAndSlot = pair<int32_t, int32_t>;
+
+        /**
+         * Метод вызывающий func(const ITextureRenderer*, slot) для каждой текстуры, которую нужно привязать перед отрисовкой.
+        */
+        template<typename Func>
+        void _forEachTexture(Func&& func) const
+        {
+            for (const auto& [texture, slot]: _texturersRenderer) {
+                func(static_cast<const ITextureRenderer*>(texture.get()), slot);
+            }
+
+            if (_textureArray) {
+                func(static_cast<const ITextureRenderer*>(_textureArray.get()), _textureArraySlot);
+            }
+        }
+
         vector<TextureRendererAndSlot> _texturersRenderer;
+        PtrTexRendererArray _textureArray;
+        int32_t _textureArraySlot = -1;
+        vector<TextureLayerAndSlot> _textureLayers;
     };
 }
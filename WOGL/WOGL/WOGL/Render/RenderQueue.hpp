@@ -0,0 +1,29 @@
+//
+//  RenderQueue.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef RenderQueue_hpp
+#define RenderQueue_hpp
+
+namespace WOGL
+{
+    /**
+     * Определяет порядок отрисовки геометрии внутри прохода.
+     *
+     * @field OPAQUE непрозрачная геометрия, рисуется первой и сортируется от ближней к дальней (для раннего теста глубины)
+     * @field TRANSPARENT прозрачная геометрия, рисуется после непрозрачной и сортируется от дальней к ближней
+    */
+    enum class Opacity
+    {
+        OPAQUE,
+        TRANSPARENT
+    };
+}
+
+#include "RenderQueue.inl"
+
+#endif /* RenderQueue_hpp */
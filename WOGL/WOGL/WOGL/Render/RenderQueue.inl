@@ -0,0 +1,392 @@
+//
+//  RenderQueue.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <GL/glew.h>
+
+#include "BindingTracker.hpp"
+#include "ModelRenderer.hpp"
+
+#include <cstring>
+
+#include <stdexcept>
+
+#include <unordered_map>
+#include <vector>
+
+namespace WOGL
+{
+    /**
+     * Очередь отрисовки.
+     *
+     * Каждой отрисовке назначается 64-битный ключ сортировки, в котором (от старших битов к младшим) записаны:
+     * номер прохода, прозрачность, шейдерная программа, набор текстур, VAO и глубина.
+     * Для прозрачной геометрии глубина (инвертированная) записывается сразу после прозрачности.
+     * Перед отрисовкой команды сортируются поразрядной сортировкой, благодаря чему отрисовки с одинаковым
+     * состоянием идут подряд и повторные привязки пропускаются.
+    */
+    class RenderQueue
+    {
+        using TextureBinding = pair<const ITextureRenderer*, int32_t>;
+
+        struct DrawCommand
+        {
+            const ShaderProgram* program;
+            const MeshRenderer* mesh;
+            uint32_t material;
+            int32_t numberRepetitions;
+        };
+
+        struct Material
+        {
+            size_t offset;
+            size_t size;
+        };
+
+        friend class DrawBundle;
+
+        static constexpr uint32_t PASS_BITS = 3;
+        static constexpr uint32_t PROGRAM_BITS = 8;
+        static constexpr uint32_t MATERIAL_BITS = 14;
+        static constexpr uint32_t VERTEX_ARRAY_BITS = 14;
+        static constexpr uint32_t DEPTH_BITS = 24;
+
+    public:
+        RenderQueue() = default;
+
+        RenderQueue(const RenderQueue&) = delete;
+        RenderQueue& operator=(const RenderQueue&) = delete;
+
+        /**
+         * Метод добавляющий в очередь все меши модели.
+         *
+         * @param modelRenderer модель
+         * @param program шейдерная программа, которой будет рисоваться модель
+         * @param depth расстояние от камеры до модели (отрицательные значения считаются нулём)
+         * @param opacity прозрачность модели
+         * @param pass номер прохода (проходы рисуются в порядке возрастания номера)
+         * @param numberRepetitions хранит информацию о количестве проходов рендера
+         * @throw out_of_range в случае если превышено количество различных программ, наборов текстур или VAO в очереди
+        */
+        template<TexelFormat Tf, template<TexelFormat> typename T>
+        void push(const T<Tf>& modelRenderer, const ShaderProgram& program, float depth, Opacity opacity = Opacity::OPAQUE, uint8_t pass = 0, int32_t numberRepetitions = 1)
+        {
+            uint64_t hash = _HASH_BASIS;
+            _scratchBindings.clear();
+
+            modelRenderer._forEachTexture([this, &hash] (const ITextureRenderer* texture, int32_t slot) {
+                hash = _hash(hash, texture, slot);
+                _scratchBindings.push_back(TextureBinding(texture, slot));
+            });
+
+            auto material = _material(hash, _scratchBindings.size(), [this](size_t i) {
+                return _scratchBindings[i];
+            });
+
+            for (size_t i{0}; i < modelRenderer._meshRenderers.size(); i++) {
+                _push(modelRenderer._meshRenderers[i], program, material, depth, opacity, pass, numberRepetitions);
+            }
+        }
+
+        /**
+         * Метод добавляющий в очередь сразу несколько моделей.
+         * Все модели считаются находящимися на одном расстоянии от камеры.
+         *
+         * @param modelsRenderer модели
+         * @param program шейдерная программа, которой будут рисоваться модели
+         * @param opacity прозрачность моделей
+         * @param pass номер прохода
+         * @param numberRepetitions хранит информацию о количестве проходов рендера
+         * @throw out_of_range в случае если превышено количество различных программ, наборов текстур или VAO в очереди
+        */
+        template<typename ContainerWithModelsRenderer>
+        void push(const ContainerWithModelsRenderer& modelsRenderer, const ShaderProgram& program, Opacity opacity = Opacity::OPAQUE, uint8_t pass = 0, int32_t numberRepetitions = 1)
+        {
+            for (size_t i{0}; i < modelsRenderer.size(); i++) {
+                push(modelsRenderer[i], program, 0.0f, opacity, pass, numberRepetitions);
+            }
+        }
+
+        /**
+         * Метод добавляющий в очередь меш без текстур.
+         *
+         * @param meshRenderer меш
+         * @param program шейдерная программа, которой будет рисоваться меш
+         * @param depth расстояние от камеры до меша
+         * @param opacity прозрачность меша
+         * @param pass номер прохода
+         * @param numberRepetitions хранит информацию о количестве проходов рендера
+         * @throw out_of_range в случае если превышено количество различных программ или VAO в очереди
+        */
+        void push(const MeshRenderer& meshRenderer, const ShaderProgram& program, float depth, Opacity opacity = Opacity::OPAQUE, uint8_t pass = 0, int32_t numberRepetitions = 1)
+        {
+            auto material = _material(_HASH_BASIS, 0, [](size_t) {
+                return TextureBinding(nullptr, 0);
+            });
+
+            _push(meshRenderer, program, material, depth, opacity, pass, numberRepetitions);
+        }
+
+        /**
+         * Метод очищающий очередь. Выделенная память при этом сохраняется.
+        */
+        void clear() noexcept
+        {
+            _commands.clear();
+            _keys.clear();
+            _order.clear();
+            _bindings.clear();
+            _materials.clear();
+            _materialsByHash.clear();
+            _programs.clear();
+            _vertexArrays.clear();
+            _sorted = true;
+        }
+
+        size_t size() const noexcept
+        {
+            return _commands.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return _commands.empty();
+        }
+
+        /**
+         * Метод сортирующий команды по ключам (поразрядная сортировка по байтам,
+         * байты, одинаковые у всех ключей, пропускаются).
+        */
+        void sort()
+        {
+            if (_sorted) {
+                return ;
+            }
+
+            size_t size = _keys.size();
+
+            _order.resize(size);
+            _scratchOrder.resize(size);
+            _scratchKeys.resize(size * 2);
+
+            for (size_t i{0}; i < size; i++) {
+                _order[i] = static_cast<uint32_t>(i);
+            }
+
+            if (size == 0) {
+                _sorted = true;
+                return ;
+            }
+
+            copy(begin(_keys), end(_keys), begin(_scratchKeys));
+
+            uint64_t* keys = &_scratchKeys[0];
+            uint64_t* tmpKeys = &_scratchKeys[size];
+            uint32_t* order = &_order[0];
+            uint32_t* tmpOrder = &_scratchOrder[0];
+
+            for (uint32_t shift{0}; shift < 64; shift += 8) {
+                size_t histogram[256] = {0};
+
+                for (size_t i{0}; i < size; i++) {
+                    histogram[(keys[i] >> shift) & 0xff]++;
+                }
+
+                if (histogram[(keys[0] >> shift) & 0xff] == size) {
+                    continue;
+                }
+
+                size_t offset = 0;
+
+                for (size_t i{0}; i < 256; i++) {
+                    size_t count = histogram[i];
+                    histogram[i] = offset;
+                    offset += count;
+                }
+
+                for (size_t i{0}; i < size; i++) {
+                    size_t dst = histogram[(keys[i] >> shift) & 0xff]++;
+                    tmpKeys[dst] = keys[i];
+                    tmpOrder[dst] = order[i];
+                }
+
+                swap(keys, tmpKeys);
+                swap(order, tmpOrder);
+            }
+
+            if (order != &_order[0]) {
+                copy(order, order + size, begin(_order));
+            }
+
+            _sorted = true;
+        }
+
+        /**
+         * Метод отрисовывающий команды очереди в порядке ключей сортировки.
+         * Если очередь не отсортирована, то она сортируется.
+         *
+         * @param tracker трекер привязок, через который будут выполняться привязки
+        */
+        void submit(BindingTracker& tracker)
+        {
+            sort();
+
+            uint32_t material = UINT32_MAX;
+
+            for (size_t i{0}; i < _order.size(); i++) {
+                const auto& command = _commands[_order[i]];
+
+                tracker.useProgram(*command.program);
+
+                if (command.material != material) {
+                    material = command.material;
+
+                    for (size_t j{0}; j < _materials[material].size; j++) {
+                        const auto& binding = _bindings[_materials[material].offset + j];
+                        tracker.bindTexture(binding.second, *binding.first);
+                    }
+                }
+
+                tracker.bindVertexArray(command.mesh->vertexArray());
+                tracker.bindIndexBuffer(command.mesh->indices());
+
+                glDrawElementsInstanced(GL_TRIANGLES, command.mesh->indices().size(), GL_UNSIGNED_INT, nullptr, command.numberRepetitions);
+            }
+
+            tracker.unbindVertexArray();
+        }
+
+    private:
+        static constexpr uint64_t _HASH_BASIS = 14695981039346656037ull;
+
+        static inline uint64_t _hash(uint64_t hash, const void* ptr, int32_t slot) noexcept
+        {
+            uint64_t values[2] = {
+                static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)),
+                static_cast<uint64_t>(static_cast<uint32_t>(slot))
+            };
+
+            for (size_t i{0}; i < 2; i++) {
+                hash ^= values[i];
+                hash *= 1099511628211ull;
+            }
+
+            return hash;
+        }
+
+        template<typename Binding>
+        uint32_t _material(uint64_t hash, size_t size, const Binding& binding)
+        {
+            auto[first, last] = _materialsByHash.equal_range(hash);
+
+            for (; first != last; ++first) {
+                const auto& material = _materials[first->second];
+
+                if (material.size != size) {
+                    continue;
+                }
+
+                bool same = true;
+
+                for (size_t i{0}; i < size && same; i++) {
+                    same = _bindings[material.offset + i] == binding(i);
+                }
+
+                if (same) {
+                    return first->second;
+                }
+            }
+
+            if (_materials.size() >= (1u << MATERIAL_BITS)) {
+                throw out_of_range("Too many texture sets in render queue");
+            }
+
+            auto id = static_cast<uint32_t>(_materials.size());
+            _materials.push_back(Material{_bindings.size(), size});
+
+            for (size_t i{0}; i < size; i++) {
+                _bindings.push_back(binding(i));
+            }
+
+            _materialsByHash.emplace(hash, id);
+
+            return id;
+        }
+
+        template<typename Key, typename Map>
+        static uint32_t _index(Map& map, const Key* key, uint32_t bits)
+        {
+            auto it = map.find(key);
+
+            if (it != map.end()) {
+                return it->second;
+            }
+
+            if (map.size() >= (1u << bits)) {
+                throw out_of_range("Too many different states in render queue");
+            }
+
+            auto id = static_cast<uint32_t>(map.size());
+            map.emplace(key, id);
+
+            return id;
+        }
+
+        /**
+         * Метод переводящий глубину в 24-битное значение. Для неотрицательных чисел с плавающей
+         * точкой порядок их битовых представлений совпадает с порядком самих чисел.
+        */
+        static inline uint64_t _depth(float depth) noexcept
+        {
+            uint32_t bits = 0;
+
+            if (depth > 0.0f) {
+                memcpy(&bits, &depth, sizeof(float));
+            }
+
+            return static_cast<uint64_t>(bits >> (32 - DEPTH_BITS - 1));
+        }
+
+        void _push(const MeshRenderer& meshRenderer, const ShaderProgram& program, uint32_t material, float depth, Opacity opacity, uint8_t pass, int32_t numberRepetitions)
+        {
+            uint64_t programIndex = _index(_programs, &program, PROGRAM_BITS);
+            uint64_t vertexArrayIndex = _index(_vertexArrays, &meshRenderer, VERTEX_ARRAY_BITS);
+            uint64_t depthBits = _depth(depth);
+            uint64_t key = static_cast<uint64_t>(pass & ((1u << PASS_BITS) - 1)) << 61;
+
+            if (opacity == Opacity::OPAQUE) {
+                key |= programIndex << (MATERIAL_BITS + VERTEX_ARRAY_BITS + DEPTH_BITS);
+                key |= static_cast<uint64_t>(material) << (VERTEX_ARRAY_BITS + DEPTH_BITS);
+                key |= vertexArrayIndex << DEPTH_BITS;
+                key |= depthBits;
+            } else {
+                key |= 1ull << 60;
+                key |= (~depthBits & ((1ull << DEPTH_BITS) - 1)) << (PROGRAM_BITS + MATERIAL_BITS + VERTEX_ARRAY_BITS);
+                key |= programIndex << (MATERIAL_BITS + VERTEX_ARRAY_BITS);
+                key |= static_cast<uint64_t>(material) << VERTEX_ARRAY_BITS;
+                key |= vertexArrayIndex;
+            }
+
+            _commands.push_back(DrawCommand{&program, &meshRenderer, material, numberRepetitions});
+            _keys.push_back(key);
+            _sorted = false;
+        }
+
+        vector<DrawCommand> _commands;
+        vector<uint64_t> _keys;
+        vector<uint32_t> _order;
+        vector<uint64_t> _scratchKeys;
+        vector<uint32_t> _scratchOrder;
+        vector<TextureBinding> _bindings;
+        vector<TextureBinding> _scratchBindings;
+        vector<Material> _materials;
+        unordered_multimap<uint64_t, uint32_t> _materialsByHash;
+        unordered_map<const ShaderProgram*, uint32_t> _programs;
+        unordered_map<const MeshRenderer*, uint32_t> _vertexArrays;
+        bool _sorted = true;
+    };
+}
@@ -12,6 +12,7 @@
 
 #include <stdexcept>
 
+#include <string>
 #include <string_view>
 
 #include <fstream>
@@ -46,30 +47,20 @@ namespace WOGL
             ostringstream sstream;
             ifstream file(path.data());
             sstream << file.rdbuf();
-            string shaderCode(sstream.str());
-            const char* ptrShaderCode = shaderCode.c_str();
-
-            glShaderSource(_shaderHandle, 1, &ptrShaderCode, nullptr);
-            glCompileShader(_shaderHandle);
 
-            int32_t cr = 0;
-
-            glGetShaderiv(_shaderHandle, GL_COMPILE_STATUS, &cr);
+            _compile(sstream.str());
+        }
 
-            if (!cr) {
-                glGetShaderiv(_shaderHandle, GL_INFO_LOG_LENGTH, &cr);
-                
-                if (cr > 0) {
-                    string msg;
-                    int32_t written;
-                    
-                    msg.reserve(cr);
-                    
-                    glGetShaderInfoLog(_shaderHandle, cr, &written, &msg[0]);
-                    
-                    throw runtime_error(msg);
-                }
-            }
+        /**
+         * Метод создающий шейдер из исходного кода (например встроенного в библиотеку).
+         *
+         * @param code шейдерный код
+         * @return шейдер
+         * @throw runtime_error в случае ошибки создания или компиляции шейдера
+        */
+        static Shader fromSource(const string_view code)
+        {
+            return Shader(code, _SourceTag{});
         }
 
         Shader(Shader&& shader) :
@@ -99,6 +90,44 @@ namespace WOGL
         }
 
     private:
+        struct _SourceTag {};
+
+        Shader(const string_view code, _SourceTag) :
+            _shaderHandle{glCreateShader(static_cast<GLenum>(ShaderType))}
+        {
+            if (!_shaderHandle) {
+                throw runtime_error("Error create shader");
+            }
+
+            _compile(string(code));
+        }
+
+        void _compile(const string& shaderCode)
+        {
+            const char* ptrShaderCode = shaderCode.c_str();
+
+            glShaderSource(_shaderHandle, 1, &ptrShaderCode, nullptr);
+            glCompileShader(_shaderHandle);
+
+            int32_t cr = 0;
+
+            glGetShaderiv(_shaderHandle, GL_COMPILE_STATUS, &cr);
+
+            if (!cr) {
+                glGetShaderiv(_shaderHandle, GL_INFO_LOG_LENGTH, &cr);
+                
+                if (cr > 0) {
+                    string msg (cr, '\0');
+                    int32_t written;
+                    
+                    glGetShaderInfoLog(_shaderHandle, cr, &written, &msg[0]);
+                    msg.resize(written);
+                    
+                    throw runtime_error(msg);
+                }
+            }
+        }
+
         uint32_t _shaderHandle;
     };
 }
@@ -90,12 +90,11 @@ namespace WOGL
                 glGetProgramiv(_shaderProgramHandle, GL_INFO_LOG_LENGTH, &lr);
 
                 if (lr > 0) {
-                    string msg;
+                    string msg (lr, '\0');
                     int32_t written;
 
-                    msg.reserve(lr);
-
                     glGetProgramInfoLog(_shaderProgramHandle, lr, &written, &msg[0]);
+                    msg.resize(written);
 
                     throw runtime_error(msg);
                 }
@@ -6,7 +6,9 @@
 //  Copyright © 2019 Asif Mamedov. All rights reserved.
 //
 
-#include "../../Data/Texture.hpp"
+#include "../../Data/Texture2D.hpp"
+#include "../../Data/BlockCompression.hpp"
+#include "TextureRenderer.hpp"
 
 #include <stdexcept>
 
@@ -18,7 +20,8 @@ namespace WOGL
 	{
 	protected:
 		explicit InitializeCubeMapTextureRenderer(int32_t widthAndHeight, GLenum Tf) :
-			_widthAndHeight{widthAndHeight}
+			_widthAndHeight{widthAndHeight},
+			_format{Tf}
 		{
 			glGenTextures(1, &_cubeMapTextureRendererHandle);
 
@@ -32,7 +35,8 @@ namespace WOGL
 
 		InitializeCubeMapTextureRenderer(InitializeCubeMapTextureRenderer&& ictr) :
 			_cubeMapTextureRendererHandle{0},
-			_widthAndHeight{ictr._widthAndHeight}
+			_widthAndHeight{ictr._widthAndHeight},
+			_format{ictr._format}
 		{
 			swap(_cubeMapTextureRendererHandle, ictr._cubeMapTextureRendererHandle);
 		}
@@ -49,14 +53,30 @@ namespace WOGL
 		}
 
 		template<typename DataType, TexelType Tx>
-		inline void _setTexture(GLenum target, const Texture<DataType, Tx>& texture)
+		inline void _setTexture(GLenum target, const Texture2D<DataType, Tx>& texture)
 		{
 			auto dataType = BaseTextureRenderer::_type<DataType>();
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 			glTexSubImage2D(target, 0, 0, 0, _widthAndHeight, _widthAndHeight, static_cast<GLenum>(Tx), dataType, &texture._data[0]);
 		}
 
+		inline void _setTexture(GLenum target, const CompressedTexture2D& texture)
+		{
+			if (static_cast<int32_t>(texture._width) != _widthAndHeight || static_cast<int32_t>(texture._height) != _widthAndHeight) {
+				throw invalid_argument("Compressed texture size does not match cube map size");
+			}
+
+			if (static_cast<GLenum>(linearFormat(static_cast<TexelFormat>(_format))) != static_cast<GLenum>(texture._format)) {
+				throw invalid_argument("Block format does not match texel format");
+			}
+
+			glCompressedTexSubImage2D(target, 0, 0, 0, _widthAndHeight, _widthAndHeight, _format, 
+									  static_cast<GLsizei>(texture.size(0)), texture.data(0));
+		}
+
 		uint32_t _cubeMapTextureRendererHandle;
 		int32_t _widthAndHeight;
+		GLenum _format;
 	};
 
 	template<TexelFormat Tf>
@@ -167,7 +187,7 @@ namespace WOGL
 		*/
 		void textureWrappingT(const TextureWrapping wt) noexcept
 		{
-			glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, static_cast<GLenum>(wt));
+			glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, static_cast<GLenum>(wt));
 		}
 
 		/**
@@ -0,0 +1,14 @@
+//
+//  RenderTexturePool.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef RenderTexturePool_hpp
+#define RenderTexturePool_hpp
+
+#include "RenderTexturePool.inl"
+
+#endif /* RenderTexturePool_hpp */
@@ -0,0 +1,141 @@
+//
+//  RenderTexturePool.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <GL/glew.h>
+
+#include "TextureRenderer2D.hpp"
+#include "TextureRenderer3D.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+using namespace std;
+
+namespace WOGL
+{
+    /**
+     * Пул промежуточных текстур (например для многопроходной обработки изображений).
+     *
+     * Метод get возвращает текстуру нужного размера и формата, которая сейчас никем не используется,
+     * или создаёт новую. Текстура считается свободной, когда освобождён последний указатель на неё вне пула,
+     * поэтому после обработки кадра одни и те же текстуры используются повторно без выделения памяти в GPU.
+     * Методы пула можно вызывать только из потока с контекстом OpenGL.
+    */
+    class RenderTexturePool
+    {
+        struct Entry
+        {
+            TexelFormat format;
+            int32_t width;
+            int32_t height;
+            int32_t depth;
+            int32_t levels;
+            shared_ptr<BaseTextureRenderer> texture;
+        };
+
+    public:
+        RenderTexturePool() = default;
+
+        RenderTexturePool(const RenderTexturePool&) = delete;
+        RenderTexturePool& operator=(const RenderTexturePool&) = delete;
+        RenderTexturePool& operator=(RenderTexturePool&&) = delete;
+
+        /**
+         * Метод возвращающий свободную двумерную текстуру.
+         *
+         * @template Tf формат текселя
+         * @param width ширина
+         * @param height высота
+         * @param levels количество уровней mipmap'а
+         * @return указатель на текстуру (содержимое текстуры не определено)
+        */
+        template<TexelFormat Tf>
+        shared_ptr<TextureRenderer2D<Tf>> get(int32_t width, int32_t height, int32_t levels = 1)
+        {
+            if (auto texture = _find(Tf, width, height, 0, levels); texture) {
+                return static_pointer_cast<TextureRenderer2D<Tf>>(texture);
+            }
+
+            auto texture = make_shared<TextureRenderer2D<Tf>>(width, height, levels);
+            _textures.push_back({Tf, width, height, 0, levels, texture});
+
+            return texture;
+        }
+
+        /**
+         * Метод возвращающий свободную трёхмерную текстуру.
+         *
+         * @template Tf формат текселя
+         * @param width ширина
+         * @param height высота
+         * @param depth глубина
+         * @param levels количество уровней mipmap'а
+         * @return указатель на текстуру (содержимое текстуры не определено)
+        */
+        template<TexelFormat Tf>
+        shared_ptr<TextureRenderer3D<Tf>> get(int32_t width, int32_t height, int32_t depth, int32_t levels)
+        {
+            if (auto texture = _find(Tf, width, height, depth, levels); texture) {
+                return static_pointer_cast<TextureRenderer3D<Tf>>(texture);
+            }
+
+            auto texture = make_shared<TextureRenderer3D<Tf>>(width, height, depth, levels);
+            _textures.push_back({Tf, width, height, depth, levels, texture});
+
+            return texture;
+        }
+
+        /**
+         * Метод удаляющий текстуры, которые используются только пулом.
+         *
+         * @return количество удалённых текстур
+        */
+        size_t trim()
+        {
+            const size_t size = _textures.size();
+
+            _textures.erase(remove_if(_textures.begin(), _textures.end(), [] (const Entry& entry) {
+                return entry.texture.use_count() == 1;
+            }), _textures.end());
+
+            return size - _textures.size();
+        }
+
+        /**
+         * Метод очищающий пул. Текстуры, которые ещё используются, удаляются после освобождения последнего указателя.
+        */
+        void clear()
+        {
+            _textures.clear();
+        }
+
+        size_t size() const noexcept
+        {
+            return _textures.size();
+        }
+
+    private:
+        shared_ptr<BaseTextureRenderer> _find(TexelFormat format, int32_t width, int32_t height, int32_t depth, int32_t levels) const noexcept
+        {
+            for (const auto& entry: _textures) {
+                if (entry.format == format && entry.width == width && entry.height == height && entry.depth == depth &&
+                    entry.levels == levels && entry.texture.use_count() == 1) {
+                    return entry.texture;
+                }
+            }
+
+            return nullptr;
+        }
+
+        vector<Entry> _textures;
+    };
+}
@@ -0,0 +1,14 @@
+//
+//  Sampler.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef Sampler_hpp
+#define Sampler_hpp
+
+#include "Sampler.inl"
+
+#endif /* Sampler_hpp */
@@ -0,0 +1,301 @@
+//
+//  Sampler.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "TextureMappingSetting.hpp"
+#include "TextureRenderer.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#include <memory>
+#include <unordered_map>
+#include <stdexcept>
+
+using namespace std;
+using namespace glm;
+
+namespace WOGL
+{
+    /**
+     * Описание состояния сэмплера. Значения по умолчанию совпадают со значениями по умолчанию в OpenGL.
+     *
+     * @field magFilter способ увеличения текстуры
+     * @field minFilter способ минимизации текстуры
+     * @field wrappingS, wrappingT, wrappingR способы оптекания текстуры по осям S, T и R
+     * @field compareMode режим сравнения (для текстур глубины)
+     * @field compareFunc оператор сравнения
+     * @field maxAnisotropy максимальная степень анизотропной фильтрации (1 - анизотропная фильтрация выключена)
+     * @field minLod, maxLod диапазон уровней mipmap'а
+     * @field lodBias смещение уровня mipmap'а
+     * @field borderColor цвет границы (для CLAMP_TO_BORDER)
+    */
+    struct SamplerDescription
+    {
+        TextureFilter magFilter = TextureFilter::LINEAR;
+        TextureFilter minFilter = TextureFilter::NEAREST_MIPMAP_LINEAR;
+        TextureWrapping wrappingS = TextureWrapping::REPEAT;
+        TextureWrapping wrappingT = TextureWrapping::REPEAT;
+        TextureWrapping wrappingR = TextureWrapping::REPEAT;
+        TextureCompareMode compareMode = TextureCompareMode::NONE;
+        TextureCompareFunc compareFunc = TextureCompareFunc::LEQUAL;
+        float maxAnisotropy = 1.0f;
+        float minLod = -1000.0f;
+        float maxLod = 1000.0f;
+        float lodBias = 0.0f;
+        vec4 borderColor = vec4(0.0f);
+
+        bool operator==(const SamplerDescription& description) const noexcept
+        {
+            return magFilter == description.magFilter && minFilter == description.minFilter &&
+                   wrappingS == description.wrappingS && wrappingT == description.wrappingT && wrappingR == description.wrappingR &&
+                   compareMode == description.compareMode && compareFunc == description.compareFunc &&
+                   maxAnisotropy == description.maxAnisotropy && minLod == description.minLod && maxLod == description.maxLod &&
+                   lodBias == description.lodBias && borderColor == description.borderColor;
+        }
+
+        bool operator!=(const SamplerDescription& description) const noexcept
+        {
+            return !(*this == description);
+        }
+
+        /**
+         * Метод вычисляющий хэш описания (FNV-1a по значениям полей).
+        */
+        uint64_t hash() const noexcept
+        {
+            uint64_t result = 14695981039346656037ull;
+
+            const auto add = [&result] (uint32_t value) {
+                for (size_t i{0}; i < 4; i++) {
+                    result ^= (value >> (i * 8)) & 0xFF;
+                    result *= 1099511628211ull;
+                }
+            };
+
+            const auto addFloat = [&add] (float value) {
+                uint32_t bits;
+                value = value == 0.0f ? 0.0f : value;
+                memcpy(&bits, &value, sizeof(bits));
+                add(bits);
+            };
+
+            add(static_cast<uint32_t>(magFilter));
+            add(static_cast<uint32_t>(minFilter));
+            add(static_cast<uint32_t>(wrappingS));
+            add(static_cast<uint32_t>(wrappingT));
+            add(static_cast<uint32_t>(wrappingR));
+            add(static_cast<uint32_t>(compareMode));
+            add(static_cast<uint32_t>(compareFunc));
+            addFloat(maxAnisotropy);
+            addFloat(minLod);
+            addFloat(maxLod);
+            addFloat(lodBias);
+
+            for (size_t i{0}; i < 4; i++) {
+                addFloat(borderColor[i]);
+            }
+
+            return result;
+        }
+    };
+
+    struct SamplerDescriptionHash
+    {
+        size_t operator()(const SamplerDescription& description) const noexcept
+        {
+            return static_cast<size_t>(description.hash());
+        }
+    };
+
+    /**
+     * Объект сэмплера OpenGL. Хранит параметры выборки отдельно от текстуры, поэтому одни и те же параметры
+     * используются всеми текстурами, привязанными к слоту вместе с сэмплером, и не задаются через glTexParameteri перед отрисовкой.
+     * Параметры задаются один раз при создании и больше не изменяются.
+    */
+    class Sampler
+    {
+    public:
+        /**
+         * Конструктор.
+         * Если анизотропная фильтрация не поддерживается (EXT_texture_filter_anisotropic), то maxAnisotropy игнорируется.
+         *
+         * @param description описание сэмплера
+         * @throw runtime_error в случае если не удалось создать сэмплер
+        */
+        explicit Sampler(const SamplerDescription& description = SamplerDescription()) :
+            _description{description}
+        {
+            glGenSamplers(1, &_samplerHandle);
+
+            if (!_samplerHandle) {
+                throw runtime_error("Error create sampler handle");
+            }
+
+            glSamplerParameteri(_samplerHandle, GL_TEXTURE_MAG_FILTER, static_cast<GLenum>(description.magFilter));
+            glSamplerParameteri(_samplerHandle, GL_TEXTURE_MIN_FILTER, static_cast<GLenum>(description.minFilter));
+            glSamplerParameteri(_samplerHandle, GL_TEXTURE_WRAP_S, static_cast<GLenum>(description.wrappingS));
+            glSamplerParameteri(_samplerHandle, GL_TEXTURE_WRAP_T, static_cast<GLenum>(description.wrappingT));
+            glSamplerParameteri(_samplerHandle, GL_TEXTURE_WRAP_R, static_cast<GLenum>(description.wrappingR));
+            glSamplerParameteri(_samplerHandle, GL_TEXTURE_COMPARE_MODE, static_cast<GLenum>(description.compareMode));
+            glSamplerParameteri(_samplerHandle, GL_TEXTURE_COMPARE_FUNC, static_cast<GLenum>(description.compareFunc));
+            glSamplerParameterf(_samplerHandle, GL_TEXTURE_MIN_LOD, description.minLod);
+            glSamplerParameterf(_samplerHandle, GL_TEXTURE_MAX_LOD, description.maxLod);
+            glSamplerParameterf(_samplerHandle, GL_TEXTURE_LOD_BIAS, description.lodBias);
+            glSamplerParameterfv(_samplerHandle, GL_TEXTURE_BORDER_COLOR, &description.borderColor[0]);
+
+            if (GLEW_EXT_texture_filter_anisotropic && description.maxAnisotropy > 1.0f) {
+                glSamplerParameterf(_samplerHandle, GL_TEXTURE_MAX_ANISOTROPY_EXT, description.maxAnisotropy);
+            }
+        }
+
+        Sampler(Sampler&& sampler) :
+            _samplerHandle{0},
+            _description{sampler._description}
+        {
+            swap(_samplerHandle, sampler._samplerHandle);
+        }
+
+        ~Sampler() noexcept
+        {
+            if (_samplerHandle) {
+                glDeleteSamplers(1, &_samplerHandle);
+            }
+        }
+
+        Sampler(const Sampler&) = delete;
+        Sampler& operator=(const Sampler&) = delete;
+        Sampler& operator=(Sampler&&) = delete;
+
+        /**
+         * Метод привязывающий сэмплер к текстурному слоту.
+         *
+         * @param slot текстурный слот
+        */
+        inline void bind(int32_t slot) const noexcept
+        {
+            if (slot >= 0) {
+                glBindSampler(slot, _samplerHandle);
+            }
+        }
+
+        /**
+         * Метод привязывающий к слоту сэмплер или, если sampler равен nullptr, отвязывающий сэмплер от слота.
+         *
+         * @param slot текстурный слот
+         * @param sampler сэмплер
+        */
+        inline static void bind(int32_t slot, const Sampler* sampler) noexcept
+        {
+            if (sampler) {
+                sampler->bind(slot);
+            } else {
+                unbind(slot);
+            }
+        }
+
+        /**
+         * Метод отвязывающий сэмплер от текстурного слота.
+         * После этого используются параметры привязанной к слоту текстуры.
+         *
+         * @param slot текстурный слот
+        */
+        inline static void unbind(int32_t slot) noexcept
+        {
+            if (slot >= 0) {
+                glBindSampler(slot, 0);
+            }
+        }
+
+        const SamplerDescription& description() const noexcept
+        {
+            return _description;
+        }
+
+        uint32_t id() const noexcept
+        {
+            return _samplerHandle;
+        }
+
+    private:
+        uint32_t _samplerHandle;
+        SamplerDescription _description;
+    };
+
+    /**
+     * Кэш сэмплеров. Для каждого описания создаётся только один объект сэмплера,
+     * поэтому текстуры с одинаковыми параметрами выборки разделяют сэмплер и не перепривязывают его.
+     * Методы кэша можно вызывать только из потока с контекстом OpenGL.
+    */
+    class SamplerCache
+    {
+    public:
+        SamplerCache() = default;
+
+        SamplerCache(const SamplerCache&) = delete;
+        SamplerCache& operator=(const SamplerCache&) = delete;
+        SamplerCache& operator=(SamplerCache&&) = delete;
+
+        /**
+         * Метод возвращающий сэмплер с заданным описанием. Если такого сэмплера ещё нет, то он создаётся.
+         *
+         * @param description описание сэмплера
+         * @return указатель на сэмплер
+         * @throw runtime_error в случае если не удалось создать сэмплер
+        */
+        shared_ptr<const Sampler> get(const SamplerDescription& description)
+        {
+            if (auto it = _samplers.find(description); it != _samplers.end()) {
+                return it->second;
+            }
+
+            auto sampler = make_shared<const Sampler>(description);
+            _samplers.emplace(description, sampler);
+
+            return sampler;
+        }
+
+        /**
+         * Метод удаляющий сэмплеры, которые используются только кэшем.
+         *
+         * @return количество удалённых сэмплеров
+        */
+        size_t trim()
+        {
+            const size_t size = _samplers.size();
+
+            for (auto it = _samplers.begin(); it != _samplers.end(); ) {
+                if (it->second.use_count() == 1) {
+                    it = _samplers.erase(it);
+                } else {
+                    it++;
+                }
+            }
+
+            return size - _samplers.size();
+        }
+
+        /**
+         * Метод очищающий кэш. Сэмплеры, которые ещё используются, удаляются после освобождения последнего указателя.
+        */
+        void clear()
+        {
+            _samplers.clear();
+        }
+
+        size_t size() const
+        {
+            return _samplers.size();
+        }
+
+    private:
+        unordered_map<SamplerDescription, shared_ptr<const Sampler>, SamplerDescriptionHash> _samplers;
+    };
+}
@@ -0,0 +1,14 @@
+//
+//  TextureAtlasRenderer.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef TextureAtlasRenderer_hpp
+#define TextureAtlasRenderer_hpp
+
+#include "TextureAtlasRenderer.inl"
+
+#endif /* TextureAtlasRenderer_hpp */
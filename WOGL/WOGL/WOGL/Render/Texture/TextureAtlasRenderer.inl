@@ -0,0 +1,191 @@
+//
+//  TextureAtlasRenderer.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <GL/glew.h>
+
+#include "../../Data/TextureAtlas.hpp"
+#include "TextureRenderer2D.hpp"
+
+#include <vector>
+#include <optional>
+
+using namespace std;
+
+namespace WOGL
+{
+    /**
+     * Атлас текстур в памяти GPU, в который текстуры можно добавлять по одной.
+     * Текстуры из памяти CPU загружаются вместе с полями, а уже загруженные в GPU текстуры
+     * копируются внутри GPU (glCopyImageSubData), без чтения в память CPU.
+     *
+     * Заполняется нулевой уровень атласа, после добавления текстур нужно вызвать genMipmap.
+     *
+     * @template Tf формат текселя (несжатый)
+    */
+    template<TexelFormat Tf>
+    class TextureAtlasRenderer
+    {
+        static_assert(!isCompressedFormat(Tf), "Texture atlas requires an uncompressed texel format");
+
+    public:
+        /**
+         * Конструктор.
+         *
+         * @param width ширина атласа
+         * @param height высота атласа
+         * @param gutter ширина полей вокруг каждой текстуры
+         * @param levels количество уровней mipmap'а (если 0, то выделяется полная цепочка)
+        */
+        explicit TextureAtlasRenderer(int32_t width, int32_t height, size_t gutter = 4, int32_t levels = 0) :
+            _texture(width, height, levels),
+            _packer(width, height),
+            _gutter{gutter}
+        {
+        }
+
+        /**
+         * Конструктор загружающий в GPU готовый атлас.
+         *
+         * @param atlas атлас в памяти CPU
+        */
+        template<typename DataType, TexelType Tx>
+        explicit TextureAtlasRenderer(const TextureAtlas<DataType, Tx>& atlas) :
+            _texture(atlas.texture()),
+            _packer(atlas.packer()),
+            _gutter{atlas.gutter()},
+            _regions{atlas.regions()}
+        {
+        }
+
+        /**
+         * Метод загружающий текстуру из памяти CPU в свободное место атласа.
+         *
+         * @param texture текстура
+         * @return область текстуры в атласе или nullopt, если в атласе не осталось места
+        */
+        template<typename DataType, TexelType Tx>
+        optional<AtlasRegion> insert(const Texture2D<DataType, Tx>& texture)
+        {
+            const auto position = _packer.insert(texture.width() + 2 * _gutter, texture.height() + 2 * _gutter);
+
+            if (!position) {
+                return nullopt;
+            }
+
+            const auto x = static_cast<int32_t>(position->first);
+            const auto y = static_cast<int32_t>(position->second);
+
+            _texture.update(TextureAtlas<DataType, Tx>::pad(texture, _gutter), x, y);
+
+            return _addRegion(x, y, texture.width(), texture.height());
+        }
+
+        /**
+         * Метод копирующий текстуру, уже загруженную в GPU, в свободное место атласа.
+         * Поля заполняются копированием крайних строк и столбцов текстуры.
+         *
+         * @param texture текстура
+         * @return область текстуры в атласе или nullopt, если в атласе не осталось места
+         * @throw runtime_error в случае если копирование текстур не поддерживается
+        */
+        optional<AtlasRegion> insert(const TextureRenderer2D<Tf>& texture)
+        {
+            const int32_t width = texture.width();
+            const int32_t height = texture.height();
+            const auto position = _packer.insert(width + 2 * _gutter, height + 2 * _gutter);
+
+            if (!position) {
+                return nullopt;
+            }
+
+            const auto g = static_cast<int32_t>(_gutter);
+            const auto x = static_cast<int32_t>(position->first);
+            const auto y = static_cast<int32_t>(position->second);
+            const int32_t left = x + g;
+            const int32_t top = y + g;
+
+            _texture.copy(texture, 0, 0, left, top, width, height);
+
+            for (int32_t i{0}; i < g; i++) {
+                _texture.copy(texture, 0, 0, x + i, top, 1, height);
+                _texture.copy(texture, width - 1, 0, left + width + i, top, 1, height);
+            }
+
+            // С ARB_copy_image верхние и нижние поля (вместе с углами) копируются из уже заполненных строк атласа,
+            // иначе копировать внутри одной текстуры нельзя и углы заполняются по текселю.
+            if (GLEW_ARB_copy_image) {
+                for (int32_t i{0}; i < g; i++) {
+                    _texture.copy(_texture, x, top, x, y + i, width + 2 * g, 1);
+                    _texture.copy(_texture, x, top + height - 1, x, top + height + i, width + 2 * g, 1);
+                }
+            } else {
+                for (int32_t i{0}; i < g; i++) {
+                    _texture.copy(texture, 0, 0, left, y + i, width, 1);
+                    _texture.copy(texture, 0, height - 1, left, top + height + i, width, 1);
+
+                    for (int32_t j{0}; j < g; j++) {
+                        _texture.copy(texture, 0, 0, x + j, y + i, 1, 1);
+                        _texture.copy(texture, width - 1, 0, left + width + j, y + i, 1, 1);
+                        _texture.copy(texture, 0, height - 1, x + j, top + height + i, 1, 1);
+                        _texture.copy(texture, width - 1, height - 1, left + width + j, top + height + i, 1, 1);
+                    }
+                }
+            }
+
+            return _addRegion(x, y, width, height);
+        }
+
+        /**
+         * Метод необходимый для генерации mipmap'а атласа.
+         * Атлас привязывается к текстурному слоту 0.
+        */
+        void genMipmap() const noexcept
+        {
+            _texture.bind(0);
+            _texture.genMipmap();
+        }
+
+        void bind(int32_t slot) const noexcept
+        {
+            _texture.bind(slot);
+        }
+
+        const TextureRenderer2D<Tf>& texture() const noexcept
+        {
+            return _texture;
+        }
+
+        TextureRenderer2D<Tf>& texture() noexcept
+        {
+            return _texture;
+        }
+
+        const vector<AtlasRegion>& regions() const noexcept
+        {
+            return _regions;
+        }
+
+        const SkylinePacker& packer() const noexcept
+        {
+            return _packer;
+        }
+
+    private:
+        AtlasRegion _addRegion(size_t x, size_t y, size_t width, size_t height)
+        {
+            _regions.push_back(AtlasRegion::make(x, y, width, height, _gutter, _texture.width(), _texture.height()));
+
+            return _regions.back();
+        }
+
+        TextureRenderer2D<Tf> _texture;
+        SkylinePacker _packer;
+        size_t _gutter;
+        vector<AtlasRegion> _regions;
+    };
+}
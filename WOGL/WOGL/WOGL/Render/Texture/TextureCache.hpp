@@ -0,0 +1,14 @@
+//
+//  TextureCache.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef TextureCache_hpp
+#define TextureCache_hpp
+
+#include "TextureCache.inl"
+
+#endif /* TextureCache_hpp */
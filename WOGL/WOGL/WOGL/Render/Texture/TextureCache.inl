@@ -0,0 +1,325 @@
+//
+//  TextureCache.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include "TextureRenderer2D.hpp"
+#include "../../Data/Texture2D.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <mutex>
+#include <map>
+#include <unordered_map>
+
+using namespace std;
+
+namespace WOGL
+{
+    /**
+     * Кэш 2d текстур.
+     * Каждое изображение декодируется и хранится в памяти один раз, а для каждого формата текселя
+     * создаётся только один TextureRenderer2D. Текстуры ищутся по пути, а затем по хэшу содержимого
+     * (поэтому одинаковые изображения, лежащие по разным путям, тоже хранятся один раз).
+     *
+     * Кэш возвращает shared_ptr на константные текстуры, которые разделяются всеми пользователями текстуры,
+     * поэтому полученные из кэша текстуры нельзя изменять (иначе устареет и индекс по содержимому).
+     * Методы загрузки можно вызывать из нескольких потоков, а метод renderer - только из потока с контекстом OpenGL.
+     *
+     * @template DataType тип каждого из каналов текстуры
+     * @template Tx тип текселя
+    */
+    template<typename DataType, TexelType Tx>
+    class TextureCache
+    {
+    public:
+        using TextureType = Texture2D<DataType, Tx>;
+        using TexturePtr = shared_ptr<const TextureType>;
+
+        /**
+         * Статистика кэша.
+         *
+         * @field hits количество запросов, для которых текстура уже была в кэше
+         * @field misses количество запросов, для которых текстура была добавлена в кэш
+         * @field bytesSaved объём памяти, который потребовался бы без кэша для повторных текстур
+         * @field residentHits количество запросов TextureRenderer2D, для которых текстура уже была загружена в GPU
+         * @field residentMisses количество созданных TextureRenderer2D
+         * @field residentBytesSaved объём памяти GPU, который потребовался бы без кэша
+        */
+        struct Statistics
+        {
+            size_t hits = 0;
+            size_t misses = 0;
+            size_t bytesSaved = 0;
+            size_t residentHits = 0;
+            size_t residentMisses = 0;
+            size_t residentBytesSaved = 0;
+        };
+
+        TextureCache() = default;
+
+        TextureCache(const TextureCache&) = delete;
+        TextureCache& operator=(const TextureCache&) = delete;
+        TextureCache& operator=(TextureCache&&) = delete;
+
+        /**
+         * Метод возвращающий текстуру, загруженную по пути path.
+         * Если изображение уже загружалось (по этому пути или с тем же содержимым), то возвращается сохранённая текстура.
+         *
+         * @param path путь до изображения
+         * @return указатель на текстуру
+         * @throw invalid_argument в случае если не удалось загрузить изображение
+        */
+        TexturePtr load(const string_view path)
+        {
+            string key (path);
+
+            {
+                lock_guard<mutex> lock(_mutex);
+
+                if (auto texture = _find(key)) {
+                    return texture;
+                }
+            }
+
+            TexturePtr texture = make_shared<TextureType>(TextureType::loadTexture(path));
+
+            lock_guard<mutex> lock(_mutex);
+
+            // Пока изображение декодировалось, его мог загрузить другой поток.
+            if (auto cached = _find(key)) {
+                return cached;
+            }
+
+            texture = _insert(move(texture));
+            _paths.emplace(move(key), texture);
+
+            return texture;
+        }
+
+        /**
+         * Метод добавляющий текстуру в кэш.
+         * Если текстура с тем же содержимым уже есть в кэше, то возвращается она.
+         *
+         * @param texture текстура
+         * @return указатель на текстуру
+        */
+        TexturePtr insert(TextureType&& texture)
+        {
+            TexturePtr ptr = make_shared<TextureType>(move(texture));
+
+            lock_guard<mutex> lock(_mutex);
+            return _insert(move(ptr));
+        }
+
+        /**
+         * Метод возвращающий TextureRenderer2D для текстуры из кэша.
+         * Для каждой пары (текстура, формат текселя) TextureRenderer2D создаётся только один раз.
+         *
+         * @template Tf формат текселя
+         * @param texture текстура (обычно полученная из этого кэша). Пока TextureRenderer2D хранится в кэше,
+         * кэш держит ссылку и на текстуру, поэтому по её адресу не может появиться другая текстура.
+         * @return указатель на TextureRenderer2D
+        */
+        template<TexelFormat Tf>
+        shared_ptr<TextureRenderer2D<Tf>> renderer(const TexturePtr& texture)
+        {
+            const auto key = make_pair(texture.get(), static_cast<GLenum>(Tf));
+
+            lock_guard<mutex> lock(_mutex);
+
+            if (auto it = _renderers.find(key); it != _renderers.end()) {
+                _statistics.residentHits++;
+                _statistics.residentBytesSaved += texture->_width * texture->_height * TexelFormatTraits<Tf>::bytesPerPixel;
+
+                return static_pointer_cast<TextureRenderer2D<Tf>>(it->second.renderer);
+            }
+
+            auto renderer = make_shared<TextureRenderer2D<Tf>>(*texture);
+            _renderers.emplace(key, _Resident{texture, renderer});
+            _statistics.residentMisses++;
+
+            return renderer;
+        }
+
+        /**
+         * Метод удаляющий из кэша текстуры и TextureRenderer2D, которые больше никем не используются.
+         *
+         * @return количество удалённых текстур
+        */
+        size_t trim()
+        {
+            lock_guard<mutex> lock(_mutex);
+
+            for (auto it = _renderers.begin(); it != _renderers.end();) {
+                it = it->second.renderer.use_count() == 1 ? _renderers.erase(it) : next(it);
+            }
+
+            unordered_map<const TextureType*, long> references;
+
+            for (const auto& [path, texture]: _paths) {
+                references[texture.get()]++;
+            }
+
+            size_t removed = 0;
+
+            for (auto it = _contents.begin(); it != _contents.end();) {
+                const auto* texture = it->second.get();
+                const bool resident = _renderers.lower_bound(make_pair(texture, GLenum{0})) != _renderers.upper_bound(make_pair(texture, ~GLenum{0}));
+
+                // Текстура не используется, если на неё ссылаются только _contents и _paths.
+                if (!resident && it->second.use_count() == 1 + references[texture]) {
+                    for (auto path = _paths.begin(); path != _paths.end();) {
+                        path = path->second.get() == texture ? _paths.erase(path) : next(path);
+                    }
+
+                    it = _contents.erase(it);
+                    removed++;
+                } else {
+                    ++it;
+                }
+            }
+
+            return removed;
+        }
+
+        /**
+         * Метод очищающий кэш. Уже выданные текстуры и TextureRenderer2D продолжают существовать, пока используются.
+        */
+        void clear()
+        {
+            lock_guard<mutex> lock(_mutex);
+
+            _renderers.clear();
+            _paths.clear();
+            _contents.clear();
+        }
+
+        /**
+         * @return количество различных текстур в кэше
+        */
+        size_t size() const
+        {
+            lock_guard<mutex> lock(_mutex);
+            return _contents.size();
+        }
+
+        /**
+         * @return объём памяти, занимаемой текстурами кэша
+        */
+        size_t sizeInBytes() const
+        {
+            lock_guard<mutex> lock(_mutex);
+            size_t size = 0;
+
+            for (const auto& [hash, texture]: _contents) {
+                size += _sizeInBytes(*texture);
+            }
+
+            return size;
+        }
+
+        Statistics statistics() const
+        {
+            lock_guard<mutex> lock(_mutex);
+            return _statistics;
+        }
+
+        void resetStatistics()
+        {
+            lock_guard<mutex> lock(_mutex);
+            _statistics = Statistics();
+        }
+
+    private:
+        /**
+         * TextureRenderer2D вместе с текстурой, из которой он создан.
+        */
+        struct _Resident
+        {
+            TexturePtr texture;
+            shared_ptr<ITextureRenderer> renderer;
+        };
+
+        static size_t _sizeInBytes(const TextureType& texture) noexcept
+        {
+            return texture._data.size() * sizeof(DataType);
+        }
+
+        /**
+         * 64-битный FNV-1a, обрабатывающий данные словами по 8 байт.
+        */
+        static uint64_t _hash(const TextureType& texture) noexcept
+        {
+            constexpr uint64_t prime = 1099511628211ull;
+            uint64_t hash = 14695981039346656037ull;
+
+            hash = (hash ^ texture._width) * prime;
+            hash = (hash ^ texture._height) * prime;
+
+            const auto* bytes = reinterpret_cast<const uint8_t*>(texture._data.data());
+            const size_t size = _sizeInBytes(texture);
+            size_t i = 0;
+
+            for (uint64_t word; i + sizeof(word) <= size; i += sizeof(word)) {
+                memcpy(&word, bytes + i, sizeof(word));
+                hash = (hash ^ word) * prime;
+            }
+
+            for (; i < size; i++) {
+                hash = (hash ^ bytes[i]) * prime;
+            }
+
+            return hash;
+        }
+
+        TexturePtr _find(const string& path)
+        {
+            auto it = _paths.find(path);
+
+            if (it == _paths.end()) {
+                return nullptr;
+            }
+
+            _statistics.hits++;
+            _statistics.bytesSaved += _sizeInBytes(*it->second);
+
+            return it->second;
+        }
+
+        TexturePtr _insert(TexturePtr&& texture)
+        {
+            const auto hash = _hash(*texture);
+            const auto [begin, end] = _contents.equal_range(hash);
+
+            for (auto it = begin; it != end; ++it) {
+                const auto& cached = *it->second;
+
+                if (cached._width == texture->_width && cached._height == texture->_height && cached._data == texture->_data) {
+                    _statistics.hits++;
+                    _statistics.bytesSaved += _sizeInBytes(cached);
+
+                    return it->second;
+                }
+            }
+
+            _statistics.misses++;
+            _contents.emplace(hash, texture);
+
+            return move(texture);
+        }
+
+        unordered_map<string, TexturePtr> _paths;
+        unordered_multimap<uint64_t, TexturePtr> _contents;
+        map<pair<const TextureType*, GLenum>, _Resident> _renderers;
+        Statistics _statistics;
+        mutable mutex _mutex;
+    };
+}
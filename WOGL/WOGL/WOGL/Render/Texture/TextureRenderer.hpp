@@ -9,11 +9,26 @@
 #ifndef TextureRenderer_hpp
 #define TextureRenderer_hpp
 
+#include <GL/glew.h>
+
+#include "../../Data/Half.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+#include <type_traits>
+
+using namespace std;
+
 namespace WOGL
 {
     /**
      * Определяет внутренний размер (в зависимости от количиства
      * инициализированных каналов и их размера) буфера в котором будт хранится текстура.
+     *
+     * *_U и *_S - целочисленные форматы, *_F - форматы с плавающей точкой,
+     * *_UNORM - нормализованные (в шейдере читаются как float из [0, 1]),
+     * SRGB* - нормализованные в пространстве sRGB, BC* - блочно-сжатые.
     */
     enum class TexelFormat: GLenum
     {
@@ -51,7 +66,283 @@ namespace WOGL
         RED8_U = GL_R8UI,
         RED32_S = GL_R32I,
         RED16_S = GL_R16I,
-        RED8_S = GL_R8I
+        RED8_S = GL_R8I,
+
+        RGBA8_UNORM = GL_RGBA8,
+        RGB8_UNORM = GL_RGB8,
+        RG8_UNORM = GL_RG8,
+        RED8_UNORM = GL_R8,
+        SRGB8_ALPHA8 = GL_SRGB8_ALPHA8,
+        SRGB8 = GL_SRGB8,
+
+        BC1_RGB = GL_COMPRESSED_RGB_S3TC_DXT1_EXT,
+        BC3_RGBA = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+        BC4_RED = GL_COMPRESSED_RED_RGTC1,
+        BC5_RG = GL_COMPRESSED_RG_RGTC2,
+        BC7_RGBA = GL_COMPRESSED_RGBA_BPTC_UNORM,
+        BC1_SRGB = GL_COMPRESSED_SRGB_S3TC_DXT1_EXT,
+        BC3_SRGB_ALPHA = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT,
+        BC7_SRGB_ALPHA = GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM
+    };
+
+    /**
+     * Функция возвращающая количество каналов формата.
+     *
+     * @param tf формат текселя
+     * @return количество каналов
+    */
+    constexpr size_t numberOfChannels(TexelFormat tf) noexcept
+    {
+        switch (tf) {
+            case TexelFormat::RGBA32_F: case TexelFormat::RGBA16_F:
+            case TexelFormat::RGBA32_U: case TexelFormat::RGBA16_U: case TexelFormat::RGBA8_U:
+            case TexelFormat::RGBA32_S: case TexelFormat::RGBA16_S: case TexelFormat::RGBA8_S:
+            case TexelFormat::RGBA8_UNORM: case TexelFormat::SRGB8_ALPHA8:
+            case TexelFormat::BC3_RGBA: case TexelFormat::BC7_RGBA: case TexelFormat::BC3_SRGB_ALPHA: case TexelFormat::BC7_SRGB_ALPHA:
+                return 4;
+
+            case TexelFormat::RGB32_F: case TexelFormat::RGB16_F:
+            case TexelFormat::RGB32_U: case TexelFormat::RGB16_U: case TexelFormat::RGB8_U:
+            case TexelFormat::RGB32_S: case TexelFormat::RGB16_S: case TexelFormat::RGB8_S:
+            case TexelFormat::RGB8_UNORM: case TexelFormat::SRGB8:
+            case TexelFormat::BC1_RGB: case TexelFormat::BC1_SRGB:
+                return 3;
+
+            case TexelFormat::RG32_F: case TexelFormat::RG16_F:
+            case TexelFormat::RG32_U: case TexelFormat::RG16_U: case TexelFormat::RG8_U:
+            case TexelFormat::RG32_S: case TexelFormat::RG16_S: case TexelFormat::RG8_S:
+            case TexelFormat::RG8_UNORM:
+            case TexelFormat::BC5_RG:
+                return 2;
+
+            default:
+                return 1;
+        }
+    }
+
+    /**
+     * Функция возвращающая тип OpenGL, которым без преобразования передаются данные каждого из каналов формата.
+     * Для 16-ти битных форматов с плавающей точкой возвращается GL_HALF_FLOAT (данные типа half),
+     * для нормализованных и сжатых форматов - GL_UNSIGNED_BYTE.
+     *
+     * @param tf формат текселя
+     * @return тип канала (GL_FLOAT, GL_HALF_FLOAT, GL_UNSIGNED_BYTE, GL_INT и т.д.)
+    */
+    constexpr GLenum texelFormatType(TexelFormat tf) noexcept
+    {
+        switch (tf) {
+            case TexelFormat::RGBA32_U: case TexelFormat::RGB32_U: case TexelFormat::RG32_U: case TexelFormat::RED32_U:
+                return GL_UNSIGNED_INT;
+
+            case TexelFormat::RGBA16_U: case TexelFormat::RGB16_U: case TexelFormat::RG16_U: case TexelFormat::RED16_U:
+                return GL_UNSIGNED_SHORT;
+
+            case TexelFormat::RGBA8_U: case TexelFormat::RGB8_U: case TexelFormat::RG8_U: case TexelFormat::RED8_U:
+            case TexelFormat::RGBA8_UNORM: case TexelFormat::RGB8_UNORM: case TexelFormat::RG8_UNORM: case TexelFormat::RED8_UNORM:
+            case TexelFormat::SRGB8_ALPHA8: case TexelFormat::SRGB8:
+            case TexelFormat::BC1_RGB: case TexelFormat::BC3_RGBA: case TexelFormat::BC4_RED: case TexelFormat::BC5_RG: case TexelFormat::BC7_RGBA:
+            case TexelFormat::BC1_SRGB: case TexelFormat::BC3_SRGB_ALPHA: case TexelFormat::BC7_SRGB_ALPHA:
+                return GL_UNSIGNED_BYTE;
+
+            case TexelFormat::RGBA32_S: case TexelFormat::RGB32_S: case TexelFormat::RG32_S: case TexelFormat::RED32_S:
+                return GL_INT;
+
+            case TexelFormat::RGBA16_S: case TexelFormat::RGB16_S: case TexelFormat::RG16_S: case TexelFormat::RED16_S:
+                return GL_SHORT;
+
+            case TexelFormat::RGBA8_S: case TexelFormat::RGB8_S: case TexelFormat::RG8_S: case TexelFormat::RED8_S:
+                return GL_BYTE;
+
+            case TexelFormat::RGBA16_F: case TexelFormat::RGB16_F: case TexelFormat::RG16_F: case TexelFormat::RED16_F:
+                return GL_HALF_FLOAT;
+
+            default:
+                return GL_FLOAT;
+        }
+    }
+
+    /**
+     * Функция проверяющая, является ли формат целочисленным (не нормализованным).
+     * Такие форматы читаются и записываются только с форматом пикселя *_INTEGER.
+     *
+     * @param tf формат текселя
+     * @return true - если формат целочисленный, иначе false
+    */
+    constexpr bool isIntegerFormat(TexelFormat tf) noexcept
+    {
+        switch (tf) {
+            case TexelFormat::RGBA32_U: case TexelFormat::RGBA16_U: case TexelFormat::RGBA8_U:
+            case TexelFormat::RGBA32_S: case TexelFormat::RGBA16_S: case TexelFormat::RGBA8_S:
+            case TexelFormat::RGB32_U: case TexelFormat::RGB16_U: case TexelFormat::RGB8_U:
+            case TexelFormat::RGB32_S: case TexelFormat::RGB16_S: case TexelFormat::RGB8_S:
+            case TexelFormat::RG32_U: case TexelFormat::RG16_U: case TexelFormat::RG8_U:
+            case TexelFormat::RG32_S: case TexelFormat::RG16_S: case TexelFormat::RG8_S:
+            case TexelFormat::RED32_U: case TexelFormat::RED16_U: case TexelFormat::RED8_U:
+            case TexelFormat::RED32_S: case TexelFormat::RED16_S: case TexelFormat::RED8_S:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * Функция проверяющая, является ли формат блочно-сжатым (BC1 - BC7).
+     *
+     * @param tf формат текселя
+     * @return true - если формат сжатый, иначе false
+    */
+    constexpr bool isCompressedFormat(TexelFormat tf) noexcept
+    {
+        switch (tf) {
+            case TexelFormat::BC1_RGB: case TexelFormat::BC3_RGBA: case TexelFormat::BC4_RED:
+            case TexelFormat::BC5_RG: case TexelFormat::BC7_RGBA:
+            case TexelFormat::BC1_SRGB: case TexelFormat::BC3_SRGB_ALPHA: case TexelFormat::BC7_SRGB_ALPHA:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * Функция проверяющая, хранит ли формат цвет в пространстве sRGB.
+     * При выборке из таких текстур GPU сам переводит цвет в линейное пространство.
+     *
+     * @param tf формат текселя
+     * @return true - если формат sRGB, иначе false
+    */
+    constexpr bool isSRGB(TexelFormat tf) noexcept
+    {
+        switch (tf) {
+            case TexelFormat::SRGB8_ALPHA8: case TexelFormat::SRGB8:
+            case TexelFormat::BC1_SRGB: case TexelFormat::BC3_SRGB_ALPHA: case TexelFormat::BC7_SRGB_ALPHA:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * Функция возвращающая формат без sRGB с тем же расположением данных
+     * (например для SRGB8_ALPHA8 возвращается RGBA8_UNORM). Остальные форматы возвращаются без изменений.
+     *
+     * @param tf формат текселя
+     * @return линейный формат
+    */
+    constexpr TexelFormat linearFormat(TexelFormat tf) noexcept
+    {
+        switch (tf) {
+            case TexelFormat::SRGB8_ALPHA8:
+                return TexelFormat::RGBA8_UNORM;
+            case TexelFormat::SRGB8:
+                return TexelFormat::RGB8_UNORM;
+            case TexelFormat::BC1_SRGB:
+                return TexelFormat::BC1_RGB;
+            case TexelFormat::BC3_SRGB_ALPHA:
+                return TexelFormat::BC3_RGBA;
+            case TexelFormat::BC7_SRGB_ALPHA:
+                return TexelFormat::BC7_RGBA;
+            default:
+                return tf;
+        }
+    }
+
+    /**
+     * Функция возвращающая размер блока 4x4 сжатого формата в байтах.
+     *
+     * @param tf формат текселя
+     * @return размер блока (0 - если формат не сжатый)
+    */
+    constexpr size_t compressedBlockSize(TexelFormat tf) noexcept
+    {
+        switch (tf) {
+            case TexelFormat::BC1_RGB: case TexelFormat::BC1_SRGB: case TexelFormat::BC4_RED:
+                return 8;
+
+            case TexelFormat::BC3_RGBA: case TexelFormat::BC3_SRGB_ALPHA: case TexelFormat::BC5_RG:
+            case TexelFormat::BC7_RGBA: case TexelFormat::BC7_SRGB_ALPHA:
+                return 16;
+
+            default:
+                return 0;
+        }
+    }
+
+    /**
+     * Функция проверяющая, поддерживает ли драйвер формат.
+     * BC1 и BC3 требуют GL_EXT_texture_compression_s3tc, BC7 - GL_ARB_texture_compression_bptc.
+     * Должна вызываться после инициализации OpenGL.
+     *
+     * @param tf формат текселя
+     * @return true - если формат поддерживается, иначе false
+    */
+    inline bool isTexelFormatSupported(TexelFormat tf) noexcept
+    {
+        switch (tf) {
+            case TexelFormat::BC1_RGB: case TexelFormat::BC3_RGBA:
+            case TexelFormat::BC1_SRGB: case TexelFormat::BC3_SRGB_ALPHA:
+                return GLEW_EXT_texture_compression_s3tc;
+
+            case TexelFormat::BC7_RGBA: case TexelFormat::BC7_SRGB_ALPHA:
+                return GLEW_ARB_texture_compression_bptc;
+
+            default:
+                return true;
+        }
+    }
+
+    /**
+     * Функция возвращающая формат пикселя (GL_RGBA, GL_RGB_INTEGER и т.д.),
+     * которым передаются данные формата tf.
+     *
+     * @param tf формат текселя
+     * @return формат пикселя
+    */
+    constexpr GLenum pixelFormat(TexelFormat tf) noexcept
+    {
+        const bool integer = isIntegerFormat(tf);
+
+        switch (numberOfChannels(tf)) {
+            case 4:
+                return integer ? GL_RGBA_INTEGER : GL_RGBA;
+            case 3:
+                return integer ? GL_RGB_INTEGER : GL_RGB;
+            case 2:
+                return integer ? GL_RG_INTEGER : GL_RG;
+            default:
+                return integer ? GL_RED_INTEGER : GL_RED;
+        }
+    }
+
+    /**
+     * Свойства формата текселя, необходимые для передачи данных между CPU и GPU без преобразований.
+     *
+     * @field DataType тип каждого из каналов
+     * @field format формат пикселя
+     * @field type тип OpenGL канала
+     * @field channels количество каналов
+     * @field bytesPerPixel количество байт на пиксель
+     * @template Tf формат текселя
+    */
+    template<TexelFormat Tf>
+    struct TexelFormatTraits
+    {
+        static constexpr GLenum type = texelFormatType(Tf);
+        static constexpr GLenum format = pixelFormat(Tf);
+        static constexpr size_t channels = numberOfChannels(Tf);
+
+        using DataType =
+            conditional_t<type == GL_UNSIGNED_INT, uint32_t,
+            conditional_t<type == GL_UNSIGNED_SHORT, uint16_t,
+            conditional_t<type == GL_UNSIGNED_BYTE, uint8_t,
+            conditional_t<type == GL_INT, int32_t,
+            conditional_t<type == GL_SHORT, int16_t,
+            conditional_t<type == GL_BYTE, int8_t,
+            conditional_t<type == GL_HALF_FLOAT, half, float>>>>>>>;
+
+        static constexpr size_t bytesPerPixel = sizeof(DataType) * channels;
     };
 
     /**
@@ -74,6 +365,7 @@ namespace WOGL
      * 
      * @field NEVER res[0.0, 0.0]
      * @field LESS res[1.0, 0.0] r < Dt r >= Dt
+     * @field LEQUAL res[1.0, 0.0] r <= Dt r > Dt
      * @field GREATER  res[1.0, 0.0] r > Dt r <= Dt
      * @field GEQUAL res[1.0, 0.0] r >= Dt r < Dt
      * @field EQUAL res[1.0, 0.0] r = Dt r ≠ Dt
@@ -84,6 +376,7 @@ namespace WOGL
     {
         NEVER = GL_NEVER,
         LESS = GL_LESS,
+        LEQUAL = GL_LEQUAL,
         GREATER = GL_GREATER,
         GEQUAL = GL_GEQUAL,
         EQUAL = GL_EQUAL,
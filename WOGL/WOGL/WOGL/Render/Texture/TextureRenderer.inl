@@ -8,8 +8,13 @@
 
 #include <GL/glew.h>
 
+#include <memory>
+#include <stdexcept>
+
 namespace WOGL
 {
+    class Sampler;
+
     class ITextureRenderer
     {
     public:
@@ -31,11 +36,27 @@ namespace WOGL
          * @return формат текселя
         */
         virtual inline TexelFormat texelFormat() const noexcept = 0;
+
+        /**
+         * Метод возвращающий сэмплер, который привязывается к слоту вместе с текстурой.
+         *
+         * @return сэмплер или nullptr, если используются параметры самой текстуры
+        */
+        virtual inline const Sampler* sampler() const noexcept = 0;
     };
 
     class BaseTextureRenderer :
         public ITextureRenderer
     {
+        friend class PixelReadback;
+        friend class InitializeCubeMapTextureRenderer;
+        friend class WtexFile;
+        friend class ImageCompute;
+        friend class SinglePassDownsampler;
+
+        template<TexelFormat Tf>
+        friend class BaseFramebuffer;
+
     public:
         inline BaseTextureRenderer()
         {
@@ -47,7 +68,8 @@ namespace WOGL
         }
 
         inline BaseTextureRenderer(BaseTextureRenderer&& texture) :
-            _textureRendererHandle{0}
+            _textureRendererHandle{0},
+            _sampler{move(texture._sampler)}
         {
             swap(_textureRendererHandle, texture._textureRendererHandle);
         }
@@ -74,6 +96,22 @@ namespace WOGL
             return _textureRendererHandle;
         }
 
+        /**
+         * Метод задающий сэмплер текстуры. Сэмплер привязывается к тому же слоту, что и текстура
+         * (через BindingTracker или Context::draw), поэтому параметры фильтрации не нужно задавать перед отрисовкой.
+         *
+         * @param sampler сэмплер (например из SamplerCache) или nullptr
+        */
+        void setSampler(shared_ptr<const Sampler> sampler) noexcept
+        {
+            _sampler = move(sampler);
+        }
+
+        virtual inline const Sampler* sampler() const noexcept override
+        {
+            return _sampler.get();
+        }
+
     protected:
         template<typename T>
         static GLenum _type() noexcept
@@ -92,11 +130,14 @@ namespace WOGL
                 type = GL_UNSIGNED_SHORT;
             } else if constexpr (is_same_v<T, uint32_t>) {
                 type = GL_UNSIGNED_INT;
-            } 
+            } else if constexpr (is_same_v<T, half>) {
+                type = GL_HALF_FLOAT;
+            }
 
             return type;
         }
 
         uint32_t _textureRendererHandle;
+        shared_ptr<const Sampler> _sampler;
     };
 }
@@ -7,6 +7,7 @@
 //
 
 #include "TextureRenderer.hpp"
+#include "../Buffers/StagingBuffer.hpp"
 #include "../../Data/Texture1D.hpp"
 
 #include <memory>
@@ -113,6 +114,7 @@ namespace WOGL
         template<typename DataType, TexelType Tx>
         inline void update(const Texture1D<DataType, Tx>& texture)
         {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
             glTexSubImage1D(GL_TEXTURE_1D, 0, 0, _size, static_cast<GLenum>(Tx), _type<DataType>(), &texture._data[0]);
         }
 
@@ -124,6 +126,7 @@ namespace WOGL
         template<typename DataType, TexelType Tx, typename DelType, template<typename, typename> typename Ptr>
         inline void update(const Ptr<Texture1D<DataType, Tx>, DelType>& texture)
         {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
             glTexSubImage1D(GL_TEXTURE_1D, 0, 0, _size, static_cast<GLenum>(Tx), _type<DataType>(), &texture->_data[0]);
         }
         
@@ -135,9 +138,30 @@ namespace WOGL
         template<typename DataType, TexelType Tx, template<typename> typename Ptr>
         inline void update(const Ptr<Texture1D<DataType, Tx>>& texture)
         {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
             glTexSubImage1D(GL_TEXTURE_1D, 0, 0, _size, static_cast<GLenum>(Tx), _type<DataType>(), &texture->_data[0]);
         }
 
+        /**
+         * Метод предназначенный для асинхронного обновления данных объекта.
+         * Данные копируются в staging, а загрузка выполняется из него, поэтому поток отрисовки не ждёт копирования драйвером.
+         *
+         * @param texture текстура котороя будет помещена в памя GPU
+         * @param staging буфер для загрузки
+         * @throw invalid_argument в случае если размер текстуры больше размера staging
+        */
+        template<typename DataType, TexelType Tx>
+        void update(const Texture1D<DataType, Tx>& texture, StagingBuffer& staging)
+        {
+            glBindTexture(GL_TEXTURE_1D, _textureRendererHandle);
+
+            staging.upload(&texture._data[0], texture._data.size() * sizeof(DataType), [this] (const void* offset) {
+                glTexSubImage1D(GL_TEXTURE_1D, 0, 0, _size, static_cast<GLenum>(Tx), _type<DataType>(), offset);
+            });
+
+            glBindTexture(GL_TEXTURE_1D, 0);
+        }
+
         /**
          * Метод необходимый для определения способа увеличения текстуры.
          *
@@ -9,9 +9,18 @@
 #include <GL/glew.h>
 
 #include "../../Data/Texture2D.hpp"
+#include "../../Data/MipChain.hpp"
+#include "../../Data/BlockCompression.hpp"
 #include "TextureMappingSetting.hpp"
 
 #include "TextureRenderer.hpp"
+#include "WtexFile.hpp"
+#include "../Buffers/StagingBuffer.hpp"
+
+#include <cassert>
+
+#include <algorithm>
+#include <stdexcept>
 
 namespace WOGL
 {
@@ -36,10 +45,12 @@ namespace WOGL
         explicit BaseTextureRenderer2D(const TextureType& texture, TexelFormat tf) :
             BaseTextureRenderer(),
             _height{static_cast<int32_t>(texture._height)},
-            _width{static_cast<int32_t>(texture._height)}
+            _width{static_cast<int32_t>(texture._width)},
+            _levels{static_cast<int32_t>(numberOfMipLevels(_width, _height))},
+            _texelFormat{tf}
         {
             glBindTexture(GL_TEXTURE_2D, _textureRendererHandle);
-            glTexStorage2D(GL_TEXTURE_2D, 1, static_cast<GLenum>(tf), _height, _width);
+            _allocate();
             update(texture);
             glBindTexture(GL_TEXTURE_2D, 0);
         }
@@ -56,10 +67,12 @@ namespace WOGL
         explicit BaseTextureRenderer2D(const Ptr<TextureType, DelType>& texture, TexelFormat tf) :
             BaseTextureRenderer(),
             _height{static_cast<int32_t>(texture->_height)},
-            _width{static_cast<int32_t>(texture->_height)}
+            _width{static_cast<int32_t>(texture->_width)},
+            _levels{static_cast<int32_t>(numberOfMipLevels(_width, _height))},
+            _texelFormat{tf}
         {
             glBindTexture(GL_TEXTURE_2D, _textureRendererHandle);
-            glTexStorage2D(GL_TEXTURE_2D, 1, static_cast<GLenum>(tf), _height, _width);
+            _allocate();
             update(texture);
             glBindTexture(GL_TEXTURE_2D, 0);
         }
@@ -76,10 +89,12 @@ namespace WOGL
         explicit BaseTextureRenderer2D(const Ptr<TextureType>& texture, TexelFormat tf) :
             BaseTextureRenderer(),
             _height{static_cast<int32_t>(texture->_height)},
-            _width{static_cast<int32_t>(texture->_height)}
+            _width{static_cast<int32_t>(texture->_width)},
+            _levels{static_cast<int32_t>(numberOfMipLevels(_width, _height))},
+            _texelFormat{tf}
         {
             glBindTexture(GL_TEXTURE_2D, _textureRendererHandle);
-            glTexStorage2D(GL_TEXTURE_2D, 1, static_cast<GLenum>(tf), _height, _width);
+            _allocate();
             update(texture);
             glBindTexture(GL_TEXTURE_2D, 0);
         }
@@ -90,24 +105,29 @@ namespace WOGL
          * @param width ширина 
          * @param height высота
          * @param tf формат текскля
+         * @param levels количество уровней mipmap'а (если 0, то выделяется полная цепочка)
          * @throw в случае если width или height равны нулю
         */
-        explicit BaseTextureRenderer2D(int32_t width, int32_t height, TexelFormat tf) :
+        explicit BaseTextureRenderer2D(int32_t width, int32_t height, TexelFormat tf, int32_t levels = 0) :
             BaseTextureRenderer(),
             _height{height},
-            _width{width}
+            _width{width},
+            _levels{levels > 0 ? levels : static_cast<int32_t>(numberOfMipLevels(width, height))},
+            _texelFormat{tf}
         {
             assert(!(width == 0 || _height == 0));
 
             glBindTexture(GL_TEXTURE_2D, _textureRendererHandle);
-            glTexStorage2D(GL_TEXTURE_2D, 1, static_cast<GLenum>(tf), _height, _width);
+            _allocate();
             glBindTexture(GL_TEXTURE_2D, 0);
         }
 
         BaseTextureRenderer2D(BaseTextureRenderer2D&& texture) :
             BaseTextureRenderer{move(texture)},
             _height{texture._height},
-            _width{texture._width}
+            _width{texture._width},
+            _levels{texture._levels},
+            _texelFormat{texture._texelFormat}
         {
         }
 
@@ -131,7 +151,8 @@ namespace WOGL
         template<typename DataType, TexelType Tx>
         void update(const Texture2D<DataType, Tx>& texture)
         {
-            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _height, _width, static_cast<GLenum>(Tx), _type<DataType>(), &texture._data[0]);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _width, _height, static_cast<GLenum>(Tx), _type<DataType>(), &texture._data[0]);
         }
 
         /**
@@ -142,7 +163,8 @@ namespace WOGL
         template<typename DataType, TexelType Tx, typename DelType, template<typename, typename> typename Ptr>
         void update(const Ptr<Texture2D<DataType, Tx>, DelType>& texture)
         {
-            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _height, _width, static_cast<GLenum>(Tx), _type<DataType>(), &texture->_data[0]);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _width, _height, static_cast<GLenum>(Tx), _type<DataType>(), &texture->_data[0]);
         }
 
         /**
@@ -153,8 +175,211 @@ namespace WOGL
         template<typename DataType, TexelType Tx, template<typename> typename Ptr>
         void update(const Ptr<Texture2D<DataType, Tx>>& texture)
         {
-            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _height, _width, static_cast<GLenum>(Tx), _type<DataType>(), &texture->_data[0]);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _width, _height, static_cast<GLenum>(Tx), _type<DataType>(), &texture->_data[0]);
+        }
+
+        /**
+         * Метод обновляющий часть уровня текстуры.
+         *
+         * @param texture текстура котороя будет помещена в памя GPU
+         * @param x смещение по столбцам
+         * @param y смещение по строкам
+         * @param level уровень mipmap'а
+         * @throw invalid_argument в случае если texture не вписывается в уровень
+        */
+        template<typename DataType, TexelType Tx>
+        void update(const Texture2D<DataType, Tx>& texture, int32_t x, int32_t y, int32_t level = 0)
+        {
+            _checkRegion(x, y, static_cast<int32_t>(texture._width), static_cast<int32_t>(texture._height), level);
+
+            glBindTexture(GL_TEXTURE_2D, _textureRendererHandle);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glTexSubImage2D(GL_TEXTURE_2D, level, x, y, texture._width, texture._height, static_cast<GLenum>(Tx), _type<DataType>(), &texture._data[0]);
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+
+        /**
+         * Метод копирующий часть другой текстуры (или этой же) в эту текстуру целиком на стороне GPU.
+         * Используется glCopyImageSubData (ARB_copy_image), а без него - glCopyTexSubImage2D из временного framebuffer'а.
+         * Без ARB_copy_image нельзя копировать сжатые текстуры и области внутри одной текстуры.
+         *
+         * @param src текстура, из которой копируются тексели
+         * @param srcX, srcY положение области в src
+         * @param dstX, dstY положение области в этой текстуре
+         * @param width, height размер области
+         * @param srcLevel уровень mipmap'а src
+         * @param dstLevel уровень mipmap'а этой текстуры
+         * @throw invalid_argument в случае если область не вписывается в одну из текстур
+         * @throw runtime_error в случае если копирование не поддерживается
+        */
+        void copy(const BaseTextureRenderer2D& src, int32_t srcX, int32_t srcY, int32_t dstX, int32_t dstY, int32_t width, int32_t height,
+                  int32_t srcLevel = 0, int32_t dstLevel = 0)
+        {
+            src._checkRegion(srcX, srcY, width, height, srcLevel);
+            _checkRegion(dstX, dstY, width, height, dstLevel);
+
+            if (GLEW_ARB_copy_image) {
+                glCopyImageSubData(src._textureRendererHandle, GL_TEXTURE_2D, srcLevel, srcX, srcY, 0,
+                                   _textureRendererHandle, GL_TEXTURE_2D, dstLevel, dstX, dstY, 0, width, height, 1);
+                return;
+            }
+
+            if (&src == this || isCompressedFormat(_texelFormat) || isCompressedFormat(src._texelFormat)) {
+                throw runtime_error("Texture copy requires ARB_copy_image");
+            }
+
+            GLint previous;
+            GLuint framebuffer;
+
+            glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previous);
+            glGenFramebuffers(1, &framebuffer);
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+            glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, src._textureRendererHandle, srcLevel);
+
+            glBindTexture(GL_TEXTURE_2D, _textureRendererHandle);
+            glCopyTexSubImage2D(GL_TEXTURE_2D, dstLevel, dstX, dstY, srcX, srcY, width, height);
+            glBindTexture(GL_TEXTURE_2D, 0);
+
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previous));
+            glDeleteFramebuffers(1, &framebuffer);
+        }
+
+        /**
+         * Метод предназначенный для асинхронного обновления данных объекта.
+         * Данные копируются в staging, а загрузка выполняется из него, поэтому поток отрисовки не ждёт копирования драйвером.
+         *
+         * @param texture текстура котороя будет помещена в памя GPU
+         * @param staging буфер для загрузки
+         * @throw invalid_argument в случае если размер текстуры больше размера staging
+        */
+        template<typename DataType, TexelType Tx>
+        void update(const Texture2D<DataType, Tx>& texture, StagingBuffer& staging)
+        {
+            glBindTexture(GL_TEXTURE_2D, _textureRendererHandle);
+
+            staging.upload(&texture._data[0], texture._data.size() * sizeof(DataType), [this] (const void* offset) {
+                glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _width, _height, static_cast<GLenum>(Tx), _type<DataType>(), offset);
+            });
+
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+
+        /**
+         * Метод загружающий в GPU все уровни mipmap-цепочки за один проход.
+         * Уровни, которых нет в chain или в выделенной памяти, не загружаются.
+         *
+         * @param chain mipmap-цепочка
+         * @throw invalid_argument в случае если размер нулевого уровня не совпадает с размером текстуры
+        */
+        template<typename DataType, TexelType Tx>
+        void update(const MipChain2D<DataType, Tx>& chain)
+        {
+            _checkMipChain(chain);
+
+            glBindTexture(GL_TEXTURE_2D, _textureRendererHandle);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+            const int32_t levels = min(static_cast<int32_t>(chain.numberOfLevels()), _levels);
+
+            for (int32_t i{0}; i < levels; i++) {
+                glTexSubImage2D(GL_TEXTURE_2D, i, 0, 0, chain.width(i), chain.height(i), static_cast<GLenum>(Tx), _type<DataType>(), chain.data(i));
+            }
+
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+
+        /**
+         * Метод асинхронно загружающий в GPU все уровни mipmap-цепочки за один проход через staging.
+         *
+         * @param chain mipmap-цепочка
+         * @param staging буфер для загрузки
+         * @throw invalid_argument в случае если размер нулевого уровня не совпадает с размером текстуры
+         * или если размер цепочки больше размера staging
+        */
+        template<typename DataType, TexelType Tx>
+        void update(const MipChain2D<DataType, Tx>& chain, StagingBuffer& staging)
+        {
+            _checkMipChain(chain);
+
+            glBindTexture(GL_TEXTURE_2D, _textureRendererHandle);
+
+            const int32_t levels = min(static_cast<int32_t>(chain.numberOfLevels()), _levels);
+
+            staging.upload(chain.data(), chain.sizeInBytes(), [this, &chain, levels] (const void* offset) {
+                for (int32_t i{0}; i < levels; i++) {
+                    const auto levelOffset = static_cast<const uint8_t*>(offset) + (chain.data(i) - chain.data()) * sizeof(DataType);
+                    glTexSubImage2D(GL_TEXTURE_2D, i, 0, 0, chain.width(i), chain.height(i), static_cast<GLenum>(Tx), _type<DataType>(), levelOffset);
+                }
+            });
+
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+
+        /**
+         * Метод загружающий в GPU сжатую текстуру (все её уровни, которые помещаются в выделенную память).
+         * Формат сжатия должен совпадать с форматом текселя объекта с точностью до sRGB
+         * (например BlockFormat::BC7 можно загрузить в TexelFormat::BC7_SRGB_ALPHA).
+         *
+         * @param texture сжатая текстура
+         * @throw invalid_argument в случае если размер нулевого уровня или формат не совпадает с размером или форматом текстуры
+        */
+        void update(const CompressedTexture2D& texture)
+        {
+            _checkMipChain(texture);
+
+            if (static_cast<GLenum>(linearFormat(_texelFormat)) != static_cast<GLenum>(texture.format())) {
+                throw invalid_argument("Block format does not match texel format");
+            }
+
+            glBindTexture(GL_TEXTURE_2D, _textureRendererHandle);
+
+            const int32_t levels = min(static_cast<int32_t>(texture.numberOfLevels()), _levels);
+
+            for (int32_t i{0}; i < levels; i++) {
+                glCompressedTexSubImage2D(GL_TEXTURE_2D, i, 0, 0, texture.width(i), texture.height(i), static_cast<GLenum>(_texelFormat),
+                                          static_cast<GLsizei>(texture.size(i)), texture.data(i));
+            }
+
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+            glBindTexture(GL_TEXTURE_2D, 0);
         }
+
+        /**
+         * Метод загружающий в GPU уровни .wtex файла прямо из отображённой в память области файла,
+         * без декодирования, преобразования и промежуточных копий.
+         *
+         * @param file .wtex файл
+         * @throw invalid_argument в случае если размер нулевого уровня или формат файла не совпадает с размером или форматом текстуры
+        */
+        void update(const WtexFile& file)
+        {
+            _checkMipChain(file);
+
+            if (static_cast<GLenum>(_texelFormat) != static_cast<GLenum>(file.format())) {
+                throw invalid_argument("Wtex file format does not match texel format");
+            }
+
+            glBindTexture(GL_TEXTURE_2D, _textureRendererHandle);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+            const int32_t levels = min(static_cast<int32_t>(file.numberOfLevels()), _levels);
+
+            for (int32_t i{0}; i < levels; i++) {
+                if (file.compressed()) {
+                    glCompressedTexSubImage2D(GL_TEXTURE_2D, i, 0, 0, file.width(i), file.height(i), static_cast<GLenum>(_texelFormat),
+                                              static_cast<GLsizei>(file.size(i)), file.data(i));
+                } else {
+                    glTexSubImage2D(GL_TEXTURE_2D, i, 0, 0, file.width(i), file.height(i), file._header.pixelFormat, file._header.type, file.data(i));
+                }
+            }
+
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+
         /**
          * Метод необходимый для определения способа увеличения текстуры.
          *
@@ -192,7 +417,7 @@ namespace WOGL
         */
         static inline void textureWrappingT(const TextureWrapping wt) noexcept
         {
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, static_cast<GLenum>(wt));
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, static_cast<GLenum>(wt));
         }
         
         /**
@@ -230,9 +455,47 @@ namespace WOGL
             return _height;
         }
 
+        /**
+         * Метод возвращающий количество выделенных уровней mipmap'а.
+         *
+         * @return количество уровней
+        */
+        inline int32_t levels() const noexcept
+        {
+            return _levels;
+        }
+
     protected:
+        /**
+         * Метод выделяющий память под все уровни. Пока уровни не загружены,
+         * GL_TEXTURE_MAX_LEVEL равен 0, поэтому текстура остаётся полной при любом фильтре.
+        */
+        void _allocate() const noexcept
+        {
+            glTexStorage2D(GL_TEXTURE_2D, _levels, static_cast<GLenum>(_texelFormat), _width, _height);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        }
+
+        void _checkRegion(int32_t x, int32_t y, int32_t width, int32_t height, int32_t level) const
+        {
+            if (level < 0 || level >= _levels || x < 0 || y < 0 ||
+                x + width > max(_width >> level, 1) || y + height > max(_height >> level, 1)) {
+                throw invalid_argument("The region does not fit in the texture");
+            }
+        }
+
+        template<typename Chain>
+        void _checkMipChain(const Chain& chain) const
+        {
+            if (static_cast<int32_t>(chain.width(0)) != _width || static_cast<int32_t>(chain.height(0)) != _height) {
+                throw invalid_argument("Mip chain size does not match texture size");
+            }
+        }
+
         int32_t _height;
         int32_t _width;
+        int32_t _levels;
+        TexelFormat _texelFormat;
     };
 
     template<TexelFormat Tf>
@@ -260,9 +523,10 @@ namespace WOGL
          * 
          * @param width ширина 
          * @param height высота
+         * @param levels количество уровней mipmap'а (если 0, то выделяется полная цепочка)
         */
-        explicit TextureRenderer2D(int32_t width, int32_t height) :
-            BaseTextureRenderer2D(width, height, Tf)
+        explicit TextureRenderer2D(int32_t width, int32_t height, int32_t levels = 0) :
+            BaseTextureRenderer2D(width, height, Tf, levels)
         {
         }
 
@@ -280,6 +544,7 @@ namespace WOGL
         */
          virtual inline void genMipmap() const noexcept override
          {
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, _levels - 1);
             glGenerateMipmap(GL_TEXTURE_2D);
          }
 
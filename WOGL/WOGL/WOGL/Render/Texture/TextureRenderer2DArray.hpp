@@ -0,0 +1,14 @@
+//
+//  TextureRenderer2DArray.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef TextureRenderer2DArray_hpp
+#define TextureRenderer2DArray_hpp
+
+#include "TextureRenderer2DArray.inl"
+
+#endif /* TextureRenderer2DArray_hpp */
@@ -0,0 +1,404 @@
+//
+//  TextureRenderer2DArray.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <GL/glew.h>
+
+#include "../../Data/Texture2D.hpp"
+#include "../../Data/MipChain.hpp"
+#include "../../Data/BlockCompression.hpp"
+#include "TextureMappingSetting.hpp"
+
+#include "TextureRenderer.hpp"
+
+#include <cassert>
+
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+
+namespace WOGL
+{
+    /**
+     * Массив двумерных текстур (GL_TEXTURE_2D_ARRAY) одного размера и формата.
+     * Текстуры разных материалов хранятся в слоях одного объекта, поэтому между их отрисовками не нужно
+     * перепривязывать текстуры: в шейдер передаётся только номер слоя (sampler2DArray, texture(s, vec3(uv, layer))).
+     *
+     * Слои выделяются методом allocate (или insert) и освобождаются методом release.
+     *
+     * GL_TEXTURE_MAX_LEVEL общий для всех слоёв, поэтому он равен наименьшему количеству загруженных уровней
+     * среди выделенных слоёв, в которые что-то загружено. Слой, в который загружен только нулевой уровень,
+     * ограничивает выборку нулевым уровнем для всего массива, пока не будет вызван genMipmap().
+    */
+    class BaseTextureRenderer2DArray :
+        public BaseTextureRenderer
+    {
+    protected:
+        /**
+         * Конструктор.
+         *
+         * Выделенную в GPU память нельзя будет изменить !!!
+         *
+         * @param width ширина слоя
+         * @param height высота слоя
+         * @param layers количество слоёв
+         * @param tf формат текселя
+         * @param levels количество уровней mipmap'а (если 0, то выделяется полная цепочка)
+        */
+        explicit BaseTextureRenderer2DArray(int32_t width, int32_t height, int32_t layers, TexelFormat tf, int32_t levels = 0) :
+            BaseTextureRenderer(),
+            _width{width},
+            _height{height},
+            _layers{layers},
+            _levels{levels > 0 ? levels : static_cast<int32_t>(numberOfMipLevels(width, height))},
+            _texelFormat{tf},
+            _layerLevels(layers, 0)
+        {
+            assert(!(width == 0 || height == 0 || layers == 0));
+
+            glBindTexture(GL_TEXTURE_2D_ARRAY, _textureRendererHandle);
+            glTexStorage3D(GL_TEXTURE_2D_ARRAY, _levels, static_cast<GLenum>(_texelFormat), _width, _height, _layers);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+            _freeLayers.reserve(_layers);
+
+            for (int32_t i{_layers - 1}; i >= 0; i--) {
+                _freeLayers.push_back(i);
+            }
+        }
+
+        BaseTextureRenderer2DArray(BaseTextureRenderer2DArray&& textureArray) :
+            BaseTextureRenderer{move(textureArray)},
+            _width{textureArray._width},
+            _height{textureArray._height},
+            _layers{textureArray._layers},
+            _levels{textureArray._levels},
+            _texelFormat{textureArray._texelFormat},
+            _freeLayers{move(textureArray._freeLayers)},
+            _layerLevels{move(textureArray._layerLevels)}
+        {
+        }
+
+        BaseTextureRenderer2DArray(const BaseTextureRenderer2DArray&) = delete;
+        BaseTextureRenderer2DArray& operator=(const BaseTextureRenderer2DArray&) = delete;
+        BaseTextureRenderer2DArray& operator=(BaseTextureRenderer2DArray&&) = delete;
+
+    public:
+        /**
+         * Метод выделяющий свободный слой.
+         *
+         * @return номер слоя или nullopt, если свободных слоёв нет
+        */
+        optional<int32_t> allocate() noexcept
+        {
+            if (_freeLayers.empty()) {
+                return nullopt;
+            }
+
+            const int32_t layer = _freeLayers.back();
+            _freeLayers.pop_back();
+
+            return layer;
+        }
+
+        /**
+         * Метод освобождающий слой. Данные слоя не очищаются.
+         *
+         * @param layer номер слоя
+         * @throw out_of_range в случае если слой не существует или уже свободен
+        */
+        void release(int32_t layer)
+        {
+            if (layer < 0 || layer >= _layers || find(_freeLayers.begin(), _freeLayers.end(), layer) != _freeLayers.end()) {
+                throw out_of_range("Invalid texture array layer");
+            }
+
+            _freeLayers.push_back(layer);
+
+            if (_layerLevels[layer]) {
+                _layerLevels[layer] = 0;
+
+                glBindTexture(GL_TEXTURE_2D_ARRAY, _textureRendererHandle);
+                _updateMaxLevel();
+                glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+            }
+        }
+
+        /**
+         * Метод выделяющий слой и загружающий в него текстуру.
+         *
+         * @param texture текстура (или mipmap-цепочка, или сжатая текстура)
+         * @return номер слоя или nullopt, если свободных слоёв нет
+         * @throw invalid_argument в случае если размер текстуры не совпадает с размером слоя
+        */
+        template<typename TextureType>
+        optional<int32_t> insert(const TextureType& texture)
+        {
+            _checkSize(texture.width(), texture.height());
+
+            const auto layer = allocate();
+
+            if (layer) {
+                update(texture, *layer);
+            }
+
+            return layer;
+        }
+
+        /**
+         * Метод загружающий текстуру в нулевой уровень слоя.
+         * Остальные уровни слоя после этого не используются, пока не будет вызван genMipmap().
+         *
+         * @param texture текстура
+         * @param layer номер слоя
+         * @throw invalid_argument в случае если размер текстуры не совпадает с размером слоя
+         * @throw out_of_range в случае если слой не существует
+        */
+        template<typename DataType, TexelType Tx>
+        void update(const Texture2D<DataType, Tx>& texture, int32_t layer)
+        {
+            _checkSize(texture._width, texture._height);
+            _checkLayer(layer);
+
+            glBindTexture(GL_TEXTURE_2D_ARRAY, _textureRendererHandle);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, _width, _height, 1, static_cast<GLenum>(Tx), _type<DataType>(), &texture._data[0]);
+
+            _layerLevels[layer] = 1;
+            _updateMaxLevel();
+            glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        }
+
+        /**
+         * Метод загружающий в слой все уровни mipmap-цепочки.
+         *
+         * @param chain mipmap-цепочка
+         * @param layer номер слоя
+         * @throw invalid_argument в случае если размер нулевого уровня не совпадает с размером слоя
+         * @throw out_of_range в случае если слой не существует
+        */
+        template<typename DataType, TexelType Tx>
+        void update(const MipChain2D<DataType, Tx>& chain, int32_t layer)
+        {
+            _checkSize(chain.width(0), chain.height(0));
+            _checkLayer(layer);
+
+            glBindTexture(GL_TEXTURE_2D_ARRAY, _textureRendererHandle);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+            const int32_t levels = min(static_cast<int32_t>(chain.numberOfLevels()), _levels);
+
+            for (int32_t i{0}; i < levels; i++) {
+                glTexSubImage3D(GL_TEXTURE_2D_ARRAY, i, 0, 0, layer, chain.width(i), chain.height(i), 1, static_cast<GLenum>(Tx), _type<DataType>(), chain.data(i));
+            }
+
+            _layerLevels[layer] = levels;
+            _updateMaxLevel();
+            glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        }
+
+        /**
+         * Метод загружающий в слой сжатую текстуру (все её уровни, которые помещаются в выделенную память).
+         *
+         * @param texture сжатая текстура
+         * @param layer номер слоя
+         * @throw invalid_argument в случае если размер или формат текстуры не совпадает с размером или форматом слоя
+         * @throw out_of_range в случае если слой не существует
+        */
+        void update(const CompressedTexture2D& texture, int32_t layer)
+        {
+            _checkSize(texture.width(), texture.height());
+            _checkLayer(layer);
+
+            if (static_cast<GLenum>(linearFormat(_texelFormat)) != static_cast<GLenum>(texture.format())) {
+                throw invalid_argument("Block format does not match texel format");
+            }
+
+            glBindTexture(GL_TEXTURE_2D_ARRAY, _textureRendererHandle);
+
+            const int32_t levels = min(static_cast<int32_t>(texture.numberOfLevels()), _levels);
+
+            for (int32_t i{0}; i < levels; i++) {
+                glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, i, 0, 0, layer, texture.width(i), texture.height(i), 1, static_cast<GLenum>(_texelFormat),
+                                          static_cast<GLsizei>(texture.size(i)), texture.data(i));
+            }
+
+            _layerLevels[layer] = levels;
+            _updateMaxLevel();
+            glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        }
+
+        static inline void magFilter(const TextureFilter mf) noexcept
+        {
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, static_cast<GLenum>(mf));
+        }
+
+        static inline void minFilter(const TextureFilter mf) noexcept
+        {
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, static_cast<GLenum>(mf));
+        }
+
+        static inline void textureWrappingS(const TextureWrapping ws) noexcept
+        {
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, static_cast<GLenum>(ws));
+        }
+
+        static inline void textureWrappingT(const TextureWrapping wt) noexcept
+        {
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, static_cast<GLenum>(wt));
+        }
+
+        inline static void unbind() noexcept
+        {
+            glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        }
+
+        int32_t width() const noexcept
+        {
+            return _width;
+        }
+
+        int32_t height() const noexcept
+        {
+            return _height;
+        }
+
+        int32_t layers() const noexcept
+        {
+            return _layers;
+        }
+
+        int32_t levels() const noexcept
+        {
+            return _levels;
+        }
+
+        /**
+         * @return количество свободных слоёв
+        */
+        size_t freeLayers() const noexcept
+        {
+            return _freeLayers.size();
+        }
+
+    protected:
+        /**
+         * Метод устанавливающий GL_TEXTURE_MAX_LEVEL привязанного массива по наименьшему количеству загруженных уровней.
+        */
+        void _updateMaxLevel() const noexcept
+        {
+            int32_t levels = _levels;
+
+            for (int32_t count: _layerLevels) {
+                if (count) {
+                    levels = min(levels, count);
+                }
+            }
+
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levels - 1);
+        }
+
+        void _checkSize(size_t width, size_t height) const
+        {
+            if (static_cast<int32_t>(width) != _width || static_cast<int32_t>(height) != _height) {
+                throw invalid_argument("Texture size does not match texture array layer size");
+            }
+        }
+
+        void _checkLayer(int32_t layer) const
+        {
+            if (layer < 0 || layer >= _layers) {
+                throw out_of_range("Invalid texture array layer");
+            }
+        }
+
+        int32_t _width;
+        int32_t _height;
+        int32_t _layers;
+        int32_t _levels;
+        TexelFormat _texelFormat;
+        vector<int32_t> _freeLayers;
+
+        /**
+         * Количество загруженных уровней каждого слоя (0 - слой свободен или в него ничего не загружено).
+        */
+        mutable vector<int32_t> _layerLevels;
+    };
+
+    /**
+     * @template Tf формат текселя
+    */
+    template<TexelFormat Tf>
+    class TextureRenderer2DArray :
+        public BaseTextureRenderer2DArray
+    {
+    public:
+        /**
+         * Конструктор.
+         *
+         * Выделенную в GPU память нельзя будет изменить !!!
+         *
+         * @param width ширина слоя
+         * @param height высота слоя
+         * @param layers количество слоёв
+         * @param levels количество уровней mipmap'а (если 0, то выделяется полная цепочка)
+        */
+        explicit TextureRenderer2DArray(int32_t width, int32_t height, int32_t layers, int32_t levels = 0) :
+            BaseTextureRenderer2DArray(width, height, layers, Tf, levels)
+        {
+        }
+
+        TextureRenderer2DArray(TextureRenderer2DArray&& textureArray) :
+            BaseTextureRenderer2DArray(forward<BaseTextureRenderer2DArray>(textureArray))
+        {
+        }
+
+        TextureRenderer2DArray(const TextureRenderer2DArray&) = delete;
+        TextureRenderer2DArray& operator=(const TextureRenderer2DArray&) = delete;
+        TextureRenderer2DArray& operator=(TextureRenderer2DArray&&) = delete;
+
+        /**
+         * Метод необходимый для генерации mipmap'а всех слоёв (после него у всех слоёв с данными загружены все уровни).
+        */
+        virtual inline void genMipmap() const noexcept override
+        {
+            for (int32_t& count: _layerLevels) {
+                if (count) {
+                    count = _levels;
+                }
+            }
+
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, _levels - 1);
+            glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+        }
+
+        /**
+         * Метод делающий массив текстур текущим.
+         *
+         * @param slot текстурный слот
+        */
+        virtual inline void bind(int32_t slot) const noexcept override
+        {
+            if (slot >= 0) {
+                glActiveTexture(GL_TEXTURE0 + slot);
+                glBindTexture(GL_TEXTURE_2D_ARRAY, _textureRendererHandle);
+            }
+        }
+
+        /**
+         * Метод возвращающий формат текселя.
+         *
+         * @return формат текселя
+        */
+        virtual inline TexelFormat texelFormat() const noexcept override
+        {
+            return Tf;
+        }
+    };
+}
@@ -7,7 +7,14 @@
 //
 
 #include "TextureRenderer.hpp"
+#include "../Buffers/StagingBuffer.hpp"
 #include "../../Data/Texture3D.hpp"
+#include "../../Data/MipChain.hpp"
+
+#include <cassert>
+
+#include <algorithm>
+#include <stdexcept>
 
 namespace WOGL
 {
@@ -28,10 +35,11 @@ namespace WOGL
             BaseTextureRenderer(),
             _width{static_cast<int32_t>(texture._width)},
             _height{static_cast<int32_t>(texture._height)},
-            _depth{static_cast<int32_t>(texture._depth)}
+            _depth{static_cast<int32_t>(texture._depth)},
+            _levels{static_cast<int32_t>(numberOfMipLevels(_width, _height, _depth))}
         {
             glBindTexture(GL_TEXTURE_3D, _textureRendererHandle);
-            glTexStorage3D(GL_TEXTURE_3D, 1, static_cast<GLenum>(tf), _width, _height, _depth);
+            _allocate(tf);
             update(texture);
             glBindTexture(GL_TEXTURE_3D, 0);
         }
@@ -49,10 +57,11 @@ namespace WOGL
             BaseTextureRenderer(),
             _width{static_cast<int32_t>(texture->_width)},
             _height{static_cast<int32_t>(texture->_height)},
-            _depth{static_cast<int32_t>(texture->_depth)}
+            _depth{static_cast<int32_t>(texture->_depth)},
+            _levels{static_cast<int32_t>(numberOfMipLevels(_width, _height, _depth))}
         {
             glBindTexture(GL_TEXTURE_3D, _textureRendererHandle);
-            glTexStorage3D(GL_TEXTURE_3D, 1, static_cast<GLenum>(tf), _width, _height, _depth);
+            _allocate(tf);
             update(texture);
             glBindTexture(GL_TEXTURE_3D, 0);
         }
@@ -70,10 +79,11 @@ namespace WOGL
             BaseTextureRenderer(),
             _width{static_cast<int32_t>(texture->_width)},
             _height{static_cast<int32_t>(texture->_height)},
-            _depth{static_cast<int32_t>(texture->_depth)}
+            _depth{static_cast<int32_t>(texture->_depth)},
+            _levels{static_cast<int32_t>(numberOfMipLevels(_width, _height, _depth))}
         {
             glBindTexture(GL_TEXTURE_3D, _textureRendererHandle);
-            glTexStorage3D(GL_TEXTURE_3D, 1, static_cast<GLenum>(tf), _width, _height, _depth);
+            _allocate(tf);
             update(texture);
             glBindTexture(GL_TEXTURE_3D, 0);
         }
@@ -87,18 +97,20 @@ namespace WOGL
          * @param height высота
          * @param depth глубина
          * @param tf формат текселя
+         * @param levels количество уровней mipmap'а (если 0, то выделяется полная цепочка)
          * @throw в случае если width, height или depth равны нулю
         */
-        explicit BaseTextureRenderer3D(int32_t width, int32_t height, int32_t depth, TexelFormat tf) :
+        explicit BaseTextureRenderer3D(int32_t width, int32_t height, int32_t depth, TexelFormat tf, int32_t levels = 0) :
             BaseTextureRenderer(),
             _width{width},
             _height{height},
-            _depth{depth}
+            _depth{depth},
+            _levels{levels > 0 ? levels : static_cast<int32_t>(numberOfMipLevels(width, height, depth))}
         {
             assert(!(width == 0 || height == 0 || depth == 0));
 
             glBindTexture(GL_TEXTURE_3D, _textureRendererHandle);
-            glTexStorage3D(GL_TEXTURE_3D, 1, static_cast<GLenum>(tf), _width, _height, _depth);
+            _allocate(tf);
             glBindTexture(GL_TEXTURE_3D, 0);
         }
 
@@ -106,11 +118,13 @@ namespace WOGL
             BaseTextureRenderer{move(texture)},
             _width{0},
             _height{0},
-            _depth{0}
+            _depth{0},
+            _levels{0}
         {
             swap(_width, texture._width);
             swap(_height, texture._height);
             swap(_depth, texture._depth);
+            swap(_levels, texture._levels);
         }
 
         BaseTextureRenderer3D(const BaseTextureRenderer3D&) = delete;
@@ -126,6 +140,7 @@ namespace WOGL
         template<typename DataType, TexelType Tx>
         inline void update(const Texture3D<DataType, Tx>& texture) noexcept
         {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
             glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, 0, _width, _height, _depth, static_cast<GLenum>(Tx), _type<DataType>(), &texture._data[0]);
         }
 
@@ -137,6 +152,7 @@ namespace WOGL
         template<typename DataType, TexelType Tx, typename DelType, template<typename, typename> typename Ptr>
         inline void update(const Ptr<Texture3D<DataType, Tx>, DelType>& texture) noexcept
         {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
             glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, 0, _width, _height, _depth, static_cast<GLenum>(Tx), _type<DataType>(), &texture->_data[0]);
         }
 
@@ -148,9 +164,83 @@ namespace WOGL
         template<typename DataType, TexelType Tx, template<typename> typename Ptr>
         inline void update(const Ptr<Texture3D<DataType, Tx>>& texture) noexcept
         {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
             glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, 0, _width, _height, _depth, static_cast<GLenum>(Tx), _type<DataType>(), &texture->_data[0]);
         }
 
+        /**
+         * Метод предназначенный для асинхронного обновления данных объекта.
+         * Данные копируются в staging, а загрузка выполняется из него, поэтому поток отрисовки не ждёт копирования драйвером.
+         *
+         * @param texture трёхмерная текстура
+         * @param staging буфер для загрузки
+         * @throw invalid_argument в случае если размер текстуры больше размера staging
+        */
+        template<typename DataType, TexelType Tx>
+        void update(const Texture3D<DataType, Tx>& texture, StagingBuffer& staging)
+        {
+            glBindTexture(GL_TEXTURE_3D, _textureRendererHandle);
+
+            staging.upload(&texture._data[0], texture._data.size() * sizeof(DataType), [this] (const void* offset) {
+                glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, 0, _width, _height, _depth, static_cast<GLenum>(Tx), _type<DataType>(), offset);
+            });
+
+            glBindTexture(GL_TEXTURE_3D, 0);
+        }
+
+        /**
+         * Метод загружающий в GPU все уровни mipmap-цепочки за один проход.
+         * Уровни, которых нет в chain или в выделенной памяти, не загружаются.
+         *
+         * @param chain mipmap-цепочка
+         * @throw invalid_argument в случае если размер нулевого уровня не совпадает с размером текстуры
+        */
+        template<typename DataType, TexelType Tx>
+        void update(const MipChain3D<DataType, Tx>& chain)
+        {
+            _checkMipChain(chain);
+
+            glBindTexture(GL_TEXTURE_3D, _textureRendererHandle);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+            const int32_t levels = min(static_cast<int32_t>(chain.numberOfLevels()), _levels);
+
+            for (int32_t i{0}; i < levels; i++) {
+                glTexSubImage3D(GL_TEXTURE_3D, i, 0, 0, 0, chain.width(i), chain.height(i), chain.depth(i), static_cast<GLenum>(Tx), _type<DataType>(), chain.data(i));
+            }
+
+            glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+            glBindTexture(GL_TEXTURE_3D, 0);
+        }
+
+        /**
+         * Метод асинхронно загружающий в GPU все уровни mipmap-цепочки за один проход через staging.
+         *
+         * @param chain mipmap-цепочка
+         * @param staging буфер для загрузки
+         * @throw invalid_argument в случае если размер нулевого уровня не совпадает с размером текстуры
+         * или если размер цепочки больше размера staging
+        */
+        template<typename DataType, TexelType Tx>
+        void update(const MipChain3D<DataType, Tx>& chain, StagingBuffer& staging)
+        {
+            _checkMipChain(chain);
+
+            glBindTexture(GL_TEXTURE_3D, _textureRendererHandle);
+
+            const int32_t levels = min(static_cast<int32_t>(chain.numberOfLevels()), _levels);
+
+            staging.upload(chain.data(), chain.sizeInBytes(), [this, &chain, levels] (const void* offset) {
+                for (int32_t i{0}; i < levels; i++) {
+                    const auto levelOffset = static_cast<const uint8_t*>(offset) + (chain.data(i) - chain.data()) * sizeof(DataType);
+                    glTexSubImage3D(GL_TEXTURE_3D, i, 0, 0, 0, chain.width(i), chain.height(i), chain.depth(i), static_cast<GLenum>(Tx), _type<DataType>(), levelOffset);
+                }
+            });
+
+            glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+            glBindTexture(GL_TEXTURE_3D, 0);
+        }
+
         /**
          * Метод необходимый для определения способа увеличения текстуры.
          *
@@ -241,10 +331,39 @@ namespace WOGL
             return _depth;
         }
 
+        /**
+         * Метод возвращающий количество выделенных уровней mipmap'а.
+         *
+         * @return количество уровней
+        */
+        int32_t levels() const noexcept
+        {
+            return _levels;
+        }
+
     protected:
+        /**
+         * Метод выделяющий память под все уровни. Пока уровни не загружены,
+         * GL_TEXTURE_MAX_LEVEL равен 0, поэтому текстура остаётся полной при любом фильтре.
+        */
+        void _allocate(TexelFormat tf) const noexcept
+        {
+            glTexStorage3D(GL_TEXTURE_3D, _levels, static_cast<GLenum>(tf), _width, _height, _depth);
+            glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAX_LEVEL, 0);
+        }
+
+        template<typename Chain>
+        void _checkMipChain(const Chain& chain) const
+        {
+            if (static_cast<int32_t>(chain.width(0)) != _width || static_cast<int32_t>(chain.height(0)) != _height || static_cast<int32_t>(chain.depth(0)) != _depth) {
+                throw invalid_argument("Mip chain size does not match texture size");
+            }
+        }
+
         int32_t _width;
         int32_t _height;
         int32_t _depth;
+        int32_t _levels;
     };
 
     template<TexelFormat Tf>
@@ -269,9 +388,10 @@ namespace WOGL
          * @param width ширина 
          * @param height высота
          * @param depth глубина
+         * @param levels количество уровней mipmap'а (если 0, то выделяется полная цепочка)
         */
-        explicit TextureRenderer3D(int32_t width, int32_t height, int32_t depth) :
-            BaseTextureRenderer3D{width, height, depth, Tf}
+        explicit TextureRenderer3D(int32_t width, int32_t height, int32_t depth, int32_t levels = 0) :
+            BaseTextureRenderer3D{width, height, depth, Tf, levels}
         {
         }
 
@@ -289,6 +409,7 @@ namespace WOGL
         */
          virtual inline void genMipmap() const noexcept override
          {
+            glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAX_LEVEL, _levels - 1);
             glGenerateMipmap(GL_TEXTURE_3D);
          }
 
@@ -0,0 +1,14 @@
+//
+//  WtexFile.hpp
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#ifndef WtexFile_hpp
+#define WtexFile_hpp
+
+#include "WtexFile.inl"
+
+#endif /* WtexFile_hpp */
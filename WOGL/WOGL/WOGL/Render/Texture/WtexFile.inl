@@ -0,0 +1,531 @@
+//
+//  WtexFile.inl
+//  WOGL
+//
+//  Created by Асиф Мамедов on 19/10/2026.
+//  Copyright © 2019 Asif Mamedov. All rights reserved.
+//
+
+#include <GL/glew.h>
+
+#include "../../Data/Texture2D.hpp"
+#include "../../Data/MipChain.hpp"
+#include "../../Data/BlockCompression.hpp"
+
+#include "TextureRenderer.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#include <array>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <fstream>
+
+#include <stdexcept>
+
+#if defined(_WIN32)
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#   include <fcntl.h>
+#   include <unistd.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#endif
+
+using namespace std;
+
+namespace WOGL
+{
+    /**
+     * Файл .wtex - контейнер с готовой к загрузке в GPU mipmap-цепочкой в конечном формате текселя
+     * (в том числе в сжатом). Файл отображается в память, а уровни загружаются в GPU прямо из отображённых страниц,
+     * без декодирования и преобразования.
+     *
+     * Структура файла (little-endian):
+     *  - заголовок: "WTEX", версия, формат текселя, формат и тип пикселя (0 для сжатых форматов), ширина, высота, количество уровней;
+     *  - таблица уровней: смещение от начала файла и размер каждого уровня (по 8 байт);
+     *  - данные уровней, каждый уровень выровнен на 16 байт.
+     *
+     * Файлы создаются методами write (например утилитой Tools/WtexConverter).
+    */
+    class WtexFile
+    {
+        friend class BaseTextureRenderer2D;
+
+        struct Header
+        {
+            array<char, 4> magic;
+            uint32_t version;
+            uint32_t format;
+            uint32_t pixelFormat;
+            uint32_t type;
+            uint32_t width;
+            uint32_t height;
+            uint32_t numberOfLevels;
+        };
+
+        struct LevelDescription
+        {
+            uint64_t offset;
+            uint64_t size;
+        };
+
+        static_assert(sizeof(Header) == 32 && sizeof(LevelDescription) == 16, "Unexpected wtex header layout");
+
+    public:
+        static constexpr uint32_t VERSION = 1;
+        static constexpr size_t MAX_LEVELS = 32;
+        static constexpr size_t LEVEL_ALIGNMENT = 16;
+
+        /**
+         * Конструктор отображающий файл в память и проверяющий его структуру.
+         *
+         * @param path путь до файла
+         * @throw invalid_argument в случае если файл не удалось открыть или он не является корректным .wtex файлом
+         * (в том числе если размер уровня или формат и тип пикселя не соответствуют формату текселя)
+        */
+        explicit WtexFile(const string_view path)
+        {
+            _map(string(path));
+
+            try {
+                _parse();
+            } catch (...) {
+                _unmap();
+                throw;
+            }
+        }
+
+        WtexFile(WtexFile&& file) noexcept :
+            _width{file._width},
+            _height{file._height},
+            _header{file._header},
+            _levels{move(file._levels)},
+            _data{file._data},
+            _size{file._size},
+            _fallback{move(file._fallback)}
+#if defined(_WIN32)
+            , _file{file._file},
+            _mapping{file._mapping}
+#endif
+        {
+            file._data = nullptr;
+            file._size = 0;
+
+#if defined(_WIN32)
+            file._file = INVALID_HANDLE_VALUE;
+            file._mapping = nullptr;
+#endif
+        }
+
+        WtexFile(const WtexFile&) = delete;
+        WtexFile& operator=(const WtexFile&) = delete;
+        WtexFile& operator=(WtexFile&&) = delete;
+
+        virtual ~WtexFile()
+        {
+            _unmap();
+        }
+
+        /**
+         * @return формат текселя, в котором хранятся уровни
+        */
+        TexelFormat format() const noexcept
+        {
+            return static_cast<TexelFormat>(_header.format);
+        }
+
+        /**
+         * @return true - если уровни хранятся в сжатом формате
+        */
+        bool compressed() const noexcept
+        {
+            return isCompressedFormat(format());
+        }
+
+        size_t numberOfLevels() const noexcept
+        {
+            return _levels.size();
+        }
+
+        size_t width(size_t level = 0) const noexcept
+        {
+            return max<size_t>(_width >> level, 1);
+        }
+
+        size_t height(size_t level = 0) const noexcept
+        {
+            return max<size_t>(_height >> level, 1);
+        }
+
+        /**
+         * @return размер уровня в байтах
+        */
+        size_t size(size_t level) const
+        {
+            return static_cast<size_t>(_levels.at(level).size);
+        }
+
+        /**
+         * @return указатель на данные уровня (в отображённой памяти)
+        */
+        const void* data(size_t level) const
+        {
+            return _data + _levels.at(level).offset;
+        }
+
+        /**
+         * @return размер файла в байтах
+        */
+        size_t sizeInBytes() const noexcept
+        {
+            return _size;
+        }
+
+        /**
+         * @return true - если файл отображён в память, false - если он был прочитан в буфер (на платформах без отображения файлов)
+        */
+        bool mapped() const noexcept
+        {
+            return _fallback.empty();
+        }
+
+        /**
+         * Метод записывающий mipmap-цепочку в .wtex файл.
+         *
+         * @template Tf формат текселя, в котором уровни будут загружаться в GPU
+         * @param path путь до файла
+         * @param chain mipmap-цепочка
+         * @throw runtime_error в случае если не удалось записать файл
+        */
+        template<TexelFormat Tf, typename DataType, TexelType Tx>
+        static void write(const string_view path, const MipChain2D<DataType, Tx>& chain)
+        {
+            static_assert(!isCompressedFormat(Tf), "Use CompressedTexture2D for compressed texel formats");
+            static_assert(numberOfChannels(Tf) == numberOfChannels(Tx), "Texel type does not match texel format");
+
+            vector<pair<const void*, size_t>> levels;
+
+            for (size_t i{0}; i < chain.numberOfLevels(); i++) {
+                levels.emplace_back(chain.data(i), chain.width(i) * chain.height(i) * numberOfChannels(Tx) * sizeof(DataType));
+            }
+
+            _write(path, Tf, pixelFormat(Tf), BaseTextureRenderer::_type<DataType>(), chain.width(0), chain.height(0), levels);
+        }
+
+        /**
+         * Метод записывающий текстуру в .wtex файл (один уровень).
+         *
+         * @template Tf формат текселя, в котором текстура будет загружаться в GPU
+         * @param path путь до файла
+         * @param texture текстура
+         * @throw runtime_error в случае если не удалось записать файл
+        */
+        template<TexelFormat Tf, typename DataType, TexelType Tx>
+        static void write(const string_view path, const Texture2D<DataType, Tx>& texture)
+        {
+            static_assert(!isCompressedFormat(Tf), "Use CompressedTexture2D for compressed texel formats");
+            static_assert(numberOfChannels(Tf) == numberOfChannels(Tx), "Texel type does not match texel format");
+
+            const vector<pair<const void*, size_t>> levels {
+                {&texture._data[0], texture._data.size() * sizeof(DataType)}
+            };
+
+            _write(path, Tf, pixelFormat(Tf), BaseTextureRenderer::_type<DataType>(), texture._width, texture._height, levels);
+        }
+
+        /**
+         * Метод записывающий сжатую текстуру в .wtex файл.
+         *
+         * @template Tf формат текселя (должен совпадать с форматом сжатия с точностью до sRGB)
+         * @param path путь до файла
+         * @param texture сжатая текстура
+         * @throw invalid_argument в случае если формат сжатия не совпадает с Tf
+         * @throw runtime_error в случае если не удалось записать файл
+        */
+        template<TexelFormat Tf>
+        static void write(const string_view path, const CompressedTexture2D& texture)
+        {
+            static_assert(isCompressedFormat(Tf), "Texel format is not compressed");
+
+            if (static_cast<GLenum>(linearFormat(Tf)) != static_cast<GLenum>(texture.format())) {
+                throw invalid_argument("Block format does not match texel format");
+            }
+
+            vector<pair<const void*, size_t>> levels;
+
+            for (size_t i{0}; i < texture.numberOfLevels(); i++) {
+                levels.emplace_back(texture.data(i), texture.size(i));
+            }
+
+            _write(path, Tf, 0, 0, texture.width(), texture.height(), levels);
+        }
+
+    private:
+        static size_t _align(size_t offset) noexcept
+        {
+            return (offset + LEVEL_ALIGNMENT - 1) & ~(LEVEL_ALIGNMENT - 1);
+        }
+
+        static void _write(const string_view path, TexelFormat tf, GLenum format, GLenum type, size_t width, size_t height, const vector<pair<const void*, size_t>>& levels)
+        {
+            if (levels.empty() || levels.size() > MAX_LEVELS) {
+                throw invalid_argument("Invalid number of mip levels");
+            }
+
+            Header header {{'W', 'T', 'E', 'X'}, VERSION, static_cast<uint32_t>(tf), format, type,
+                           static_cast<uint32_t>(width), static_cast<uint32_t>(height), static_cast<uint32_t>(levels.size())};
+
+            vector<LevelDescription> descriptions (levels.size());
+            size_t offset = sizeof(Header) + sizeof(LevelDescription) * levels.size();
+
+            for (size_t i{0}; i < levels.size(); i++) {
+                offset = _align(offset);
+                descriptions[i] = LevelDescription{offset, levels[i].second};
+                offset += levels[i].second;
+            }
+
+            ofstream file (string(path), ios::binary | ios::trunc);
+
+            if (!file) {
+                throw runtime_error("Failed to open wtex file for writing");
+            }
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(descriptions.data()), sizeof(LevelDescription) * descriptions.size());
+
+            const array<char, LEVEL_ALIGNMENT> padding {};
+
+            for (size_t i{0}; i < levels.size(); i++) {
+                file.write(padding.data(), static_cast<streamsize>(descriptions[i].offset - static_cast<uint64_t>(file.tellp())));
+                file.write(static_cast<const char*>(levels[i].first), static_cast<streamsize>(levels[i].second));
+            }
+
+            if (!file) {
+                throw runtime_error("Failed to write wtex file");
+            }
+        }
+
+        void _map(const string& path)
+        {
+#if defined(_WIN32)
+            _file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+            if (_file == INVALID_HANDLE_VALUE) {
+                throw invalid_argument("Failed to open wtex file");
+            }
+
+            LARGE_INTEGER size;
+            GetFileSizeEx(_file, &size);
+            _size = static_cast<size_t>(size.QuadPart);
+
+            _mapping = _size ? CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+            _data = _mapping ? static_cast<const uint8_t*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+
+            if (!_data) {
+                _unmap();
+                throw invalid_argument("Failed to map wtex file");
+            }
+#elif defined(__unix__) || defined(__APPLE__)
+            const int file = open(path.c_str(), O_RDONLY);
+
+            if (file < 0) {
+                throw invalid_argument("Failed to open wtex file");
+            }
+
+            struct stat status;
+
+            if (fstat(file, &status) != 0 || status.st_size <= 0) {
+                close(file);
+                throw invalid_argument("Failed to open wtex file");
+            }
+
+            _size = static_cast<size_t>(status.st_size);
+            void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+            close(file);
+
+            if (data == MAP_FAILED) {
+                throw invalid_argument("Failed to map wtex file");
+            }
+
+            // Уровни читаются последовательно, поэтому ядро может заранее подгрузить страницы.
+            madvise(data, _size, MADV_WILLNEED);
+            _data = static_cast<const uint8_t*>(data);
+#else
+            ifstream file (path, ios::binary | ios::ate);
+
+            if (!file) {
+                throw invalid_argument("Failed to open wtex file");
+            }
+
+            _size = static_cast<size_t>(file.tellg());
+            _fallback.resize(_size);
+            file.seekg(0);
+            file.read(reinterpret_cast<char*>(_fallback.data()), static_cast<streamsize>(_size));
+            _data = _fallback.data();
+#endif
+        }
+
+        void _unmap() noexcept
+        {
+#if defined(_WIN32)
+            if (_data) {
+                UnmapViewOfFile(_data);
+            }
+
+            if (_mapping) {
+                CloseHandle(_mapping);
+            }
+
+            if (_file != INVALID_HANDLE_VALUE) {
+                CloseHandle(_file);
+            }
+
+            _mapping = nullptr;
+            _file = INVALID_HANDLE_VALUE;
+#elif defined(__unix__) || defined(__APPLE__)
+            if (_data) {
+                munmap(const_cast<uint8_t*>(_data), _size);
+            }
+#endif
+
+            _data = nullptr;
+            _size = 0;
+        }
+
+        void _parse()
+        {
+            if (_size < sizeof(Header)) {
+                throw invalid_argument("Invalid wtex file");
+            }
+
+            memcpy(&_header, _data, sizeof(Header));
+
+            if (memcmp(_header.magic.data(), "WTEX", 4) != 0 || _header.version != VERSION) {
+                throw invalid_argument("Invalid wtex file");
+            }
+
+            if (!_header.width || !_header.height || !_header.numberOfLevels || _header.numberOfLevels > MAX_LEVELS ||
+                _header.numberOfLevels > numberOfMipLevels(_header.width, _header.height)) {
+                throw invalid_argument("Invalid wtex file size");
+            }
+
+            const auto tf = static_cast<TexelFormat>(_header.format);
+
+            if (!_knownFormat(tf)) {
+                throw invalid_argument("Invalid wtex file format");
+            }
+
+            // Несжатые уровни передаются в glTexSubImage2D с форматом и типом из заголовка, поэтому они должны
+            // соответствовать формату текселя (целочисленные форматы передаются только целыми типами).
+            if (isCompressedFormat(tf)) {
+                if (_header.pixelFormat != 0 || _header.type != 0) {
+                    throw invalid_argument("Invalid wtex file format");
+                }
+            } else if (_header.pixelFormat != pixelFormat(tf) || !_typeSize(_header.type) ||
+                       (isIntegerFormat(tf) && (_header.type == GL_FLOAT || _header.type == GL_HALF_FLOAT))) {
+                throw invalid_argument("Invalid wtex file format");
+            }
+
+            if (_size < sizeof(Header) + sizeof(LevelDescription) * _header.numberOfLevels) {
+                throw invalid_argument("Invalid wtex file");
+            }
+
+            _width = _header.width;
+            _height = _header.height;
+            _levels.resize(_header.numberOfLevels);
+            memcpy(_levels.data(), _data + sizeof(Header), sizeof(LevelDescription) * _levels.size());
+
+            for (size_t i{0}; i < _levels.size(); i++) {
+                const auto& level = _levels[i];
+
+                if (level.offset > _size || level.size > _size - level.offset) {
+                    throw invalid_argument("Wtex file is truncated");
+                }
+
+                if (level.size != _levelSize(tf, i)) {
+                    throw invalid_argument("Invalid wtex level size");
+                }
+            }
+        }
+
+        /**
+         * Метод возвращающий размер уровня, который прочитает драйвер (GL_UNPACK_ALIGNMENT равен 1).
+        */
+        uint64_t _levelSize(TexelFormat tf, size_t level) const noexcept
+        {
+            const uint64_t w = width(level);
+            const uint64_t h = height(level);
+
+            if (isCompressedFormat(tf)) {
+                return ((w + 3) / 4) * ((h + 3) / 4) * compressedBlockSize(tf);
+            }
+
+            return w * h * numberOfChannels(tf) * _typeSize(_header.type);
+        }
+
+        /**
+         * @return размер канала типа OpenGL в байтах (0 - если тип не поддерживается)
+        */
+        static size_t _typeSize(GLenum type) noexcept
+        {
+            switch (type) {
+                case GL_BYTE: case GL_UNSIGNED_BYTE:
+                    return 1;
+
+                case GL_SHORT: case GL_UNSIGNED_SHORT: case GL_HALF_FLOAT:
+                    return 2;
+
+                case GL_INT: case GL_UNSIGNED_INT: case GL_FLOAT:
+                    return 4;
+
+                default:
+                    return 0;
+            }
+        }
+
+        static bool _knownFormat(TexelFormat tf) noexcept
+        {
+            switch (tf) {
+                case TexelFormat::RGBA32_F: case TexelFormat::RGBA16_F:
+                case TexelFormat::RGBA32_U: case TexelFormat::RGBA16_U: case TexelFormat::RGBA8_U:
+                case TexelFormat::RGBA32_S: case TexelFormat::RGBA16_S: case TexelFormat::RGBA8_S:
+                case TexelFormat::RGB32_F: case TexelFormat::RGB16_F:
+                case TexelFormat::RGB32_U: case TexelFormat::RGB16_U: case TexelFormat::RGB8_U:
+                case TexelFormat::RGB32_S: case TexelFormat::RGB16_S: case TexelFormat::RGB8_S:
+                case TexelFormat::RG32_F: case TexelFormat::RG16_F:
+                case TexelFormat::RG32_U: case TexelFormat::RG16_U: case TexelFormat::RG8_U:
+                case TexelFormat::RG32_S: case TexelFormat::RG16_S: case TexelFormat::RG8_S:
+                case TexelFormat::RED32_F: case TexelFormat::RED16_F:
+                case TexelFormat::RED32_U: case TexelFormat::RED16_U: case TexelFormat::RED8_U:
+                case TexelFormat::RED32_S: case TexelFormat::RED16_S: case TexelFormat::RED8_S:
+                case TexelFormat::RGBA8_UNORM: case TexelFormat::RGB8_UNORM: case TexelFormat::RG8_UNORM: case TexelFormat::RED8_UNORM:
+                case TexelFormat::SRGB8_ALPHA8: case TexelFormat::SRGB8:
+                case TexelFormat::BC1_RGB: case TexelFormat::BC3_RGBA: case TexelFormat::BC4_RED: case TexelFormat::BC5_RG:
+                case TexelFormat::BC7_RGBA: case TexelFormat::BC1_SRGB: case TexelFormat::BC3_SRGB_ALPHA: case TexelFormat::BC7_SRGB_ALPHA:
+                    return true;
+
+                default:
+                    return false;
+            }
+        }
+
+        size_t _width = 0;
+        size_t _height = 0;
+        Header _header;
+        vector<LevelDescription> _levels;
+        const uint8_t* _data = nullptr;
+        size_t _size = 0;
+        vector<uint8_t> _fallback;
+
+#if defined(_WIN32)
+        HANDLE _file = INVALID_HANDLE_VALUE;
+        HANDLE _mapping = nullptr;
+#endif
+    };
+}